@@ -211,6 +211,7 @@ static void depmod_a()
     QProcess process;
     process.start("depmod -a");
     process.waitForFinished(-1);
+    ModCore::invalidateContext();
 }
 
 bool DriverManager::installDriver(const QString &filepath)
@@ -282,6 +283,7 @@ bool DriverManager::installDriver(const QString &filepath)
                 sigProgressDetail(40, "");
                 //更新依赖
                 Utils::updateModDeps();
+                ModCore::invalidateContext();
                 sigProgressDetail(50, "");
                 QString modname = mp_modcore->modGetName(installpath);
                 //处理黑名单
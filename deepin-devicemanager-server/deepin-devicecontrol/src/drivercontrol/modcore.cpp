@@ -13,9 +13,14 @@
 #include <QTextStream>
 #include <QProcess>
 #include <QLoggingCategory>
+#include <QMutex>
 
 using namespace DDLog;
 
+// 进程内共享的 kmod 上下文，模块索引只加载一次
+static struct kmod_ctx *s_KmodCtx = nullptr;
+static QMutex s_KmodMutex;
+
 const QString  BLACKLISTT_PROBE_DIR_ETC = "/etc/modprobe.d";   //黑名单配置路径
 const QString  BLACKLISTT_PROBE_DIR_USR_LIB = "/usr/lib/modprobe.d";  //黑名单配置路径
 const QString  LOADONBOOT_PROBE_DIR = "/etc/modules-load.d";  //开机加载配置路径
@@ -37,9 +42,9 @@ QStringList ModCore::checkModuleInUsed(const QString &modName)
 {
     QStringList modList;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
 
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (!ctx) {
         qCInfo(appLog) << "kmod_new() failed!";
     } else {
@@ -74,7 +79,6 @@ QStringList ModCore::checkModuleInUsed(const QString &modName)
             }
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
 
     return  modList;
@@ -90,9 +94,9 @@ bool ModCore::rmModForce(const QString &modName, QString &errMsg)
     qCDebug(appLog) << "Force removing module:" << modName;
     bool bsuccess = true;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
 
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (!ctx) {
         bsuccess = false;
         qCInfo(appLog) << __func__ << "kmod_new() failed!";
@@ -114,7 +118,6 @@ bool ModCore::rmModForce(const QString &modName, QString &errMsg)
             }
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  bsuccess;
 }
@@ -130,9 +133,9 @@ bool ModCore::modInstall(const QString &modName, QString &errMsg, unsigned int f
     qCDebug(appLog) << "Installing module:" << modName << "with flags:" << flags;
     bool success = true;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
 
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (!ctx) {
         success = false;
         qCInfo(appLog) << __func__ << "kmod_new() failed!";
@@ -158,8 +161,6 @@ bool ModCore::modInstall(const QString &modName, QString &errMsg, unsigned int f
             qCInfo(appLog) << __func__ << QString("Mod %1 not found in directory %2").arg(modName).arg(kmod_get_dirname(ctx));
             success = false;
         }
-
-        kmod_unref(ctx);
     }
     return  success;
 }
@@ -173,9 +174,9 @@ QString ModCore::modGetPath(const QString &modName)
 {
     QString path;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
 
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (!ctx) {
         qCInfo(appLog) << __func__ << "kmod_new() failed!";
     } else {
@@ -189,7 +190,6 @@ QString ModCore::modGetPath(const QString &modName)
             path.append(kmod_module_get_path(mod));
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  path;
 }
@@ -203,9 +203,9 @@ QString ModCore::modGetName(const QString &modPath)
 {
     QString modname;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
 
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (!ctx) {
         qCInfo(appLog) << __func__ << "kmod_new() failed!";
     } else {
@@ -219,7 +219,6 @@ QString ModCore::modGetName(const QString &modPath)
             modname.append(kmod_module_get_name(mod));
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  modname;
 }
@@ -234,9 +233,9 @@ QString ModCore::modGetInfo(const QString &modName, ModCore::ModInfoType infotyp
 {
     QString modinfo;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
 
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (!ctx) {
         qCInfo(appLog) << __func__ << "kmod_new() failed!";
         return QString();
@@ -254,6 +253,7 @@ QString ModCore::modGetInfo(const QString &modName, ModCore::ModInfoType infotyp
             if (err < 0) {
                 qCInfo(appLog) << __func__ << QString("could not get mod info from %1, errno=%2")
                         .arg(kmod_module_get_name(mod)).arg(err);
+                kmod_module_unref(mod);
                 return QString();
             }
             kmod_list *ltmp = nullptr;
@@ -271,7 +271,6 @@ QString ModCore::modGetInfo(const QString &modName, ModCore::ModInfoType infotyp
             kmod_module_info_free_list(modlist);
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     return  modinfo;
 }
@@ -328,6 +327,39 @@ int ModCore::modNew(struct kmod_ctx *ctx, const QString &modName, kmod_module *&
     return  ret;
 }
 
+/**
+ * @brief ModCore::kmodContext 获取共享的 kmod 上下文，调用时需持有 s_KmodMutex
+ * depmod 更新了索引或 modprobe 配置发生变化时重新创建
+ * @return kmod 上下文，创建失败时为 nullptr
+ */
+struct kmod_ctx *ModCore::kmodContext()
+{
+    if (s_KmodCtx && KMOD_RESOURCES_OK != kmod_validate_resources(s_KmodCtx)) {
+        qCDebug(appLog) << "Module indexes changed, recreating kmod context";
+        kmod_unref(s_KmodCtx);
+        s_KmodCtx = nullptr;
+    }
+
+    if (!s_KmodCtx) {
+        s_KmodCtx = kmod_new(nullptr, nullptr);
+        if (s_KmodCtx)
+            kmod_load_resources(s_KmodCtx);
+    }
+    return s_KmodCtx;
+}
+
+/**
+ * @brief ModCore::invalidateContext 丢弃共享的 kmod 上下文，执行 depmod 后调用
+ */
+void ModCore::invalidateContext()
+{
+    QMutexLocker locker(&s_KmodMutex);
+    if (s_KmodCtx) {
+        kmod_unref(s_KmodCtx);
+        s_KmodCtx = nullptr;
+    }
+}
+
 /**
  * @brief ModCore::bFromPath modName是为文件路径
  * @param modName 模块名
@@ -388,9 +420,9 @@ int ModCore::modGetInitState(const QString &modName)
 {
     int state = -1;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
 
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (ctx) {
         struct kmod_module *mod = nullptr;
         int err = modNew(ctx, modName, mod);
@@ -399,7 +431,6 @@ int ModCore::modGetInitState(const QString &modName)
             state = kmod_module_get_initstate(mod);
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
 
     return  state;
@@ -526,8 +557,8 @@ QStringList ModCore::modGetConfsWithType(ModConfType conftype)
 {
     QStringList conflist;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
 
     if (nullptr != ctx) {
         QString confkey;
@@ -555,7 +586,6 @@ QStringList ModCore::modGetConfsWithType(ModConfType conftype)
             }
             kmod_config_iter_free_iter(iter);
         }
-        kmod_unref(ctx);
     }
     return conflist;
 }
@@ -571,8 +601,8 @@ bool ModCore::isModFile(const QString &filePath)
         return  false;
     bool bmodfile = false;
     struct kmod_ctx *ctx = nullptr;
-    const char **null_config = nullptr;
-    ctx = kmod_new(nullptr, null_config);
+    QMutexLocker locker(&s_KmodMutex);
+    ctx = kmodContext();
     if (ctx) {
         struct kmod_module *mod = nullptr;
         int err = modNew(ctx, filePath, mod);
@@ -585,7 +615,6 @@ bool ModCore::isModFile(const QString &filePath)
             }
             kmod_module_unref(mod);
         }
-        kmod_unref(ctx);
     }
     qCInfo(appLog) << "" << bmodfile;
     return bmodfile;
@@ -69,9 +69,13 @@ public:
     bool setModLoadedOnBoot(const QString &modName);
     //移除mod loaded on boot
     void rmModLoadedOnBoot(const QString &modName);
+    //丢弃共享的kmod上下文，depmod更新模块索引后调用
+    static void invalidateContext();
 
 
 private:
+    //获取共享的kmod上下文，模块索引或配置变化时重新创建
+    static struct kmod_ctx *kmodContext();
     //new一个新kmod_module
     int modNew(struct kmod_ctx *ctx, const QString &modName, kmod_module *&mod);
     //判断mod是文件路径还是模块名
@@ -8,6 +8,7 @@
 #include <QtSql>
 #include <QLoggingCategory>
 #include <QDir>
+#include <QFileInfo>
 #include <QSqlError>
 #define DB_PATH "/var/lib/deepin-devicemanager/"
 #define DB_FILE "enable.db"
@@ -25,27 +26,35 @@ std::atomic<EnableSqlManager *> EnableSqlManager::s_Instance;
 std::mutex EnableSqlManager::m_mutex;
 void EnableSqlManager::insertDataToRemoveTable(const QString &hclass, const QString &name, const QString &path, const QString &unique_id, const QString &strDriver)
 {
-    // QString sql = QString("INSERT INTO %1 (class, name, path, unique_id, driver) VALUES (%2, %3, %4, %5, %6);")
-    //               .arg(DB_TABLE_REMOVE).arg(":hclass").arg(":name").arg(":path").arg(":unique_id").arg(":strDriver");
-    if(!m_sqlQuery.prepare("INSERT INTO remove (class, name, path, unique_id, driver) VALUES (:hclass, :name, :path, :unique_id, :strDriver);")) return;
-    m_sqlQuery.bindValue(":hclass", QVariant(hclass));
-    m_sqlQuery.bindValue(":name", QVariant(name));
-    m_sqlQuery.bindValue(":path", QVariant(path));
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    m_sqlQuery.bindValue(":strDriver", QVariant(strDriver));
-
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+    QSqlQuery *query = statement("INSERT INTO remove (class, name, path, unique_id, driver) VALUES (:hclass, :name, :path, :unique_id, :strDriver);");
+    if (!query) return;
+    query->bindValue(":hclass", QVariant(hclass));
+    query->bindValue(":name", QVariant(name));
+    query->bindValue(":path", QVariant(path));
+    query->bindValue(":unique_id", QVariant(unique_id));
+    query->bindValue(":strDriver", QVariant(strDriver));
+
+    if (!query->exec()) {
+        qCInfo(appLog) << Q_FUNC_INFO << query->lastError();
+        return;
     }
+    m_RemoveRows.append(qMakePair(path, unique_id));
 }
 
 void EnableSqlManager::removeDateFromRemoveTable(const QString &path)
 {
     QString sql = QString("DELETE FROM %1 WHERE path=%2;").arg(DB_TABLE_REMOVE).arg(":path");
-    if(!m_sqlQuery.prepare(sql)) return;
-    m_sqlQuery.bindValue(":path", QVariant(path));
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sql);
+    if (!query) return;
+    query->bindValue(":path", QVariant(path));
+    if (!query->exec()) {
+        qCInfo(appLog) << query->lastError();
+        return;
+    }
+
+    for (int i = m_RemoveRows.size() - 1; i >= 0; --i) {
+        if (m_RemoveRows[i].first == path)
+            m_RemoveRows.removeAt(i);
     }
 }
 
@@ -57,43 +66,66 @@ void EnableSqlManager::insertDataToAuthorizedTable(const QString &hclass, const
     }
 
     // 数据库没有该设备记录，则直接插入
-    // QString sql = QString("INSERT INTO %1 (class, name, path, unique_id, exist, driver) VALUES (%2, %3, %4, %5, %6, %7);")
-    //               .arg(DB_TABLE_AUTHORIZED).arg(":hclass").arg(":name").arg(":path").arg(":unique_id").arg(":exist").arg(":strDriver");
-    if(!m_sqlQuery.prepare("INSERT INTO authorized (class, name, path, unique_id, exist, driver) VALUES (:hclass, :name, :path, :unique_id, :exist, :strDriver);")){
+    QSqlQuery *query = statement("INSERT INTO authorized (class, name, path, unique_id, exist, driver) VALUES (:hclass, :name, :path, :unique_id, :exist, :strDriver);");
+    if (!query) {
         qDebug() << "insert data to authorized table failed";
         return;
     }
-    m_sqlQuery.bindValue(":hclass", QVariant(hclass));
-    m_sqlQuery.bindValue(":name", QVariant(name));
-    m_sqlQuery.bindValue(":path", QVariant(path));
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    m_sqlQuery.bindValue(":exist", QVariant(exist));
-    m_sqlQuery.bindValue(":strDriver", QVariant(strDriver));
+    query->bindValue(":hclass", QVariant(hclass));
+    query->bindValue(":name", QVariant(name));
+    query->bindValue(":path", QVariant(path));
+    query->bindValue(":unique_id", QVariant(unique_id));
+    query->bindValue(":exist", QVariant(exist));
+    query->bindValue(":strDriver", QVariant(strDriver));
 
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+    if (!query->exec()) {
+        qCInfo(appLog) << Q_FUNC_INFO << query->lastError();
+        return;
     }
+    m_AuthorizedRows.append(qMakePair(path, unique_id));
+    m_AuthorizedPaths.insert(unique_id, path);
 }
 
 void EnableSqlManager::removeDataFromAuthorizedTable(const QString &key)
 {
     QString sql = QString("DELETE FROM %1 WHERE unique_id=%2;").arg(DB_TABLE_AUTHORIZED).arg(":key");
-    if(!m_sqlQuery.prepare(sql)) return;
-    m_sqlQuery.bindValue(":key", QVariant(key));
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sql);
+    if (!query) return;
+    query->bindValue(":key", QVariant(key));
+    if (!query->exec()) {
+        qCInfo(appLog) << query->lastError();
+        return;
     }
+
+    for (int i = m_AuthorizedRows.size() - 1; i >= 0; --i) {
+        if (m_AuthorizedRows[i].second == key)
+            m_AuthorizedRows.removeAt(i);
+    }
+    m_AuthorizedPaths.remove(key);
 }
 
 void EnableSqlManager::updateDataToAuthorizedTable(const QString &unique_id, const QString &path)
 {
     QString sql = QString("UPDATE %1 SET path=%2 WHERE unique_id=%3;").arg(DB_TABLE_AUTHORIZED).arg(":path").arg(":unique_id");
-    if(!m_sqlQuery.prepare(sql)) return;
-    m_sqlQuery.bindValue(":path", QVariant(path));
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sql);
+    if (!query) return;
+    query->bindValue(":path", QVariant(path));
+    query->bindValue(":unique_id", QVariant(unique_id));
+    if (!query->exec()) {
+        qCInfo(appLog) << query->lastError();
+        return;
     }
+
+    int count = 0;
+    for (int i = 0; i < m_AuthorizedRows.size(); ++i) {
+        if (m_AuthorizedRows[i].second == unique_id) {
+            m_AuthorizedRows[i].first = path;
+            ++count;
+        }
+    }
+    m_AuthorizedPaths.remove(unique_id);
+    for (int i = 0; i < count; ++i)
+        m_AuthorizedPaths.insert(unique_id, path);
 }
 
 void EnableSqlManager::clearEnableFromAuthorizedTable()
@@ -101,48 +133,42 @@ void EnableSqlManager::clearEnableFromAuthorizedTable()
     QString sql = QString("DELETE FROM %1 WHERE enable='%2';").arg(DB_TABLE_AUTHORIZED).arg(true);
     if (!m_sqlQuery.exec(sql)) {
         qCInfo(appLog) << m_sqlQuery.lastError();
+        return;
     }
+    loadIndex();
 }
 
 void EnableSqlManager::insertDataToPrinterTable(const QString &hclass, const QString &name, const QString &path)
 {
     QString sql = QString("INSERT INTO %1 (class, name, path) VALUES (%2, %3, %4);").arg(DB_TABLE_PRINTER).arg(":hclass").arg(":name").arg(":path");
-    if(!m_sqlQuery.prepare(sql)) return;
-    m_sqlQuery.bindValue(":hclass", QVariant(hclass));
-    m_sqlQuery.bindValue(":name", QVariant(name));
-    m_sqlQuery.bindValue(":path", QVariant(path));
+    QSqlQuery *query = statement(sql);
+    if (!query) return;
+    query->bindValue(":hclass", QVariant(hclass));
+    query->bindValue(":name", QVariant(name));
+    query->bindValue(":path", QVariant(path));
 
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+    if (!query->exec()) {
+        qCInfo(appLog) << Q_FUNC_INFO << query->lastError();
     }
 }
 
 void EnableSqlManager::removeDataFromPrinterTable(const QString &name)
 {
     QString sql = QString("DELETE FROM %1 WHERE name=%2;").arg(DB_TABLE_PRINTER).arg(":name");
-    if(!m_sqlQuery.prepare(sql)) return;
-    m_sqlQuery.bindValue(":name", QVariant(name));
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sql);
+    if (!query) return;
+    query->bindValue(":name", QVariant(name));
+    if (!query->exec()) {
+        qCInfo(appLog) << query->lastError();
     }
 }
 
 bool EnableSqlManager::uniqueIDExisted(const QString &key, const QString path)
 {
     qCDebug(appLog) << "Checking if unique ID exists:" << key;
-    QString sql = QString("SELECT COUNT(*) FROM %1 WHERE unique_id=%2;").arg(DB_TABLE_AUTHORIZED).arg(":param");
-    if (!path.isEmpty()){
-        sql = QString("SELECT COUNT(*) FROM %1 WHERE unique_id=%2 and path=%3;").arg(DB_TABLE_AUTHORIZED).arg(":param").arg(":path");
-    }
-    if(!m_sqlQuery.prepare(sql)) return false;
-    m_sqlQuery.bindValue(":param", QVariant(key));
-    if (!path.isEmpty()){
-        m_sqlQuery.bindValue(":path", QVariant(path));
-    }
-    if (m_sqlQuery.exec() && m_sqlQuery.next()) {
-            return m_sqlQuery.value(0).toInt() > 0;
-    }
-    return false;
+    if (path.isEmpty())
+        return m_AuthorizedPaths.contains(key);
+    return m_AuthorizedPaths.contains(key, path);
 }
 
 bool EnableSqlManager::uniqueIDExistedEX(const QString &key, const QString path)
@@ -154,12 +180,15 @@ bool EnableSqlManager::isUniqueIdEnabled(const QString &key)
 {
     qCDebug(appLog) << "Checking if unique ID is enabled:" << key;
     QString sql = QString("SELECT enable FROM %1 WHERE unique_id=:key;").arg(DB_TABLE_AUTHORIZED);
-    if(!m_sqlQuery.prepare(sql)) return false;
-    m_sqlQuery.bindValue(":key", QVariant(key));
-    if (m_sqlQuery.exec() && m_sqlQuery.next()) {
-            return m_sqlQuery.value(0).toInt() > 0;
-    }
-    return false;
+    QSqlQuery *query = statement(sql);
+    if (!query) return false;
+    query->bindValue(":key", QVariant(key));
+    bool enabled = false;
+    if (query->exec() && query->next()) {
+        enabled = query->value(0).toInt() > 0;
+    }
+    query->finish();
+    return enabled;
 }
 
 QString EnableSqlManager::removedInfo()
@@ -202,11 +231,10 @@ QString EnableSqlManager::authorizedInfo()
 
 QString EnableSqlManager::authorizedPath(const QString &unique_id)
 {
-    QString sql = QString("SELECT path FROM %1 WHERE unique_id=%2;").arg(DB_TABLE_AUTHORIZED).arg(":unique_id");
-    if(!m_sqlQuery.prepare(sql)) return "";
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    if (m_sqlQuery.exec() && m_sqlQuery.next()) {
-        return m_sqlQuery.value(0).toString();
+    // 与 SELECT 相同，返回最早插入的记录
+    for (int i = 0; i < m_AuthorizedRows.size(); ++i) {
+        if (m_AuthorizedRows[i].second == unique_id)
+            return m_AuthorizedRows[i].first;
     }
     return "";
 }
@@ -214,177 +242,167 @@ QString EnableSqlManager::authorizedPath(const QString &unique_id)
 
 void EnableSqlManager::authorizedPathUniqueIDList(QList<QPair<QString, QString> > &lstPair)
 {
-    QString sql = QString("SELECT path,unique_id FROM %1;").arg(DB_TABLE_AUTHORIZED);
-    if (!m_sqlQuery.exec(sql)) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
-        return;
-    }
-    while (m_sqlQuery.next()) {
-        QPair<QString, QString> pair;
-        pair.first = m_sqlQuery.value(0).toString();
-        pair.second = m_sqlQuery.value(1).toString();
-        lstPair.append(pair);
-    }
+    lstPair.append(m_AuthorizedRows);
 }
 
 void EnableSqlManager::removePathList(QStringList &lsPath)
 {
-    QString sql = QString("SELECT path FROM %1;").arg(DB_TABLE_REMOVE);
-    if (!m_sqlQuery.exec(sql)) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
-        return;
-    }
-    while (m_sqlQuery.next()) {
-        lsPath.append(m_sqlQuery.value(0).toString());
-    }
+    for (int i = 0; i < m_RemoveRows.size(); ++i)
+        lsPath.append(m_RemoveRows[i].first);
 }
 
 void EnableSqlManager::removePathUniqueIDList(QList<QPair<QString, QString> > &lstPair)
 {
-    QString sql = QString("SELECT path,unique_id FROM %1;").arg(DB_TABLE_REMOVE);
-    if (!m_sqlQuery.exec(sql)) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
-        return;
-    }
-    while (m_sqlQuery.next()) {
-        QPair<QString, QString> pair;
-        pair.first = m_sqlQuery.value(0).toString();
-        pair.second = m_sqlQuery.value(1).toString();
-        lstPair.append(pair);
-    }
+    lstPair.append(m_RemoveRows);
 }
 
 void EnableSqlManager::insertWakeupData(const QString &unique_id, const QString &path, bool wakeup)
 {
     QString sql = QString("INSERT INTO %1 (unique_id, path, wakeup) VALUES (%2, %3, %4);").arg(DB_TABLE_WAKEUP).arg(":unique_id").arg(":path").arg(":wakeup");
-    if(!m_sqlQuery.prepare(sql)) return;
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    m_sqlQuery.bindValue(":path", QVariant(path));
-    m_sqlQuery.bindValue(":wakeup", QVariant(wakeup));
-
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sql);
+    if (!query) return;
+    query->bindValue(":unique_id", QVariant(unique_id));
+    query->bindValue(":path", QVariant(path));
+    query->bindValue(":wakeup", QVariant(wakeup));
+
+    if (!query->exec()) {
+        qCInfo(appLog) << Q_FUNC_INFO << query->lastError();
+        return;
+    }
+    if (!m_WakeupData.contains(unique_id)) {
+        WakeupData data;
+        data.path = path;
+        data.wakeup = wakeup;
+        m_WakeupData.insert(unique_id, data);
     }
 }
 
 bool EnableSqlManager::isWakeupUniqueIdExisted(const QString &unique_id)
 {
-    QString sql = QString("SELECT COUNT(*) FROM %1 WHERE unique_id=%2;").arg(DB_TABLE_WAKEUP).arg(":unique_id");
-    if(!m_sqlQuery.prepare(sql)) return false;
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    if (m_sqlQuery.exec() && m_sqlQuery.next()) {
-        return m_sqlQuery.value(0).toInt() > 0;
-    }
-    return false;
+    return m_WakeupData.contains(unique_id);
 }
 
 void EnableSqlManager::updateWakeData(const QString &unique_id, const QString &path, bool wakeup)
 {
     QString sql = QString("UPDATE %1 SET path=%2, wakeup=%3 WHERE unique_id=%4;").arg(DB_TABLE_WAKEUP).arg(":path").arg(":wakeup").arg(":unique_id");
-    if(!m_sqlQuery.prepare(sql)) return;
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    m_sqlQuery.bindValue(":path", QVariant(path));
-    m_sqlQuery.bindValue(":wakeup", QVariant(wakeup));
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sql);
+    if (!query) return;
+    query->bindValue(":unique_id", QVariant(unique_id));
+    query->bindValue(":path", QVariant(path));
+    query->bindValue(":wakeup", QVariant(wakeup));
+    if (!query->exec()) {
+        qCInfo(appLog) << query->lastError();
+        return;
+    }
+
+    auto it = m_WakeupData.find(unique_id);
+    if (it != m_WakeupData.end()) {
+        it->path = path;
+        it->wakeup = wakeup;
     }
 }
 
 QString EnableSqlManager::wakeupPath(const QString &unique_id)
 {
-    QString sql = QString("SELECT path FROM %1 WHERE unique_id=%2;").arg(DB_TABLE_WAKEUP).arg(":unique_id");
-    if(!m_sqlQuery.prepare(sql)) return "";
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    if (m_sqlQuery.exec() && m_sqlQuery.next()) {
-        return m_sqlQuery.value(0).toString();
-    }
-    return "";
+    return m_WakeupData.value(unique_id).path;
 }
 
 bool EnableSqlManager::isWakeup(const QString &unique_id)
 {
-    QString sql = QString("SELECT wakeup FROM %1 WHERE unique_id=%2;").arg(DB_TABLE_WAKEUP).arg(":unique_id");
-    if(!m_sqlQuery.prepare(sql)) return false;
-    m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
-    if (m_sqlQuery.exec() && m_sqlQuery.next())
-        return m_sqlQuery.value(0).toBool();
-    return false;
+    return m_WakeupData.value(unique_id).wakeup;
 }
 
 void EnableSqlManager::insertNetworkWakeup(const QString &logical_name, bool wake)
 {
     // 先判断是否已经存在
     QString sqlAdd;
-    QString sqlExist = QString("SELECT wakeup FROM %1 WHERE logical_name=%2;").arg(DB_TABLE_NETWORK_WAKEUP).arg(":logical_name");
-    if(!m_sqlQuery.prepare(sqlExist)) return;
-    m_sqlQuery.bindValue(":logical_name", QVariant(logical_name));
-    if (m_sqlQuery.exec() && m_sqlQuery.next()) {
+    if (m_NetworkWakeup.contains(logical_name)) {
         sqlAdd = QString("UPDATE %1 SET wakeup=%2 WHERE logical_name=%3;").arg(DB_TABLE_NETWORK_WAKEUP).arg(":wake").arg(":logical_name");
     } else {
         sqlAdd = QString("INSERT INTO %1 (logical_name, wakeup) VALUES (%2, %3);").arg(DB_TABLE_NETWORK_WAKEUP).arg(":logical_name").arg(":wake");
     }
 
-    if(!m_sqlQuery.prepare(sqlAdd)) return;
-    m_sqlQuery.bindValue(":wake", QVariant(wake));
-    m_sqlQuery.bindValue(":logical_name", QVariant(logical_name));
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sqlAdd);
+    if (!query) return;
+    query->bindValue(":wake", QVariant(wake));
+    query->bindValue(":logical_name", QVariant(logical_name));
+    if (!query->exec()) {
+        qCInfo(appLog) << Q_FUNC_INFO << query->lastError();
+        return;
     }
+    m_NetworkWakeup.insert(logical_name, wake);
 }
 
 bool EnableSqlManager::isNetworkWakeup(const QString &logical_name)
 {
-    QString sql = QString("SELECT wakeup FROM %1 WHERE logical_name=%2;").arg(DB_TABLE_NETWORK_WAKEUP).arg(":logical_name");
-    if(!m_sqlQuery.prepare(sql)) return false;
-    m_sqlQuery.bindValue(":logical_name", QVariant(logical_name));
-    if (m_sqlQuery.exec() && m_sqlQuery.next())
-        return m_sqlQuery.value(0).toBool();
-    return false;
+    return m_NetworkWakeup.value(logical_name, false);
 }
 
 bool EnableSqlManager::monitorWorkingFlag()
 {
-    QString sql = QString("SELECT working_flag FROM %1 WHERE monitor_name='usb';").arg(DB_TABLE_MONITOR_DEV);
-    if (m_sqlQuery.exec(sql) && m_sqlQuery.next())
-        return m_sqlQuery.value(0).toBool();
-    return true;
+    return m_MonitorWorkingFlag;
 }
 
 void EnableSqlManager::setMonitorWorkingFlag(const bool &flag)
 {
     // 先判断是否已经存在
     QString sqlAdd;
-    QString sqlExist = QString("SELECT working_flag FROM %1 WHERE monitor_name='usb';").arg(DB_TABLE_MONITOR_DEV);
-    if (m_sqlQuery.exec(sqlExist) && m_sqlQuery.next()) {
+    if (m_MonitorFlagExisted) {
         sqlAdd = QString("UPDATE %1 SET working_flag=%2 WHERE monitor_name='usb';").arg(DB_TABLE_MONITOR_DEV).arg(":flag");
     } else {
         sqlAdd = QString("INSERT INTO %1 (monitor_name, working_flag) VALUES ('usb', %2);").arg(DB_TABLE_MONITOR_DEV).arg(":flag");
     }
 
-    if(!m_sqlQuery.prepare(sqlAdd)) return;
-    m_sqlQuery.bindValue(":flag", QVariant(flag));
-    if (!m_sqlQuery.exec()) {
-        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+    QSqlQuery *query = statement(sqlAdd);
+    if (!query) return;
+    query->bindValue(":flag", QVariant(flag));
+    if (!query->exec()) {
+        qCInfo(appLog) << Q_FUNC_INFO << query->lastError();
+        return;
     }
+    m_MonitorFlagExisted = true;
+    m_MonitorWorkingFlag = flag;
+}
+
+void EnableSqlManager::beginTransaction()
+{
+    if (0 == m_TransactionLevel++ && !m_db.transaction())
+        qCInfo(appLog) << Q_FUNC_INFO << m_db.lastError();
+}
+
+bool EnableSqlManager::commitTransaction()
+{
+    if (m_TransactionLevel <= 0 || 0 != --m_TransactionLevel)
+        return true;
+    if (m_db.commit())
+        return true;
+
+    // 事务中的写入已经同步到内存索引，提交失败时以数据库为准重新加载
+    qCWarning(appLog) << Q_FUNC_INFO << m_db.lastError();
+    if (!m_db.rollback())
+        qCWarning(appLog) << Q_FUNC_INFO << m_db.lastError();
+    loadIndex();
+    return false;
 }
 
 EnableSqlManager::EnableSqlManager(QObject *parent)
     : QObject(parent)
 {
     qCDebug(appLog) << "Initializing EnableSqlManager...";
-    initDB();
+    initDB(QString("%1%2").arg(DB_PATH).arg(DB_FILE));
 }
 
-void EnableSqlManager::initDB()
+void EnableSqlManager::initDB(const QString &dbFile)
 {
-    qCDebug(appLog) << "Initializing database...";
+    qCDebug(appLog) << "Initializing database..." << dbFile;
     //初始化数据库
     QDir dbDir;
-    if (!dbDir.exists(DB_PATH)) {
-        dbDir.mkpath(DB_PATH);
+    QString dbPath = QFileInfo(dbFile).absolutePath();
+    if (!dbDir.exists(dbPath)) {
+        dbDir.mkpath(dbPath);
     }
     m_db = QSqlDatabase::addDatabase("QSQLITE", DB_CONNECT_NAME);
-    m_db.setDatabaseName(QString("%1%2").arg(DB_PATH).arg(DB_FILE));
+    m_db.setDatabaseName(dbFile);
     if (!m_db.open()) {
         qCWarning(appLog) << "Failed to open database:" << m_db.lastError().text();
         return;
@@ -440,4 +458,65 @@ void EnableSqlManager::initDB()
             qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
         }
     }
+
+    loadIndex();
+}
+
+void EnableSqlManager::loadIndex()
+{
+    m_AuthorizedRows.clear();
+    m_AuthorizedPaths.clear();
+    m_RemoveRows.clear();
+    m_WakeupData.clear();
+    m_NetworkWakeup.clear();
+    m_MonitorFlagExisted = false;
+    m_MonitorWorkingFlag = true;
+
+    QSqlQuery query(m_db);
+    if (query.exec(QString("SELECT path,unique_id FROM %1;").arg(DB_TABLE_AUTHORIZED))) {
+        while (query.next()) {
+            m_AuthorizedRows.append(qMakePair(query.value(0).toString(), query.value(1).toString()));
+            m_AuthorizedPaths.insert(query.value(1).toString(), query.value(0).toString());
+        }
+    }
+    if (query.exec(QString("SELECT path,unique_id FROM %1;").arg(DB_TABLE_REMOVE))) {
+        while (query.next())
+            m_RemoveRows.append(qMakePair(query.value(0).toString(), query.value(1).toString()));
+    }
+    if (query.exec(QString("SELECT unique_id,path,wakeup FROM %1;").arg(DB_TABLE_WAKEUP))) {
+        while (query.next()) {
+            // 重复记录以第一条为准，与 SELECT 的结果一致
+            if (m_WakeupData.contains(query.value(0).toString()))
+                continue;
+            WakeupData data;
+            data.path = query.value(1).toString();
+            data.wakeup = query.value(2).toBool();
+            m_WakeupData.insert(query.value(0).toString(), data);
+        }
+    }
+    if (query.exec(QString("SELECT logical_name,wakeup FROM %1;").arg(DB_TABLE_NETWORK_WAKEUP))) {
+        while (query.next()) {
+            if (!m_NetworkWakeup.contains(query.value(0).toString()))
+                m_NetworkWakeup.insert(query.value(0).toString(), query.value(1).toBool());
+        }
+    }
+    if (query.exec(QString("SELECT working_flag FROM %1 WHERE monitor_name='usb';").arg(DB_TABLE_MONITOR_DEV)) && query.next()) {
+        m_MonitorFlagExisted = true;
+        m_MonitorWorkingFlag = query.value(0).toBool();
+    }
+    qCDebug(appLog) << "Loaded enable index, authorized:" << m_AuthorizedRows.size() << "remove:" << m_RemoveRows.size();
+}
+
+QSqlQuery *EnableSqlManager::statement(const QString &sql)
+{
+    auto it = m_Statements.find(sql);
+    if (it != m_Statements.end())
+        return &it.value();
+
+    QSqlQuery query(m_db);
+    if (!query.prepare(sql)) {
+        qCInfo(appLog) << Q_FUNC_INFO << sql << query.lastError();
+        return nullptr;
+    }
+    return &m_Statements.insert(sql, query).value();
 }
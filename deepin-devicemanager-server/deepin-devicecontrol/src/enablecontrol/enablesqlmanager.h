@@ -6,6 +6,7 @@
 #define ENABLECONFIG_H
 
 #include <QMap>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QSqlDatabase>
@@ -203,17 +204,60 @@ public:
      */
     void setMonitorWorkingFlag(const bool &flag);
 
+    /**
+     * @brief beginTransaction 开始批量写入，与 commitTransaction 成对调用，可以嵌套
+     */
+    void beginTransaction();
+
+    /**
+     * @brief commitTransaction 提交批量写入，提交失败时回滚，内存索引重新从数据库加载
+     * @return 是否提交成功
+     */
+    bool commitTransaction();
+
 protected:
     explicit EnableSqlManager(QObject *parent = nullptr);
 
 private:
-    void initDB();
+    /**
+     * @brief initDB 打开数据库并创建缺少的表
+     * @param dbFile 数据库文件
+     */
+    void initDB(const QString &dbFile);
+
+    /**
+     * @brief loadIndex 把需要按 unique_id、path 查询的表加载到内存
+     */
+    void loadIndex();
+
+    /**
+     * @brief statement 获取已预编译的语句，同一条 sql 只预编译一次
+     * @param sql sql语句
+     * @return 预编译的语句，预编译失败时为 nullptr
+     */
+    QSqlQuery *statement(const QString &sql);
+
+    struct WakeupData {
+        QString path;
+        bool    wakeup = false;
+    };
 
 private:
     static std::atomic<EnableSqlManager *> s_Instance;
     static std::mutex                  m_mutex;
     QSqlDatabase                       m_db;
     QSqlQuery                          m_sqlQuery;
+    QHash<QString, QSqlQuery>          m_Statements;          //<! 预编译语句
+    int                                m_TransactionLevel = 0;
+
+    // 以下为数据库的内存索引，与数据库同步写入
+    QList<QPair<QString, QString>>     m_AuthorizedRows;      //<! authorized 表的 (path, unique_id)
+    QMultiHash<QString, QString>       m_AuthorizedPaths;     //<! unique_id 对应的 path
+    QList<QPair<QString, QString>>     m_RemoveRows;          //<! remove 表的 (path, unique_id)
+    QHash<QString, WakeupData>         m_WakeupData;          //<! wake 表
+    QHash<QString, bool>               m_NetworkWakeup;       //<! net_wake 表
+    bool                               m_MonitorFlagExisted = false;
+    bool                               m_MonitorWorkingFlag = true;
 };
 
 #endif // ENABLECONFIG_H
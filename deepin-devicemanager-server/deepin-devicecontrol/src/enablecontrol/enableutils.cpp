@@ -32,6 +32,8 @@ void EnableUtils::disableOutDevice(const QString &info)
 {
     qCDebug(appLog) << "Disabling out device with info:" << info;
     QStringList items = info.split("\n\n");
+    // 所有设备的数据库更新在一个事务中提交
+    EnableSqlManager::getInstance()->beginTransaction();
     foreach (const QString &item, items) {
         QMap<QString, QString> mapItem;
         if (!getMapInfo(item, mapItem))
@@ -110,6 +112,7 @@ void EnableUtils::disableOutDevice(const QString &info)
         if (EnableSqlManager::getInstance()->uniqueIDExisted(uniqueID)) {
             QFile file("/sys" + path + QString("/authorized"));
             if (!file.open(QIODevice::ReadWrite)) {
+                EnableSqlManager::getInstance()->commitTransaction();
                 return;
             }
             file.write("0");
@@ -118,6 +121,7 @@ void EnableUtils::disableOutDevice(const QString &info)
             EnableSqlManager::getInstance()->updateDataToAuthorizedTable(uniqueID, path);
         }
     }
+    EnableSqlManager::getInstance()->commitTransaction();
 }
 
 void EnableUtils::disableInDevice()
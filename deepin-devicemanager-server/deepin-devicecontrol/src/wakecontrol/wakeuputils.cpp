@@ -5,6 +5,7 @@
 #include "wakeuputils.h"
 #include "enablesqlmanager.h"
 #include "DDLog.h"
+#include "InputDeviceParser.h"
 
 #include <QStringList>
 #include <QMap>
@@ -217,42 +218,9 @@ QString WakeupUtils::getPS2Syspath(const QString &dfs)
     }
     QString eventdfs = matchDfs.captured(1);
 
-    QFile file("/proc/bus/input/devices");
-    if (!file.open(QIODevice::ReadOnly))
-        return "";
-
-    QString info = file.readAll();
-    QStringList lstDevices = info.split("\n\n");
-    foreach (const QString &item, lstDevices) {
-        QStringList lines = item.split("\n");
-        QString sysfs = "";
-        QString event = "";
-        foreach (const QString &line, lines) {
-            if (line.startsWith("S:")) {
-                sysfs = line;
-                continue;
-            }
-            QRegularExpression reg("H: Handlers=.*(event[0-9]{1,2})");
-            QRegularExpressionMatch match = reg.match(line);
-            if (match.hasMatch()) {
-                event = match.captured(1);
-            }
-        }
-
-        if (!event.isEmpty() && !sysfs.isEmpty()) {
-            if (event == eventdfs) {
-                QRegularExpression regfs;
-                if (sysfs.contains("i2c_designware"))
-                    regfs = QRegularExpression("S: Sysfs=(.*)/input/input[0-9]{1,2}");
-                else
-                    regfs = QRegularExpression("S: Sysfs=(.*)/input[0-9]{1,2}");
-                QRegularExpressionMatch matchFs = regfs.match(sysfs);
-                if (matchFs.hasMatch()) {
-                    return matchFs.captured(1);
-                }
-            }
-        }
-    }
+    InputDeviceRecord record;
+    if (InputDeviceParser::findByEvent(InputDeviceParser::devices(), eventdfs, record) && !record.sysfs.isEmpty())
+        return InputDeviceParser::ps2SysPath(record.sysfs);
 
     return "";
 }
@@ -7,26 +7,33 @@
 #include "DDLog.h"
 
 #include <QLoggingCategory>
-#include <QProcess>
-#include <QCryptographicHash>
+#include <QTimer>
 
-#define LEAST_NUM 10
+#include <libudev.h>
+
+#define NOTIFY_DELAY 100
 
 using namespace DDLog;
 
 DetectThread::DetectThread(QObject *parent)
     : QThread(parent)
     , mp_MonitorUsb(new MonitorUsb())
+    , mp_Timer(new QTimer(this))
+    , m_Changed(false)
+    , m_ChangeTime(0)
 {
     qCDebug(appLog) << "Initializing DetectThread";
     // 连接槽函数
     connect(mp_MonitorUsb, SIGNAL(usbChanged()), this, SLOT(slotUsbChanged()), Qt::QueuedConnection);
+    connect(mp_MonitorUsb, &MonitorUsb::deviceChanged, this, &DetectThread::slotDeviceChanged, Qt::QueuedConnection);
+
+    // 扩展坞等设备会在短时间内产生大量事件，合并后统一通知
+    mp_Timer->setSingleShot(true);
+    mp_Timer->setInterval(NOTIFY_DELAY);
+    connect(mp_Timer, &QTimer::timeout, this, &DetectThread::slotUsbChanged);
 
-    QMap<QString, QMap<QString, QString>> usbInfo;
-    qCDebug(appLog) << "Getting initial USB info";
-    curHwinfoUsbInfo(usbInfo);
-    updateMemUsbInfo(usbInfo);
-    qCDebug(appLog) << "Initial USB devices count:" << usbInfo.size();
+    initDevices();
+    qCDebug(appLog) << "Initial USB devices count:" << m_Devices.size();
 }
 
 void DetectThread::run()
@@ -51,128 +58,71 @@ void DetectThread::setWorkingFlag(bool flag)
 
 void DetectThread::slotUsbChanged()
 {
-    // 当监听到新的usb时，内核需要加载usb信息，而上层应用需要在内核处理之后获取信息
-    // 为了确保缓存信息之前，内核已经处理完毕，先判断内核是否处理完信息，且判断时间不能多于10s
-    qint64 begin = QDateTime::currentMSecsSinceEpoch();
-    qint64 end = begin;
-    while ((end - begin) <= 10000) {
-        if (isUsbDevicesChanged())
-            break;
-        sleep(1);
-        end = QDateTime::currentMSecsSinceEpoch();
-    }
-    qCInfo(appLog) << " 此次判断插拔是否完成的时间为 ************ " << QDateTime::currentMSecsSinceEpoch() - begin;
+    // udev事件在内核和udev规则处理完成之后才会发出，收到事件时设备信息已经可以获取
+    if (m_Changed)
+        qCInfo(appLog) << " 此次判断插拔是否完成的时间为 ************ " << QDateTime::currentMSecsSinceEpoch() - m_ChangeTime;
+    m_Changed = false;
+    mp_Timer->stop();
     emit usbChanged();
 }
 
-bool DetectThread::isUsbDevicesChanged()
+void DetectThread::slotDeviceChanged(const QString &action, const QString &devpath)
 {
-    qCDebug(appLog) << "Checking for USB device changes";
-    QMap<QString, QMap<QString, QString>> curUsbInfo;
-    curHwinfoUsbInfo(curUsbInfo);
-
-    // 拔出的时候，如果当前的usb设备个数小于m_MapUsbInfo的个数则返回true
-    if (curUsbInfo.size() < m_MapUsbInfo.size()) {
-        qCDebug(appLog) << "USB device removed, count changed from" << m_MapUsbInfo.size() << "to" << curUsbInfo.size();
-        updateMemUsbInfo(curUsbInfo);
-        return true;
+    bool changed = false;
+    if ("add" == action) {
+        changed = !m_Devices.contains(devpath);
+        m_Devices.insert(devpath);
+    } else if ("remove" == action) {
+        changed = m_Devices.remove(devpath);
     }
 
-    // 数量一样或curUsbInfo的大小大于m_MapUsbInfo的大小，则一个一个的比较
-    // 如果curUsbInfo里面的在m_MapUsbInfo里面找不到则说明内核信息还没有处理完
-    foreach (const QString &key, curUsbInfo.keys()) {
-        if (m_MapUsbInfo.find(key) != m_MapUsbInfo.end())
-            continue;
-        if ("disk" == curUsbInfo[key]["Hardware Class"]
-                && curUsbInfo[key].find("Capacity") == curUsbInfo[key].end())
-            continue;
-        qCDebug(appLog) << "New USB device detected:" << key;
-        updateMemUsbInfo(curUsbInfo);
-        return true;
+    if (!changed) {
+        qCDebug(appLog) << "Device set unchanged, ignore" << action << devpath;
+        return;
     }
-    qCDebug(appLog) << "No USB device changes detected";
-    return false;
-}
-
-void DetectThread::updateMemUsbInfo(const QMap<QString, QMap<QString, QString>> &usbInfo)
-{
-    m_MapUsbInfo.clear();
-    m_MapUsbInfo = usbInfo;
-}
 
-void DetectThread::curHwinfoUsbInfo(QMap<QString, QMap<QString, QString>> &usbInfo)
-{
-    qCDebug(appLog) << "Getting current USB info from hwinfo";
-    QProcess process;
-    process.start("hwinfo --usb --keyboard --mouse");
-    process.waitForFinished(-1);
-    QString info = process.readAllStandardOutput();
-    qCDebug(appLog) << "hwinfo output length:" << info.length();
-
-    QStringList items = info.split("\n\n");
-    qCDebug(appLog) << "Found" << items.size() << "USB devices in hwinfo output";
-    
-    foreach (const QString &item, items) {
-        QMap<QString, QString> mapItem;
-        if (!getMapInfo(item, mapItem))
-            continue;
-
-        QString uniqueID;
-        if (mapItem.contains("Unique ID"))
-            uniqueID = mapItem["Unique ID"];
-        if (mapItem.contains("Vendor") && mapItem.contains("Device") && (mapItem.contains("SysFS ID") || mapItem.contains("SysFS Device Link"))
-                && mapItem["Vendor"].contains("0x") && mapItem["Device"].contains("0x")) {
-            QStringList vendorlist = mapItem["Vendor"].split(" ");
-            QStringList devicelist = mapItem["Device"].split(" ");
-            if (vendorlist.size() > 1 && devicelist.size() > 1  && ((mapItem.contains("SysFS ID") && !mapItem["SysFS ID"].isEmpty())
-                                                                    || (mapItem.contains("SysFS Device Link") && !mapItem["SysFS Device Link"].isEmpty()))) {
-                QString valueStr = vendorlist[1].trimmed() + devicelist[1].remove("0x", Qt::CaseSensitive).trimmed();
-                QCryptographicHash Hash(QCryptographicHash::Md5);
-                QByteArray buf;
-                buf.append(valueStr.toUtf8());
-                if (mapItem.contains("SysFS Device Link") && !mapItem["SysFS Device Link"].isEmpty()) {
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-                    buf.append(mapItem["SysFS Device Link"].trimmed());
-#else
-                    buf.append(mapItem["SysFS Device Link"].trimmed().toUtf8());
-#endif
-                } else {
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-                    buf.append(mapItem["SysFS ID"].trimmed());
-#else
-                    buf.append(mapItem["SysFS ID"].trimmed().toUtf8());
-#endif
-                }
-                Hash.addData(buf);
-                uniqueID = QString::fromStdString(Hash.result().toBase64().toStdString());
-                qCDebug(appLog) << "Generated Unique ID:" << uniqueID;
-            }
-        }
-
-        // 使用 Unique ID 作为唯一标识
-        usbInfo.insert(uniqueID, mapItem);
+    qCDebug(appLog) << "Device" << action << devpath << ", current count:" << m_Devices.size();
+    if (!m_Changed) {
+        m_Changed = true;
+        m_ChangeTime = QDateTime::currentMSecsSinceEpoch();
     }
+    if (!mp_Timer->isActive())
+        mp_Timer->start();
 }
 
-bool DetectThread::getMapInfo(const QString &item, QMap<QString, QString> &mapInfo)
+void DetectThread::initDevices()
 {
-    QStringList lines = item.split("\n");
-    // 行数太少则为无用信息
-    if (lines.size() <= LEAST_NUM) {
-        return false;
+    struct udev *udev = udev_new();
+    if (!udev) {
+        qCWarning(appLog) << "Failed to create udev context";
+        return;
     }
 
-    foreach (const QString &line, lines) {
-        QStringList words = line.split(": ");
-        if (words.size() != 2)
-            continue;
-        mapInfo.insert(words[0].trimmed(), words[1].trimmed());
-    }
-
-    // hub为usb接口，可以直接过滤
-    if ("hub" == mapInfo["Hardware Class"]) {
-        return false;
+    struct udev_enumerate *enumerate = udev_enumerate_new(udev);
+    if (enumerate) {
+        udev_enumerate_add_match_property(enumerate, "DEVTYPE", "usb_device");
+        udev_enumerate_add_match_property(enumerate, "DEVTYPE", "disk");
+        udev_enumerate_scan_devices(enumerate);
+
+        struct udev_list_entry *entry = nullptr;
+        udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+            // 与MonitorUsb保持一致，只记录usb存储设备的磁盘
+            struct udev_device *dev = udev_device_new_from_syspath(udev, udev_list_entry_get_name(entry));
+            if (!dev)
+                continue;
+            const char *devtype = udev_device_get_devtype(dev);
+            bool skip = devtype && 0 == strcmp("disk", devtype) && !MonitorUsb::isUsbDisk(dev);
+            udev_device_unref(dev);
+            if (skip)
+                continue;
+
+            // 枚举得到的是完整的syspath，与udev事件中的devpath保持一致需要去掉 /sys 前缀
+            QString devpath = udev_list_entry_get_name(entry);
+            if (devpath.startsWith("/sys/"))
+                devpath.remove(0, 4);
+            m_Devices.insert(devpath);
+        }
+        udev_enumerate_unref(enumerate);
     }
-
-    return true;
+    udev_unref(udev);
 }
@@ -6,10 +6,11 @@
 #define DETECTTHREAD_H
 
 #include <QThread>
-#include <QMap>
+#include <QSet>
 #include <QDateTime>
 
 class MonitorUsb;
+class QTimer;
 
 /**
  * @brief The DetectThread class
@@ -38,40 +39,29 @@ signals:
 
 private slots:
     /**
-     * @brief slotUsbChanged usb发生变化时的曹函数处理
+     * @brief slotUsbChanged usb发生变化时的曹函数处理，通知上层更新缓存
      */
     void slotUsbChanged();
 
-private:
-    /**
-     * @brief isUsbDevicesChanged 判断hwinfo --usb信息是否发生变化
-     * @return
-     */
-    bool isUsbDevicesChanged();
-
     /**
-     * @brief updateMemUsbInfo 更新
-     * @param usbInfo
+     * @brief slotDeviceChanged 根据udev事件增量更新设备集合
+     * @param action add 或 remove
+     * @param devpath 设备在sysfs中的路径
      */
-    void updateMemUsbInfo(const QMap<QString, QMap<QString, QString>> &usbInfo);
-
-    /**
-     * @brief curHwinfoUsbInfo 获取当前的usb信息
-     * @param usbInfo
-     */
-    void curHwinfoUsbInfo(QMap<QString, QMap<QString, QString>> &usbInfo);
+    void slotDeviceChanged(const QString &action, const QString &devpath);
 
+private:
     /**
-     * @brief getMapInfo 解析usb信息
-     * @param item
-     * @param mapInfo
-     * @return
+     * @brief initDevices 通过udev枚举当前的usb设备和磁盘，作为增量更新的初始集合
      */
-    bool getMapInfo(const QString &item, QMap<QString, QString> &mapInfo);
+    void initDevices();
 
 private:
     MonitorUsb *mp_MonitorUsb; //<! udev检测任务
-    QMap<QString, QMap<QString, QString>> m_MapUsbInfo; //<! usb信息
+    QTimer *mp_Timer; //<! 合并短时间内的多次变化
+    QSet<QString> m_Devices; //<! 当前存在的设备，以sysfs路径为键
+    bool m_Changed; //<! 上次通知之后设备集合是否发生变化
+    qint64 m_ChangeTime; //<! 设备集合第一次发生变化的时间
 };
 
 #endif // DETECTTHREAD_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "monitorusb.h"
+#include "usbinfocollector.h"
 #include "controlinterface.h"
 #include "mainjob.h"
 #include "DDLog.h"
@@ -10,16 +11,12 @@
 #include <QLoggingCategory>
 #include <QProcess>
 #include <QFile>
-#include <QDateTime>
 
 using namespace DDLog;
 
 MonitorUsb::MonitorUsb()
-    : m_Udev(nullptr)
-    , mp_Timer(new QTimer(this))
-    , m_UsbChangeTime()
-    , m_UsbChanged(false)
-    , m_workingFlag(true)
+    : m_workingFlag(true)
+    , m_Udev(nullptr)
 {
     qCDebug(appLog) << "Initializing USB monitor";
     m_Udev = udev_new();
@@ -31,15 +28,12 @@ MonitorUsb::MonitorUsb()
     // 增加一个udev事件过滤器
     udev_monitor_filter_add_match_subsystem_devtype(mon, "usb", nullptr);
     udev_monitor_filter_add_match_subsystem_devtype(mon, "bluetooth", nullptr);
+    // usb存储设备的磁盘晚于usb设备就绪，需要单独监听
+    udev_monitor_filter_add_match_subsystem_devtype(mon, "block", "disk");
     // 启动监控
     udev_monitor_enable_receiving(mon);
     // 获取该监控的文件描述符，fd就代表了这个监控
     fd = udev_monitor_get_fd(mon);
-
-    // 定时器发送消息
-    connect(mp_Timer, &QTimer::timeout, this, &MonitorUsb::slotTimeout);
-    mp_Timer->start(1000);
-    qCDebug(appLog) << "Started USB monitor timer";
 }
 
 void MonitorUsb::monitor()
@@ -87,21 +81,19 @@ void MonitorUsb::monitor()
             continue;
         }
 
+        // 块设备只关心usb存储设备的磁盘
+        const char *subsystem = udev_device_get_subsystem(dev);
+        if (subsystem && 0 == strcmp("block", subsystem) && !isUsbDisk(dev)) {
+            qCDebug(appLog) << "Ignoring non-usb disk" << udev_device_get_devpath(dev);
+            udev_device_unref(dev);
+            continue;
+        }
+
         // 只有add和remove事件才会更新缓存信息
         strcpy(buf, udev_device_get_action(dev));
         if ((0 == strcmp("add", buf) || 0 == strcmp("remove", buf)) && m_workingFlag) {
-            qCDebug(appLog) << "USB device " << buf << " detected";
-            QProcess process;
-            process.start("hwinfo --usb");
-            process.waitForFinished(-1);
-            QString info = process.readAllStandardOutput();
-            if (0 == strcmp("add", buf)) {
-                qCDebug(appLog) << "Processing USB add event";
-                ControlInterface::getInstance()->disableOutDevice(info);
-            }
-            ControlInterface::getInstance()->updateWakeup(info);
-            m_UsbChanged = true;
-            m_UsbChangeTime = QDateTime::currentMSecsSinceEpoch();
+            qCDebug(appLog) << "Device " << buf << " detected";
+            handleEvent(QString(buf), QString(subsystem), QString(udev_device_get_devpath(dev)), dev);
             qCDebug(appLog) << "Updated USB device info";
         }
 
@@ -110,19 +102,39 @@ void MonitorUsb::monitor()
     qCDebug(appLog) << "Exited USB monitor loop";
 }
 
-void MonitorUsb::setWorkingFlag(bool flag)
+void MonitorUsb::handleEvent(const QString &action, const QString &subsystem, const QString &devpath, struct udev_device *dev)
 {
-    qCDebug(appLog) << "Setting working flag to:" << flag;
-    m_workingFlag = flag;
+    // 拔出的设备节点已不存在，无需再禁用或设置唤醒
+    if ("add" == action && "usb" == subsystem) {
+        // 优先直接从udev和sysfs采集变化的设备，失败时回退到 hwinfo
+        QString info;
+        if (!UsbInfoCollector::collect(dev, info)) {
+            qCDebug(appLog) << "Native usb collect failed, fall back to hwinfo";
+            info = hwinfoUsbInfo();
+        }
+        qCDebug(appLog) << "Processing USB add event";
+        ControlInterface::getInstance()->disableOutDevice(info);
+        ControlInterface::getInstance()->updateWakeup(info);
+    }
+    emit deviceChanged(action, devpath);
 }
 
-void MonitorUsb::slotTimeout()
+QString MonitorUsb::hwinfoUsbInfo()
 {
-    if (!m_UsbChanged || !m_workingFlag)
-        return;
-    if (QDateTime::currentMSecsSinceEpoch() - m_UsbChangeTime < 1000)
-        return;
-    qCDebug(appLog) << "Emitting USB changed signal after debounce";
-    m_UsbChanged = false;
-    emit usbChanged();
+    QProcess process;
+    process.start("hwinfo --usb");
+    process.waitForFinished(-1);
+    return process.readAllStandardOutput();
+}
+
+bool MonitorUsb::isUsbDisk(struct udev_device *dev)
+{
+    const char *bus = udev_device_get_property_value(dev, "ID_BUS");
+    return bus && 0 == strcmp("usb", bus);
+}
+
+void MonitorUsb::setWorkingFlag(bool flag)
+{
+    qCDebug(appLog) << "Setting working flag to:" << flag;
+    m_workingFlag = flag;
 }
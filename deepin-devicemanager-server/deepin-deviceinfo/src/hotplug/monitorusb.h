@@ -10,7 +10,6 @@
 #include <unistd.h>
 
 #include <QObject>
-#include <QTimer>
 
 class MonitorUsb : public QObject
 {
@@ -27,26 +26,47 @@ public:
      */
     void setWorkingFlag(bool flag);
 
+    /**
+     * @brief isUsbDisk 是否为usb存储设备的磁盘，loop、dm等虚拟磁盘不关心
+     * @param dev udev设备
+     * @return
+     */
+    static bool isUsbDisk(struct udev_device *dev);
+
 signals:
     /**
      * @brief usbChanged
      */
     void usbChanged();
 
-private slots:
     /**
-     * @brief slotTimeout
+     * @brief deviceChanged usb设备或磁盘插拔
+     * @param action add 或 remove
+     * @param devpath 设备在sysfs中的路径
+     */
+    void deviceChanged(const QString &action, const QString &devpath);
+
+private:
+    /**
+     * @brief handleEvent 处理usb设备或磁盘的插拔事件，usb设备插入时更新禁用和唤醒设置
+     * @param action add 或 remove
+     * @param subsystem 设备所属子系统
+     * @param devpath 设备在sysfs中的路径
+     * @param dev udev设备，用于直接采集usb设备信息
+     */
+    void handleEvent(const QString &action, const QString &subsystem, const QString &devpath, struct udev_device *dev);
+
+    /**
+     * @brief hwinfoUsbInfo 直接采集失败时通过 hwinfo --usb 获取usb设备信息
+     * @return hwinfo的输出
      */
-    void slotTimeout();
+    QString hwinfoUsbInfo();
 
 private:
     bool                              m_workingFlag;        //<! 工作状态
     struct udev                       *m_Udev;              //<! udev Environment
     struct udev_monitor               *mon;                 //<! object of mon
     int                               fd;                   //<! fd
-    QTimer                            *mp_Timer;            //<! 定时器
-    qint64                            m_UsbChangeTime;      //<! 记录当前时间
-    bool                              m_UsbChanged;         //<! 记录是否有usb插拔
 };
 
 #endif // MONITORUSB_H
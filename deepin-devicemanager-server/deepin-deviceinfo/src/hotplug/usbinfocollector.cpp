@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "usbinfocollector.h"
+#include "DDLog.h"
+
+#include <QLoggingCategory>
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+
+#include <string.h>
+
+using namespace DDLog;
+
+bool UsbInfoCollector::collect(struct udev_device *dev, QString &info)
+{
+    if (!dev)
+        return false;
+
+    const char *devtype = udev_device_get_devtype(dev);
+    if (!devtype || 0 != strcmp(devtype, "usb_device")) {
+        qCDebug(appLog) << "Not a usb device, skip native collect";
+        return false;
+    }
+
+    // 枚举该设备下的所有接口，hwinfo --usb 以接口为单位输出
+    struct udev_enumerate *enumerate = udev_enumerate_new(udev_device_get_udev(dev));
+    if (!enumerate)
+        return false;
+    udev_enumerate_add_match_parent(enumerate, dev);
+    udev_enumerate_add_match_subsystem(enumerate, "usb");
+    udev_enumerate_add_match_property(enumerate, "DEVTYPE", "usb_interface");
+    udev_enumerate_scan_devices(enumerate);
+
+    QStringList items;
+    struct udev_list_entry *entry = nullptr;
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+        struct udev_device *intf = udev_device_new_from_syspath(udev_device_get_udev(dev), udev_list_entry_get_name(entry));
+        if (!intf)
+            continue;
+        Record record;
+        if (interfaceRecord(dev, intf, record))
+            items.append(formatRecord(items.size(), record));
+        udev_device_unref(intf);
+    }
+    udev_enumerate_unref(enumerate);
+
+    // 接口尚未创建时无法得到完整信息
+    if (items.isEmpty()) {
+        qCDebug(appLog) << "No usb interface found under" << udev_device_get_syspath(dev);
+        return false;
+    }
+
+    info = items.join("\n\n");
+    qCDebug(appLog) << "Collected" << items.size() << "usb interfaces natively";
+    return true;
+}
+
+QString UsbInfoCollector::formatRecord(int index, const Record &record)
+{
+    QStringList lines;
+    lines.append(QString("%1: USB 00.%2: 0000 USB Device").arg(index + 1).arg(index));
+    lines.append(QString("  [Created at usb.122]"));
+    for (const QPair<QString, QString> &pair : record) {
+        if (pair.second.isEmpty())
+            continue;
+        lines.append(QString("  %1: %2").arg(pair.first).arg(pair.second));
+    }
+    lines.append(QString("  Config Status: cfg=new, avail=yes, need=no, active=unknown"));
+    return lines.join("\n");
+}
+
+QString UsbInfoCollector::hardwareClass(const QString &interfaceClass, const QString &interfaceProtocol)
+{
+    bool ok = false;
+    int cls = interfaceClass.toInt(&ok, 16);
+    if (!ok)
+        return "unknown";
+    int protocol = interfaceProtocol.toInt(nullptr, 16);
+
+    switch (cls) {
+    case 0x01:
+        return "sound";
+    case 0x02:
+    case 0x0a:
+        return "network";
+    case 0x03:
+        if (1 == protocol)
+            return "keyboard";
+        if (2 == protocol)
+            return "mouse";
+        return "unknown";
+    case 0x07:
+        return "printer";
+    case 0x08:
+        return "storage";
+    case 0x09:
+        return "hub";
+    case 0x0e:
+        return "camera";
+    case 0xe0:
+        return "bluetooth";
+    default:
+        return "unknown";
+    }
+}
+
+bool UsbInfoCollector::interfaceRecord(struct udev_device *dev, struct udev_device *intf, Record &record)
+{
+    QString vendorId = value(dev, "ID_VENDOR_ID", "idVendor");
+    QString productId = value(dev, "ID_MODEL_ID", "idProduct");
+    if (vendorId.isEmpty() || productId.isEmpty())
+        return false;
+
+    QString vendorName = value(dev, "ID_VENDOR_FROM_DATABASE", "manufacturer");
+    QString productName = value(dev, "ID_MODEL_FROM_DATABASE", "product");
+    QString hwClass = hardwareClass(value(intf, nullptr, "bInterfaceClass"), value(intf, nullptr, "bInterfaceProtocol"));
+
+    // 与 hwinfo 相同的格式 Vendor: usb 0x046d "Logitech, Inc."
+    QString vendor = QString("usb 0x%1").arg(vendorId.toLower());
+    if (!vendorName.isEmpty())
+        vendor += QString(" \"%1\"").arg(vendorName);
+    QString device = QString("usb 0x%1").arg(productId.toLower());
+    if (!productName.isEmpty())
+        device += QString(" \"%1\"").arg(productName);
+
+    QString devpath = udev_device_get_devpath(intf);
+    QString sysname = udev_device_get_sysname(intf);
+    const char *driver = udev_device_get_driver(intf);
+
+    record.append(qMakePair(QString("Parent ID"), QString(udev_device_get_sysname(dev))));
+    record.append(qMakePair(QString("SysFS ID"), devpath));
+    record.append(qMakePair(QString("SysFS BusID"), sysname));
+    record.append(qMakePair(QString("Hardware Class"), hwClass));
+    QString model = QString("%1 %2").arg(vendorName).arg(productName).trimmed();
+    record.append(qMakePair(QString("Model"), model.isEmpty() ? model : QString("\"%1\"").arg(model)));
+    record.append(qMakePair(QString("Hotplug"), QString("USB")));
+    record.append(qMakePair(QString("Vendor"), vendor));
+    record.append(qMakePair(QString("Device"), device));
+    record.append(qMakePair(QString("Revision"), value(dev, nullptr, "version")));
+    record.append(qMakePair(QString("Serial ID"), value(dev, "ID_SERIAL_SHORT", "serial")));
+    if (driver) {
+        record.append(qMakePair(QString("Driver"), QString("\"%1\"").arg(driver)));
+        record.append(qMakePair(QString("Driver Modules"), QString("\"%1\"").arg(driver)));
+    }
+
+    // usb网卡，补充逻辑名称和物理地址
+    QDir netDir(QString("/sys%1/net").arg(devpath));
+    QStringList netNames = netDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    if (!netNames.isEmpty()) {
+        record.append(qMakePair(QString("Device File"), netNames.first()));
+        QFile file(netDir.filePath(netNames.first() + "/address"));
+        if (file.open(QIODevice::ReadOnly)) {
+            record.append(qMakePair(QString("Permanent HW Address"), QString(file.readAll()).trimmed()));
+            file.close();
+        }
+    }
+    record.append(qMakePair(QString("Module Alias"), value(intf, "MODALIAS", "modalias")));
+    return true;
+}
+
+QString UsbInfoCollector::value(struct udev_device *dev, const char *property, const char *sysattr)
+{
+    const char *str = nullptr;
+    if (property)
+        str = udev_device_get_property_value(dev, property);
+    if (!str && sysattr)
+        str = udev_device_get_sysattr_value(dev, sysattr);
+    return str ? QString(str).trimmed() : QString();
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef USBINFOCOLLECTOR_H
+#define USBINFOCOLLECTOR_H
+
+#include <libudev.h>
+
+#include <QString>
+#include <QList>
+#include <QPair>
+
+/**
+ * @brief UsbInfoCollector 根据udev事件直接从sysfs生成与 hwinfo --usb 格式一致的设备信息
+ * 只采集发生变化的设备，避免每次插拔都启动 hwinfo 扫描整个总线
+ */
+class UsbInfoCollector
+{
+public:
+    typedef QList<QPair<QString, QString>> Record;
+
+    /**
+     * @brief collect 采集usb设备下所有接口的信息
+     * @param dev udev事件中的usb_device
+     * @param info 输出hwinfo格式的信息，每个接口一段，以空行分隔
+     * @return 采集失败返回false，此时调用者应回退到 hwinfo
+     */
+    static bool collect(struct udev_device *dev, QString &info);
+
+    /**
+     * @brief formatRecord 将一个接口的键值信息格式化为hwinfo格式的一段
+     * @param index 序号
+     * @param record 键值信息
+     * @return
+     */
+    static QString formatRecord(int index, const Record &record);
+
+    /**
+     * @brief hardwareClass 根据接口类型获取hwinfo中的 Hardware Class
+     * @param interfaceClass bInterfaceClass
+     * @param interfaceProtocol bInterfaceProtocol
+     * @return
+     */
+    static QString hardwareClass(const QString &interfaceClass, const QString &interfaceProtocol);
+
+private:
+    /**
+     * @brief interfaceRecord 获取单个接口的键值信息
+     * @param dev usb_device
+     * @param intf usb_interface
+     * @param record 输出键值信息
+     * @return
+     */
+    static bool interfaceRecord(struct udev_device *dev, struct udev_device *intf, Record &record);
+
+    /**
+     * @brief value 优先读取udev属性，没有时读取sysfs属性
+     * @param dev
+     * @param property udev属性名
+     * @param sysattr sysfs属性名
+     * @return
+     */
+    static QString value(struct udev_device *dev, const char *property, const char *sysattr);
+};
+
+#endif // USBINFOCOLLECTOR_H
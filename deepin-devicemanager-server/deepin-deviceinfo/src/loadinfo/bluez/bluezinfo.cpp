@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "bluezinfo.h"
+#include "DDLog.h"
+
+#include <QLoggingCategory>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusReply>
+#include <QDBusMetaType>
+
+using namespace DDLog;
+
+#define BLUEZ_SERVICE           "org.bluez"
+#define BLUEZ_OBJECT_MANAGER    "org.freedesktop.DBus.ObjectManager"
+#define BLUEZ_DEVICE            "org.bluez.Device1"
+#define BLUEZ_TIMEOUT           500     // ms
+
+bool BluezInfo::pairedDevices(QString &info)
+{
+    qDBusRegisterMetaType<BluezInterfaceMap>();
+    qDBusRegisterMetaType<BluezObjectMap>();
+
+    QDBusConnection bus = QDBusConnection::systemBus();
+    if (!bus.isConnected())
+        return false;
+
+    QDBusMessage message = QDBusMessage::createMethodCall(BLUEZ_SERVICE, "/", BLUEZ_OBJECT_MANAGER, "GetManagedObjects");
+    QDBusReply<BluezObjectMap> reply = bus.call(message, QDBus::Block, BLUEZ_TIMEOUT);
+    if (!reply.isValid()) {
+        qCInfo(appLog) << "Failed to get bluez managed objects:" << reply.error().message();
+        return false;
+    }
+
+    info = formatPairedDevices(reply.value());
+    return true;
+}
+
+QString BluezInfo::formatPairedDevices(const BluezObjectMap &objects)
+{
+    QString info;
+    for (auto it = objects.begin(); it != objects.end(); ++it) {
+        auto device = it.value().find(BLUEZ_DEVICE);
+        if (device == it.value().end() || !device->value("Paired").toBool())
+            continue;
+
+        // bluetoothctl 显示别名，没有别名时显示地址
+        QString address = device->value("Address").toString();
+        QString alias = device->value("Alias").toString();
+        info += QString("Device %1 %2\n").arg(address).arg(alias.isEmpty() ? address : alias);
+    }
+    return info;
+}
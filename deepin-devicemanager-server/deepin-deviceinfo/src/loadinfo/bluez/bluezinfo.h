@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BLUEZINFO_H
+#define BLUEZINFO_H
+
+#include <QString>
+#include <QMap>
+#include <QVariantMap>
+#include <QDBusObjectPath>
+#include <QMetaType>
+
+typedef QMap<QString, QVariantMap> BluezInterfaceMap;               // a{sa{sv}}
+typedef QMap<QDBusObjectPath, BluezInterfaceMap> BluezObjectMap;     // a{oa{sa{sv}}}
+Q_DECLARE_METATYPE(BluezInterfaceMap)
+Q_DECLARE_METATYPE(BluezObjectMap)
+
+/**
+ * @brief BluezInfo 通过 BlueZ 的 GetManagedObjects 一次获取所有蓝牙设备
+ * 代替 bluetoothctl paired-devices 及其500ms的等待
+ */
+class BluezInfo
+{
+public:
+    /**
+     * @brief pairedDevices 获取已配对的设备
+     * @param info 输出与 bluetoothctl paired-devices 相同格式的信息
+     * @return bluetoothd 不可用时返回false，此时调用者应回退到 bluetoothctl
+     */
+    static bool pairedDevices(QString &info);
+
+    /**
+     * @brief formatPairedDevices 将 GetManagedObjects 的结果格式化为 bluetoothctl paired-devices 的输出
+     * @param objects GetManagedObjects 的返回值
+     * @return 每行为 Device <地址> <别名>
+     */
+    static QString formatPairedDevices(const BluezObjectMap &objects);
+};
+
+#endif // BLUEZINFO_H
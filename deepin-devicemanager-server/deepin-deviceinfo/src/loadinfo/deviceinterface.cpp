@@ -12,6 +12,7 @@
 #include <QDebug>
 #include <QFile>
 #include <QRegularExpression>
+#include <QDateTime>
 
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 #include <polkit-qt5-1/PolkitQt1/Authority>
@@ -21,17 +22,39 @@
 
 using namespace DDLog;
 constexpr char kGraphicsMemory[] { "Graphics Memory" };
+// 读取信息的认证结果缓存时间，与polkit的auth_admin_keep保持一致
+constexpr qint64 kAuthorizationTimeout { 5 * 60 * 1000 };
 
 using namespace PolkitQt1;
-bool DeviceInterface::getUserAuthorPasswd()
+bool DeviceInterface::getUserAuthorPasswd(bool cacheable)
 {
 #ifdef DISABLE_POLKIT
     return true;
 #endif
+    // 总线唯一名称在连接断开之前只对应一个调用进程，可以用来缓存认证结果
+    const QString caller = message().service();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (cacheable) {
+        auto it = m_AuthorizedCallers.begin();
+        while (it != m_AuthorizedCallers.end()) {
+            if (it.value() <= now)
+                it = m_AuthorizedCallers.erase(it);
+            else
+                ++it;
+        }
+        if (m_AuthorizedCallers.contains(caller))
+            return true;
+    }
+
     Authority::Result result = Authority::instance()->checkAuthorizationSync("com.deepin.deepin-devicemanager.checkAuthentication",
-                                                                             SystemBusNameSubject(message().service()),
+                                                                             SystemBusNameSubject(caller),
                                                                              Authority::AllowUserInteraction);
-    return result == Authority::Yes;
+    if (result != Authority::Yes)
+        return false;
+
+    if (cacheable)
+        m_AuthorizedCallers.insert(caller, now + kAuthorizationTimeout);
+    return true;
 }
 
 bool DeviceInterface::getGpuMemInfoForFTDTM(QMap<QString, QString> &mapInfo)
@@ -82,6 +105,7 @@ bool DeviceInterface::getGpuMemInfoForFTDTM(QMap<QString, QString> &mapInfo)
 
 DeviceInterface::DeviceInterface(const char *name, QObject *parent)
     : QObject(parent)
+    , m_ConnectionName(name)
 {
     qCDebug(appLog) << "Initializing DeviceInterface for service:" << name;
     QDBusConnection::RegisterOptions opts =
@@ -96,13 +120,21 @@ QString DeviceInterface::getInfo(const QString &key)
     qCDebug(appLog) << "Getting info for key:" << key;
 
     // 获取设备信息需要身份验证
-    if (!getUserAuthorPasswd()) {
+    if (!getUserAuthorPasswd(true)) {
         qCWarning(appLog) << "Authorization failed for getInfo operation";
         return "0";
     }
 
     // 不能返回用常引用
     if ("is_server_running" != key) {
+        // 信息正在加载，加载完成后再回复
+        MainJob *parentMainJob = dynamic_cast<MainJob *>(parent());
+        if (parentMainJob != nullptr && parentMainJob->isInfoPending(key)) {
+            qCDebug(appLog) << "Info is loading, delay the reply of key:" << key;
+            setDelayedReply(true);
+            m_DelayedReplies[key].append(message());
+            return QString();
+        }
         return DeviceInfoManager::getInstance()->getInfo(key);
     }
     if (MainJob::serverIsRunning()) {
@@ -113,6 +145,57 @@ QString DeviceInterface::getInfo(const QString &key)
     return "0";
 }
 
+QVariantMap DeviceInterface::getInfos(const QStringList &keys)
+{
+    qCDebug(appLog) << "Getting info for keys:" << keys;
+
+    // 一次认证获取所有信息
+    if (!getUserAuthorPasswd(true)) {
+        qCWarning(appLog) << "Authorization failed for getInfos operation";
+        return QVariantMap();
+    }
+
+    // 立即回复已加载完成的信息，正在加载的信息由调用者通过 getInfo 单独获取
+    return infoMap(keys);
+}
+
+void DeviceInterface::slotInfoReady(const QString &key)
+{
+    Q_UNUSED(key)
+    if (m_DelayedReplies.isEmpty())
+        return;
+
+    MainJob *parentMainJob = dynamic_cast<MainJob *>(parent());
+    QDBusConnection connection(m_ConnectionName);
+    // smartctl_*等信息由其它命令附带生成，所以每次都检查所有等待中的key
+    auto it = m_DelayedReplies.begin();
+    while (it != m_DelayedReplies.end()) {
+        if (parentMainJob != nullptr && parentMainJob->isInfoPending(it.key())) {
+            ++it;
+            continue;
+        }
+
+        const QString &info = DeviceInfoManager::getInstance()->getInfo(it.key());
+        foreach (const QDBusMessage &msg, it.value())
+            connection.send(msg.createReply(info));
+        qCDebug(appLog) << "Reply the delayed getInfo, key:" << it.key() << "callers:" << it.value().size();
+        it = m_DelayedReplies.erase(it);
+    }
+}
+
+QVariantMap DeviceInterface::infoMap(const QStringList &keys)
+{
+    MainJob *parentMainJob = dynamic_cast<MainJob *>(parent());
+    QVariantMap infos;
+    foreach (const QString &key, keys) {
+        if ("is_server_running" == key)
+            infos.insert(key, MainJob::serverIsRunning() ? "1" : "0");
+        else if (parentMainJob == nullptr || !parentMainJob->isInfoPending(key))
+            infos.insert(key, DeviceInfoManager::getInstance()->getInfo(key));
+    }
+    return infos;
+}
+
 void DeviceInterface::refreshInfo()
 {
     if (!getUserAuthorPasswd()) {
@@ -7,6 +7,10 @@
 
 #include <QObject>
 #include <QDBusContext>
+#include <QDBusMessage>
+#include <QMap>
+#include <QStringList>
+#include <QVariantMap>
 
 class DeviceInterface : public QObject, protected QDBusContext
 {
@@ -16,6 +20,13 @@ class DeviceInterface : public QObject, protected QDBusContext
 public:
     explicit DeviceInterface(const char *name, QObject *parent = nullptr);
 
+    /**
+     * @brief slotInfoReady : reply the delayed getInfo calls whose info is loaded,
+     * not a slot so that it is not exported to DBus
+     * @param key : the finished key
+     */
+    void slotInfoReady(const QString &key);
+
 signals:
     void sigUpdate();
 
@@ -27,6 +38,14 @@ public slots:
      */
     Q_SCRIPTABLE QString getInfo(const QString &key);
 
+    /**
+     * @brief getInfos : Obtain the hardware information of several keys in one call,
+     * keys that are still loading are left out and can be fetched with getInfo
+     * @param keys
+     * @return : key -> hardware info
+     */
+    Q_SCRIPTABLE QVariantMap getInfos(const QStringList &keys);
+
     /**
      * @brief refreshInfo
      * @return
@@ -42,8 +61,26 @@ public slots:
     Q_SCRIPTABLE QString getGpuInfoForFTDTM();
 
 private:
-    bool getUserAuthorPasswd();
+    /**
+     * @brief getUserAuthorPasswd : check the caller through polkit
+     * @param cacheable : reuse a successful check of the same caller for a while,
+     * only for reading info, privileged operations are always checked
+     * @return
+     */
+    bool getUserAuthorPasswd(bool cacheable = false);
     bool getGpuMemInfoForFTDTM(QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief infoMap : collect the info of the keys that are not loading
+     * @param keys
+     * @return
+     */
+    QVariantMap infoMap(const QStringList &keys);
+
+private:
+    QString                              m_ConnectionName;     //<! name of the DBus connection
+    QMap<QString, QList<QDBusMessage>>   m_DelayedReplies;     //<! getInfo calls waiting for the info
+    QMap<QString, qint64>                m_AuthorizedCallers;  //<! caller -> time the read authorization expires
 };
 
 #endif   // DEVICEINTERFACE_H
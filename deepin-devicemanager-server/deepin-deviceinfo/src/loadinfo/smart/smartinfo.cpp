@@ -0,0 +1,666 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "smartinfo.h"
+#include "DDLog.h"
+
+#include <QLoggingCategory>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <scsi/sg.h>
+#include <scsi/scsi.h>
+#include <linux/nvme_ioctl.h>
+
+using namespace DDLog;
+
+#define ATA_SECTOR_SIZE         512
+#define NVME_IDENTIFY_SIZE      4096
+#define NVME_SMART_LOG_SIZE     512
+#define SG_IO_TIMEOUT           5000    // ms
+
+// 与 smartctl 的默认属性名称一致，客户端按名称取值
+static const struct {
+    int         id;
+    const char *name;
+} s_AtaAttributes[] = {
+    {1,   "Raw_Read_Error_Rate"},
+    {2,   "Throughput_Performance"},
+    {3,   "Spin_Up_Time"},
+    {4,   "Start_Stop_Count"},
+    {5,   "Reallocated_Sector_Ct"},
+    {7,   "Seek_Error_Rate"},
+    {8,   "Seek_Time_Performance"},
+    {9,   "Power_On_Hours"},
+    {10,  "Spin_Retry_Count"},
+    {11,  "Calibration_Retry_Count"},
+    {12,  "Power_Cycle_Count"},
+    {183, "Runtime_Bad_Block"},
+    {184, "End-to-End_Error"},
+    {187, "Reported_Uncorrect"},
+    {188, "Command_Timeout"},
+    {189, "High_Fly_Writes"},
+    {190, "Airflow_Temperature_Cel"},
+    {191, "G-Sense_Error_Rate"},
+    {192, "Power-Off_Retract_Count"},
+    {193, "Load_Cycle_Count"},
+    {194, "Temperature_Celsius"},
+    {195, "Hardware_ECC_Recovered"},
+    {196, "Reallocated_Event_Count"},
+    {197, "Current_Pending_Sector"},
+    {198, "Offline_Uncorrectable"},
+    {199, "UDMA_CRC_Error_Count"},
+    {200, "Multi_Zone_Error_Rate"},
+    {240, "Head_Flying_Hours"},
+    {241, "Total_LBAs_Written"},
+    {242, "Total_LBAs_Read"},
+};
+
+static QString ataAttributeName(int id)
+{
+    for (const auto &attr : s_AtaAttributes) {
+        if (attr.id == id)
+            return QString(attr.name);
+    }
+    return QString("Unknown_Attribute");
+}
+
+// 小端整数
+static quint64 littleEndian(const QByteArray &data, int offset, int size)
+{
+    quint64 value = 0;
+    for (int i = size - 1; i >= 0; --i)
+        value = value << 8 | static_cast<uchar>(data[offset + i]);
+    return value;
+}
+
+// 大端整数
+static quint64 bigEndian(const QByteArray &data, int offset, int size)
+{
+    quint64 value = 0;
+    for (int i = 0; i < size; ++i)
+        value = value << 8 | static_cast<uchar>(data[offset + i]);
+    return value;
+}
+
+static quint16 ataWord(const QByteArray &identify, int index)
+{
+    return static_cast<quint16>(littleEndian(identify, index * 2, 2));
+}
+
+// identify 中的字符串每个字内高低字节交换
+static QString ataString(const QByteArray &identify, int firstWord, int words)
+{
+    QByteArray str;
+    for (int i = firstWord; i < firstWord + words; ++i) {
+        str.append(identify[i * 2 + 1]);
+        str.append(identify[i * 2]);
+    }
+    return QString::fromLatin1(str).trimmed();
+}
+
+static QString asciiString(const QByteArray &data, int offset, int size)
+{
+    return QString::fromLatin1(data.mid(offset, size)).trimmed();
+}
+
+static QString keyValue(const QString &key, const QString &value, int width)
+{
+    return (key + ": ").leftJustified(width) + value + "\n";
+}
+
+// smartctl 中容量的格式: 500,107,862,016 [500 GB]，为0时只输出0
+static QString sizeString(quint64 bytes)
+{
+    if (0 == bytes)
+        return QString("0");
+    return SmartInfo::formatNumber(bytes) + " [" + SmartInfo::formatCapacity(bytes) + "]";
+}
+
+static QString sataVersion(quint16 word222, quint16 word076, quint16 word077)
+{
+    // 高4位为1时才是SATA
+    if ((word222 & 0xf000) != 0x1000)
+        return QString();
+
+    static const char *versions[] = {"ATA8-AST", "SATA 1.0a", "SATA II Ext", "SATA 2.5", "SATA 2.6", "SATA 3.0",
+                                     "SATA 3.1", "SATA 3.2", "SATA 3.3", "SATA 3.4", "SATA 3.5", "SATA >3.5"
+                                    };
+    static const char *speeds[] = {"", "1.5 Gb/s", "3.0 Gb/s", "6.0 Gb/s"};
+
+    int msb = -1;
+    for (int i = 11; i >= 0; --i) {
+        if (word222 & (1 << i)) {
+            msb = i;
+            break;
+        }
+    }
+    if (msb < 0)
+        return QString();
+
+    QString version(versions[msb]);
+    int maxSpeed = 0;
+    if (!(word076 & 0x0001)) {
+        for (int i = 3; i >= 1; --i) {
+            if (word076 & (1 << i)) {
+                maxSpeed = i;
+                break;
+            }
+        }
+    }
+    if (maxSpeed)
+        version += QString(", ") + speeds[maxSpeed];
+    int curSpeed = !(word077 & 0x0001) ? ((word077 >> 1) & 0x7) : 0;
+    if (curSpeed > 0 && curSpeed <= 3)
+        version += QString(" (current: ") + speeds[curSpeed] + ")";
+    return version;
+}
+
+static QString formFactor(quint16 word168)
+{
+    switch (word168 & 0xf) {
+    case 1: return QString("5.25 inches");
+    case 2: return QString("3.5 inches");
+    case 3: return QString("2.5 inches");
+    case 4: return QString("1.8 inches");
+    case 5: return QString("< 1.8 inches");
+    default: return QString();
+    }
+}
+
+static QString rotationRate(quint16 rate)
+{
+    if (1 == rate)
+        return QString("Solid State Device");
+    if (rate >= 0x0401 && rate != 0xffff)
+        return QString("%1 rpm").arg(rate);
+    return QString();
+}
+
+static QString scsiDeviceType(int type)
+{
+    switch (type) {
+    case 0x00: return QString("disk");
+    case 0x01: return QString("tape");
+    case 0x04: return QString("write once optical disk");
+    case 0x05: return QString("CD/DVD");
+    case 0x07: return QString("optical disk");
+    case 0x08: return QString("medium changer");
+    case 0x0c: return QString("storage array");
+    case 0x0d: return QString("enclosure");
+    case 0x0e: return QString("simplified disk");
+    default: return QString();
+    }
+}
+
+static void ataPassThrough(unsigned char *cdb, unsigned char command, unsigned char feature)
+{
+    memset(cdb, 0, 16);
+    cdb[0] = 0x85;          // ATA PASS-THROUGH(16)
+    cdb[1] = 4 << 1;        // PIO Data-In
+    cdb[2] = 0x0e;          // 读数据，长度以扇区为单位，记录在 sector count 中
+    cdb[4] = feature;
+    cdb[6] = 1;             // sector count
+    if (0xb0 == command) {
+        // SMART 命令需要的签名
+        cdb[10] = 0x4f;
+        cdb[12] = 0xc2;
+    }
+    cdb[14] = command;
+}
+
+bool SmartInfo::read(const QString &name, QString &info)
+{
+    QString path = "/dev/" + name;
+    int fd = open(path.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK);
+    if (fd < 0) {
+        qCWarning(appLog) << "Failed to open" << path << strerror(errno);
+        return false;
+    }
+
+    bool ok = false;
+    if (name.startsWith("nvme"))
+        ok = readNvme(fd, info);
+    else if (readAta(fd, info))
+        ok = true;
+    else if (!isUsbDevice(name))
+        ok = readScsi(fd, info);
+    close(fd);
+
+    qCDebug(appLog) << "Read smart info natively for" << name << (ok ? "succeeded" : "failed");
+    return ok;
+}
+
+QString SmartInfo::formatAta(const QByteArray &identify, const QByteArray &smartData, const QByteArray &thresholds)
+{
+    if (identify.size() < ATA_SECTOR_SIZE)
+        return QString();
+
+    const int width = 18;
+    QString info("=== START OF INFORMATION SECTION ===\n");
+    info += keyValue("Device Model", ataString(identify, 27, 20), width);
+    info += keyValue("Serial Number", ataString(identify, 10, 10), width);
+    info += keyValue("Firmware Version", ataString(identify, 23, 4), width);
+
+    // 扇区大小，word 106 第14位为1、第15位为0时有效
+    quint64 logical = 512;
+    quint64 physical = 512;
+    quint16 word106 = ataWord(identify, 106);
+    if ((word106 & 0xc000) == 0x4000) {
+        if (word106 & 0x1000)
+            logical = (quint64(ataWord(identify, 118)) << 16 | ataWord(identify, 117)) * 2;
+        if (word106 & 0x2000)
+            physical = logical << (word106 & 0xf);
+        else
+            physical = logical;
+    }
+
+    // 支持48位地址时使用 word 100-103
+    quint64 sectors = 0;
+    if (ataWord(identify, 83) & 0x0400)
+        sectors = littleEndian(identify, 200, 8);
+    if (0 == sectors)
+        sectors = littleEndian(identify, 120, 4);
+    if (sectors)
+        info += keyValue("User Capacity", formatNumber(sectors * logical) + " bytes [" + formatCapacity(sectors * logical) + "]", width);
+
+    if (logical == physical)
+        info += keyValue("Sector Size", QString("%1 bytes logical/physical").arg(logical), width);
+    else
+        info += keyValue("Sector Sizes", QString("%1 bytes logical, %2 bytes physical").arg(logical).arg(physical), width);
+
+    QString rate = rotationRate(ataWord(identify, 217));
+    if (!rate.isEmpty())
+        info += keyValue("Rotation Rate", rate, width);
+
+    QString factor = formFactor(ataWord(identify, 168));
+    if (!factor.isEmpty())
+        info += keyValue("Form Factor", factor, width);
+
+    QString sata = sataVersion(ataWord(identify, 222), ataWord(identify, 76), ataWord(identify, 77));
+    if (!sata.isEmpty())
+        info += keyValue("SATA Version is", sata, width);
+
+    bool smartSupported = ataWord(identify, 82) & 0x0001;
+    if (smartSupported) {
+        info += keyValue("SMART support is", "Available - device has SMART capability.", width);
+        info += keyValue("SMART support is", (ataWord(identify, 85) & 0x0001) ? "Enabled" : "Disabled", width);
+    } else {
+        info += keyValue("SMART support is", "Unavailable - device lacks SMART capability.", width);
+    }
+
+    if (smartData.size() < ATA_SECTOR_SIZE)
+        return info;
+
+    // 属性表: 偏移2开始30项，每项12字节 id、flags(2)、value、worst、raw(6)、保留
+    info += "\n=== START OF READ SMART DATA SECTION ===\n";
+    info += QString("SMART Attributes Data Structure revision number: %1\n").arg(littleEndian(smartData, 0, 2));
+    info += "Vendor Specific SMART Attributes with Thresholds:\n";
+    info += "ID# ATTRIBUTE_NAME          FLAG     VALUE WORST THRESH TYPE      UPDATED  WHEN_FAILED RAW_VALUE\n";
+    bool hasThresholds = thresholds.size() >= ATA_SECTOR_SIZE;
+    for (int i = 0; i < 30; ++i) {
+        int offset = 2 + i * 12;
+        int id = static_cast<uchar>(smartData[offset]);
+        if (0 == id)
+            continue;
+
+        quint16 flags = static_cast<quint16>(littleEndian(smartData, offset + 1, 2));
+        int value = static_cast<uchar>(smartData[offset + 3]);
+        int worst = static_cast<uchar>(smartData[offset + 4]);
+
+        // 阈值表与属性表顺序相同
+        int threshold = -1;
+        if (hasThresholds && static_cast<uchar>(thresholds[offset]) == id)
+            threshold = static_cast<uchar>(thresholds[offset + 1]);
+
+        QString failed("    -");
+        if (threshold > 0 && value <= threshold)
+            failed = "FAILING_NOW";
+        else if (threshold > 0 && worst <= threshold)
+            failed = "In_the_past";
+
+        // 温度只取最低字节，其余字节为厂商自定义的最高最低温度
+        quint64 raw = (194 == id || 190 == id) ? static_cast<uchar>(smartData[offset + 5]) : littleEndian(smartData, offset + 5, 6);
+
+        info += QString::number(id).rightJustified(3) + " "
+                + ataAttributeName(id).leftJustified(23) + " "
+                + "0x" + QString::number(flags, 16).rightJustified(4, '0') + "   "
+                + QString::number(value).rightJustified(3, '0') + "   "
+                + QString::number(worst).rightJustified(3, '0') + "   "
+                + (threshold < 0 ? QString("---") : QString::number(threshold).rightJustified(3, '0')) + "    "
+                + QString((flags & 0x0001) ? "Pre-fail" : "Old_age").leftJustified(10)
+                + QString((flags & 0x0002) ? "Always" : "Offline").leftJustified(9)
+                + failed.leftJustified(12)
+                + QString::number(raw) + "\n";
+    }
+    return info;
+}
+
+QString SmartInfo::formatNvme(const QByteArray &controller, const QByteArray &nameSpace, quint32 nsid, const QByteArray &smartLog)
+{
+    if (controller.size() < NVME_IDENTIFY_SIZE)
+        return QString();
+
+    const int width = 36;
+    QString info("=== START OF INFORMATION SECTION ===\n");
+    info += keyValue("Model Number", asciiString(controller, 24, 40), width);
+    info += keyValue("Serial Number", asciiString(controller, 4, 20), width);
+    info += keyValue("Firmware Version", asciiString(controller, 64, 8), width);
+
+    quint64 vid = littleEndian(controller, 0, 2);
+    quint64 ssvid = littleEndian(controller, 2, 2);
+    if (vid == ssvid) {
+        info += keyValue("PCI Vendor/Subsystem ID", QString("0x%1").arg(vid, 4, 16, QChar('0')), width);
+    } else {
+        info += keyValue("PCI Vendor ID", QString("0x%1").arg(vid, 4, 16, QChar('0')), width);
+        info += keyValue("PCI Vendor Subsystem ID", QString("0x%1").arg(ssvid, 4, 16, QChar('0')), width);
+    }
+    info += keyValue("IEEE OUI Identifier", QString("0x%1").arg(littleEndian(controller, 73, 3), 6, 16, QChar('0')), width);
+
+    // tnvmcap、unvmcap 为128位，只取低64位
+    quint64 total = littleEndian(controller, 280, 8);
+    if (total) {
+        info += keyValue("Total NVM Capacity", sizeString(total), width);
+        info += keyValue("Unallocated NVM Capacity", sizeString(littleEndian(controller, 296, 8)), width);
+    }
+    info += keyValue("Controller ID", QString::number(littleEndian(controller, 78, 2)), width);
+
+    quint64 version = littleEndian(controller, 80, 4);
+    if (version) {
+        QString str = QString("%1.%2").arg(version >> 16).arg((version >> 8) & 0xff);
+        if (version & 0xff)
+            str += QString(".%1").arg(version & 0xff);
+        info += keyValue("NVMe Version", str, width);
+    }
+    info += keyValue("Number of Namespaces", QString::number(littleEndian(controller, 516, 4)), width);
+
+    if (nameSpace.size() >= NVME_IDENTIFY_SIZE) {
+        // 当前使用的 LBA 格式，lbads 为2的幂
+        int format = static_cast<uchar>(nameSpace[26]) & 0xf;
+        int lbads = static_cast<uchar>(nameSpace[128 + format * 4 + 2]);
+        quint64 lbaSize = lbads >= 9 && lbads < 32 ? quint64(1) << lbads : 512;
+        quint64 size = littleEndian(nameSpace, 0, 8) * lbaSize;
+        quint64 capacity = littleEndian(nameSpace, 8, 8) * lbaSize;
+        quint64 utilization = littleEndian(nameSpace, 16, 8) * lbaSize;
+        QString prefix = QString("Namespace %1 ").arg(nsid);
+        if (size == capacity) {
+            info += keyValue(prefix + "Size/Capacity", sizeString(size), width);
+        } else {
+            info += keyValue(prefix + "Size", sizeString(size), width);
+            info += keyValue(prefix + "Capacity", sizeString(capacity), width);
+        }
+        if (utilization)
+            info += keyValue(prefix + "Utilization", sizeString(utilization), width);
+        info += keyValue(prefix + "Formatted LBA Size", QString::number(lbaSize), width);
+    }
+
+    if (smartLog.size() < NVME_SMART_LOG_SIZE)
+        return info;
+
+    int warning = static_cast<uchar>(smartLog[0]);
+    info += "\n=== START OF SMART DATA SECTION ===\n";
+    info += QString("SMART overall-health self-assessment test result: %1\n").arg(warning ? "FAILED!" : "PASSED");
+    info += "\nSMART/Health Information (NVMe Log 0x02)\n";
+    info += keyValue("Critical Warning", QString("0x%1").arg(warning, 2, 16, QChar('0')), width);
+    quint64 kelvin = littleEndian(smartLog, 1, 2);
+    if (kelvin)
+        info += keyValue("Temperature", QString("%1 Celsius").arg(int(kelvin) - 273), width);
+    info += keyValue("Available Spare", QString("%1%").arg(static_cast<uchar>(smartLog[3])), width);
+    info += keyValue("Available Spare Threshold", QString("%1%").arg(static_cast<uchar>(smartLog[4])), width);
+    info += keyValue("Percentage Used", QString("%1%").arg(static_cast<uchar>(smartLog[5])), width);
+
+    // 数据单位为1000个512字节，128位计数只取低64位
+    quint64 unitsRead = littleEndian(smartLog, 32, 8);
+    quint64 unitsWritten = littleEndian(smartLog, 48, 8);
+    info += keyValue("Data Units Read", formatNumber(unitsRead) + " [" + formatCapacity(unitsRead * 512000) + "]", width);
+    info += keyValue("Data Units Written", formatNumber(unitsWritten) + " [" + formatCapacity(unitsWritten * 512000) + "]", width);
+    info += keyValue("Host Read Commands", formatNumber(littleEndian(smartLog, 64, 8)), width);
+    info += keyValue("Host Write Commands", formatNumber(littleEndian(smartLog, 80, 8)), width);
+    info += keyValue("Controller Busy Time", formatNumber(littleEndian(smartLog, 96, 8)), width);
+    info += keyValue("Power Cycles", formatNumber(littleEndian(smartLog, 112, 8)), width);
+    info += keyValue("Power On Hours", formatNumber(littleEndian(smartLog, 128, 8)), width);
+    info += keyValue("Unsafe Shutdowns", formatNumber(littleEndian(smartLog, 144, 8)), width);
+    info += keyValue("Media and Data Integrity Errors", formatNumber(littleEndian(smartLog, 160, 8)), width);
+    info += keyValue("Error Information Log Entries", formatNumber(littleEndian(smartLog, 176, 8)), width);
+    return info;
+}
+
+QString SmartInfo::formatScsi(const QByteArray &inquiry, const QByteArray &capacity, const QByteArray &serial, const QByteArray &characteristics)
+{
+    if (inquiry.size() < 36)
+        return QString();
+
+    const int width = 22;
+    QString info("=== START OF INFORMATION SECTION ===\n");
+    info += keyValue("Vendor", asciiString(inquiry, 8, 8), width);
+    info += keyValue("Product", asciiString(inquiry, 16, 16), width);
+    QString revision = asciiString(inquiry, 32, 4);
+    if (!revision.isEmpty())
+        info += keyValue("Revision", revision, width);
+
+    // READ CAPACITY(16): 最后一个 LBA(8)、块大小(4)、第13字节低4位为物理块指数
+    if (capacity.size() >= 12) {
+        quint64 blockSize = bigEndian(capacity, 8, 4);
+        quint64 bytes = (bigEndian(capacity, 0, 8) + 1) * blockSize;
+        if (blockSize) {
+            info += keyValue("User Capacity", formatNumber(bytes) + " bytes [" + formatCapacity(bytes) + "]", width);
+            info += keyValue("Logical block size", QString("%1 bytes").arg(blockSize), width);
+            int exponent = capacity.size() > 13 ? static_cast<uchar>(capacity[13]) & 0xf : 0;
+            if (exponent)
+                info += keyValue("Physical block size", QString("%1 bytes").arg(blockSize << exponent), width);
+        }
+    }
+
+    if (characteristics.size() >= 6) {
+        QString rate = rotationRate(static_cast<quint16>(bigEndian(characteristics, 4, 2)));
+        if (!rate.isEmpty())
+            info += keyValue("Rotation Rate", rate, width);
+    }
+
+    if (serial.size() > 4) {
+        int length = qMin(static_cast<int>(bigEndian(serial, 2, 2)), serial.size() - 4);
+        QString str = asciiString(serial, 4, length);
+        if (!str.isEmpty())
+            info += keyValue("Serial number", str, width);
+    }
+
+    QString type = scsiDeviceType(static_cast<uchar>(inquiry[0]) & 0x1f);
+    if (!type.isEmpty())
+        info += keyValue("Device type", type, width);
+    return info;
+}
+
+QString SmartInfo::formatNumber(quint64 value)
+{
+    QString str = QString::number(value);
+    for (int i = str.size() - 3; i > 0; i -= 3)
+        str.insert(i, ',');
+    return str;
+}
+
+QString SmartInfo::formatCapacity(quint64 bytes)
+{
+    static const char prefixes[] = " KMGTP";
+    const quint64 factor = 1000;
+
+    // 找到 d，使 bytes 位于 [d, d * factor)
+    int i = 0;
+    quint64 d = 1;
+    for (quint64 d2 = d * factor; bytes >= d2; d2 *= factor) {
+        d = d2;
+        if (++i >= static_cast<int>(sizeof(prefixes)) - 2)
+            break;
+    }
+
+    quint64 n = bytes / d;
+    if (0 == i)
+        return QString("%1 B").arg(n);
+    if (n >= 100)
+        return QString("%1 %2B").arg(n).arg(prefixes[i]);
+    if (n >= 10)
+        return QString("%1.%2 %3B").arg(n).arg((bytes % d) * 10 / d).arg(prefixes[i]);
+    return QString("%1.%2 %3B").arg(n).arg((bytes % d) * 100 / d, 2, 10, QChar('0')).arg(prefixes[i]);
+}
+
+bool SmartInfo::readAta(int fd, QString &info)
+{
+    unsigned char cdb[16];
+    QByteArray identify(ATA_SECTOR_SIZE, 0);
+    ataPassThrough(cdb, 0xec, 0);   // IDENTIFY DEVICE
+    if (!scsiCommand(fd, cdb, sizeof(cdb), identify) || identify.size() < ATA_SECTOR_SIZE)
+        return false;
+
+    // word 0 第15位为1表示不是ATA设备，SCSI 转换层不支持时可能返回全0
+    if ((ataWord(identify, 0) & 0x8000) || ataString(identify, 27, 20).isEmpty())
+        return false;
+
+    QByteArray smartData;
+    QByteArray thresholds;
+    if ((ataWord(identify, 82) & 0x0001) && (ataWord(identify, 85) & 0x0001)) {
+        smartData.fill(0, ATA_SECTOR_SIZE);
+        ataPassThrough(cdb, 0xb0, 0xd0);    // SMART READ DATA
+        if (!scsiCommand(fd, cdb, sizeof(cdb), smartData) || smartData.size() < ATA_SECTOR_SIZE)
+            smartData.clear();
+
+        // 最后一个字节为校验和，512字节之和为0
+        uchar sum = 0;
+        for (int i = 0; i < smartData.size(); ++i)
+            sum += static_cast<uchar>(smartData[i]);
+        if (sum) {
+            qCWarning(appLog) << "SMART data checksum error";
+            smartData.clear();
+        }
+
+        if (!smartData.isEmpty()) {
+            thresholds.fill(0, ATA_SECTOR_SIZE);
+            ataPassThrough(cdb, 0xb0, 0xd1);    // SMART READ THRESHOLDS
+            if (!scsiCommand(fd, cdb, sizeof(cdb), thresholds))
+                thresholds.clear();
+        }
+    }
+
+    info = formatAta(identify, smartData, thresholds);
+    return true;
+}
+
+bool SmartInfo::readNvme(int fd, QString &info)
+{
+    QByteArray controller(NVME_IDENTIFY_SIZE, 0);
+    struct nvme_admin_cmd cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.opcode = 0x06;      // Identify
+    cmd.addr = reinterpret_cast<quintptr>(controller.data());
+    cmd.data_len = NVME_IDENTIFY_SIZE;
+    cmd.cdw10 = 1;          // CNS 1: controller
+    cmd.timeout_ms = SG_IO_TIMEOUT;
+    if (ioctl(fd, NVME_IOCTL_ADMIN_CMD, &cmd) != 0) {
+        qCWarning(appLog) << "NVMe identify controller failed";
+        return false;
+    }
+
+    // 字符设备 /dev/nvme0 没有命名空间编号，默认使用1
+    int id = ioctl(fd, NVME_IOCTL_ID);
+    quint32 nsid = id > 0 ? static_cast<quint32>(id) : 1;
+
+    QByteArray nameSpace(NVME_IDENTIFY_SIZE, 0);
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.opcode = 0x06;
+    cmd.nsid = nsid;
+    cmd.addr = reinterpret_cast<quintptr>(nameSpace.data());
+    cmd.data_len = NVME_IDENTIFY_SIZE;
+    cmd.cdw10 = 0;          // CNS 0: namespace
+    cmd.timeout_ms = SG_IO_TIMEOUT;
+    if (ioctl(fd, NVME_IOCTL_ADMIN_CMD, &cmd) != 0)
+        nameSpace.clear();
+
+    QByteArray smartLog(NVME_SMART_LOG_SIZE, 0);
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.opcode = 0x02;      // Get Log Page
+    cmd.nsid = 0xffffffff;
+    cmd.addr = reinterpret_cast<quintptr>(smartLog.data());
+    cmd.data_len = NVME_SMART_LOG_SIZE;
+    cmd.cdw10 = 0x02 | ((NVME_SMART_LOG_SIZE / 4 - 1) << 16);  // SMART/Health，长度以双字计，从0开始
+    cmd.timeout_ms = SG_IO_TIMEOUT;
+    if (ioctl(fd, NVME_IOCTL_ADMIN_CMD, &cmd) != 0)
+        smartLog.clear();
+
+    info = formatNvme(controller, nameSpace, nsid, smartLog);
+    return true;
+}
+
+bool SmartInfo::readScsi(int fd, QString &info)
+{
+    QByteArray inquiry(96, 0);
+    const unsigned char inquiryCdb[6] = {0x12, 0, 0, 0, 96, 0};
+    if (!scsiCommand(fd, inquiryCdb, sizeof(inquiryCdb), inquiry) || inquiry.size() < 36)
+        return false;
+
+    QByteArray capacity(32, 0);
+    const unsigned char capacity16Cdb[16] = {0x9e, 0x10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32, 0, 0};
+    if (!scsiCommand(fd, capacity16Cdb, sizeof(capacity16Cdb), capacity)) {
+        // 不支持 READ CAPACITY(16) 时转换 READ CAPACITY(10) 的结果
+        QByteArray capacity10(8, 0);
+        const unsigned char capacity10Cdb[10] = {0x25, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        capacity.clear();
+        if (scsiCommand(fd, capacity10Cdb, sizeof(capacity10Cdb), capacity10) && capacity10.size() >= 8)
+            capacity = QByteArray(4, 0) + capacity10.left(8);
+    }
+
+    QByteArray serial(252, 0);
+    const unsigned char serialCdb[6] = {0x12, 0x01, 0x80, 0, 252, 0};
+    if (!scsiCommand(fd, serialCdb, sizeof(serialCdb), serial))
+        serial.clear();
+
+    QByteArray characteristics(64, 0);
+    const unsigned char characteristicsCdb[6] = {0x12, 0x01, 0xb1, 0, 64, 0};
+    if (!scsiCommand(fd, characteristicsCdb, sizeof(characteristicsCdb), characteristics))
+        characteristics.clear();
+
+    info = formatScsi(inquiry, capacity, serial, characteristics);
+    return true;
+}
+
+bool SmartInfo::scsiCommand(int fd, const unsigned char *cdb, int cdbLength, QByteArray &data)
+{
+    unsigned char sense[32];
+    sg_io_hdr_t io;
+    memset(&io, 0, sizeof(io));
+    memset(sense, 0, sizeof(sense));
+    io.interface_id = 'S';
+    io.cmd_len = static_cast<unsigned char>(cdbLength);
+    io.cmdp = const_cast<unsigned char *>(cdb);
+    io.dxfer_direction = SG_DXFER_FROM_DEV;
+    io.dxfer_len = static_cast<unsigned int>(data.size());
+    io.dxferp = data.data();
+    io.mx_sb_len = sizeof(sense);
+    io.sbp = sense;
+    io.timeout = SG_IO_TIMEOUT;
+
+    if (ioctl(fd, SG_IO, &io) < 0)
+        return false;
+
+    if ((io.info & SG_INFO_OK_MASK) != SG_INFO_OK) {
+        if (io.host_status != 0 || io.masked_status != CHECK_CONDITION || io.sb_len_wr < 3)
+            return false;
+        // 描述符格式与固定格式的 sense key 位置不同，只接受 NO SENSE 和 RECOVERED ERROR
+        int responseCode = sense[0] & 0x7f;
+        int senseKey = (responseCode >= 0x72) ? (sense[1] & 0xf) : (sense[2] & 0xf);
+        if (senseKey > 1)
+            return false;
+    }
+
+    data.resize(data.size() - qMax(io.resid, 0));
+    return true;
+}
+
+bool SmartInfo::isUsbDevice(const QString &name)
+{
+    QString path = name.startsWith("sg") ? "/sys/class/scsi_generic/" + name : "/sys/class/block/" + name;
+    return QFileInfo(path).canonicalFilePath().contains("/usb");
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SMARTINFO_H
+#define SMARTINFO_H
+
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @brief SmartInfo 通过内核 ioctl 直接读取硬盘的 identify 和 SMART 数据
+ * 输出与 smartctl --all 相同格式的文本，客户端的 getMapInfoFromSmartctl 无需修改
+ * SATA 硬盘使用 ATA PASS-THROUGH，NVMe 使用 admin 命令，其它 SCSI 设备使用 INQUIRY
+ */
+class SmartInfo
+{
+public:
+    /**
+     * @brief read 读取 /dev 下设备的信息
+     * @param name 设备名，如 sda、nvme0n1、sg0
+     * @param info 输出 smartctl 格式的信息
+     * @return 读取失败返回false，此时调用者应回退到 smartctl
+     */
+    static bool read(const QString &name, QString &info);
+
+    /**
+     * @brief formatAta 将 ATA IDENTIFY DEVICE 及 SMART 数据格式化为 smartctl 格式
+     * @param identify IDENTIFY DEVICE 返回的512字节
+     * @param smartData SMART READ DATA 返回的512字节，为空时不输出属性表
+     * @param thresholds SMART READ THRESHOLDS 返回的512字节，可以为空
+     * @return
+     */
+    static QString formatAta(const QByteArray &identify, const QByteArray &smartData, const QByteArray &thresholds);
+
+    /**
+     * @brief formatNvme 将 NVMe identify 及 SMART/Health 日志格式化为 smartctl 格式
+     * @param controller Identify Controller 返回的4096字节
+     * @param nameSpace Identify Namespace 返回的4096字节，可以为空
+     * @param nsid 命名空间编号
+     * @param smartLog 日志页 0x02 返回的512字节，可以为空
+     * @return
+     */
+    static QString formatNvme(const QByteArray &controller, const QByteArray &nameSpace, quint32 nsid, const QByteArray &smartLog);
+
+    /**
+     * @brief formatScsi 将 SCSI INQUIRY 等数据格式化为 smartctl 格式
+     * @param inquiry 标准 INQUIRY 数据
+     * @param capacity READ CAPACITY(16) 格式的容量数据，可以为空
+     * @param serial VPD 0x80 页，可以为空
+     * @param characteristics VPD 0xB1 页，可以为空
+     * @return
+     */
+    static QString formatScsi(const QByteArray &inquiry, const QByteArray &capacity, const QByteArray &serial, const QByteArray &characteristics);
+
+    /**
+     * @brief formatNumber 千位分隔的数字，如 500,107,862,016
+     */
+    static QString formatNumber(quint64 value);
+
+    /**
+     * @brief formatCapacity 三位有效数字的容量，如 500 GB、1.00 TB
+     */
+    static QString formatCapacity(quint64 bytes);
+
+private:
+    /**
+     * @brief readAta 通过 SG_IO 发送 ATA PASS-THROUGH(16)
+     */
+    static bool readAta(int fd, QString &info);
+
+    /**
+     * @brief readNvme 通过 NVME_IOCTL_ADMIN_CMD 读取
+     */
+    static bool readNvme(int fd, QString &info);
+
+    /**
+     * @brief readScsi 通过 SG_IO 发送 INQUIRY 和 READ CAPACITY
+     */
+    static bool readScsi(int fd, QString &info);
+
+    /**
+     * @brief scsiCommand 发送一条读数据的 SCSI 命令
+     * @param fd 设备
+     * @param cdb 命令
+     * @param cdbLength 命令长度
+     * @param data 输入为期望长度，输出为读到的数据
+     * @return
+     */
+    static bool scsiCommand(int fd, const unsigned char *cdb, int cdbLength, QByteArray &data);
+
+    /**
+     * @brief isUsbDevice 设备是否挂在usb总线上，usb桥不支持 ATA 命令时交给 smartctl 处理
+     */
+    static bool isUsbDevice(const QString &name);
+};
+
+#endif // SMARTINFO_H
@@ -28,45 +28,94 @@ ThreadPool::ThreadPool(QObject *parent)
 void ThreadPool::loadDeviceInfo()
 {
     qCDebug(appLog) << "Loading device info, command count:" << m_ListCmd.size();
-    
+
     // 根据m_ListCmd生成所有设备信息
-    QList<Cmd>::iterator it = m_ListCmd.begin();
-    for (; it != m_ListCmd.end(); ++it) {
-        qCDebug(appLog) << "Starting task for cmd:" << (*it).cmd;
-        ThreadPoolTask *task = new ThreadPoolTask((*it).cmd, (*it).file, (*it).canNotReplace, (*it).waitingTime);
-        task->setAutoDelete(true);
-        start(task);
-    }
+    startBatch(m_ListCmd);
+}
+
+void ThreadPool::updateDeviceInfo()
+{
+    qCDebug(appLog) << "Updating device info, command count:" << m_ListUpdate.size();
 
-    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
-    // 这里是为了确保其它设备在最后一个生成
+    // 根据m_ListUpdate更新设备信息
+    startBatch(m_ListUpdate);
+}
+
+bool ThreadPool::waitForBatch(unsigned long msecs)
+{
+    QMutexLocker locker(&m_BatchMutex);
     qint64 beginMSecond = QDateTime::currentMSecsSinceEpoch();
-    while (true) {
-        qint64 curMSecond = QDateTime::currentMSecsSinceEpoch();
-        if (activeThreadCount() == 0 || curMSecond - beginMSecond > 10000) {
-            break;
+    while (!m_PendingKeys.isEmpty()) {
+        qint64 elapsed = QDateTime::currentMSecsSinceEpoch() - beginMSecond;
+        if (elapsed >= static_cast<qint64>(msecs)) {
+            qCWarning(appLog) << "Wait for batch timeout, unfinished:" << m_PendingKeys;
+            return false;
         }
+
+        // 由最后一个结束的任务唤醒
+        m_BatchFinished.wait(&m_BatchMutex, msecs - static_cast<unsigned long>(elapsed));
     }
+    return true;
 }
 
-void ThreadPool::updateDeviceInfo()
+bool ThreadPool::isBatchRunning()
 {
-    // 根据m_ListCmd生成所有设备信息
-    QList<Cmd>::iterator it = m_ListUpdate.begin();
-    for (; it != m_ListUpdate.end(); ++it) {
+    QMutexLocker locker(&m_BatchMutex);
+    return !m_PendingKeys.isEmpty();
+}
+
+bool ThreadPool::isInfoPending(const QString &key)
+{
+    QMutexLocker locker(&m_BatchMutex);
+    if (m_PendingKeys.contains(key))
+        return true;
+
+    // 以下信息由其它命令的任务附带生成
+    if (key.startsWith("smartctl_"))
+        return m_PendingKeys.contains("lsblk_d") || m_PendingKeys.contains("ls_sg");
+    if ("lspci_vs" == key)
+        return m_PendingKeys.contains("lspci");
+    if ("lscpu_num" == key)
+        return m_PendingKeys.contains("lscpu");
+    return false;
+}
+
+void ThreadPool::slotTaskFinished(const QString &key)
+{
+    bool finishedAll = false;
+    {
+        QMutexLocker locker(&m_BatchMutex);
+        m_PendingKeys.remove(key);
+        finishedAll = m_PendingKeys.isEmpty();
+        if (finishedAll)
+            m_BatchFinished.wakeAll();
+    }
+
+    qCDebug(appLog) << "Task finished, key:" << key;
+    emit cmdFinished(key);
+    if (finishedAll) {
+        qCDebug(appLog) << "All tasks of the batch finished";
+        emit batchFinished();
+    }
+}
+
+void ThreadPool::startBatch(const QList<Cmd> &cmds)
+{
+    {
+        QMutexLocker locker(&m_BatchMutex);
+        foreach (const Cmd &cmd, cmds)
+            m_PendingKeys.insert(QString(cmd.file).replace(".txt", ""));
+    }
+
+    QList<Cmd>::const_iterator it = cmds.begin();
+    for (; it != cmds.end(); ++it) {
+        qCDebug(appLog) << "Starting task for cmd:" << (*it).cmd;
         ThreadPoolTask *task = new ThreadPoolTask((*it).cmd, (*it).file, (*it).canNotReplace, (*it).waitingTime);
         task->setAutoDelete(true);
+        // 在任务线程中直接计数，不依赖事件循环
+        connect(task, &ThreadPoolTask::finished, this, &ThreadPool::slotTaskFinished, Qt::DirectConnection);
         start(task);
     }
-    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
-    // 这里是为了确保其它设备在最后一个生成
-    qint64 beginMSecond = QDateTime::currentMSecsSinceEpoch();
-    while (true) {
-        qint64 curMSecond = QDateTime::currentMSecsSinceEpoch();
-        if (activeThreadCount() == 0 || curMSecond - beginMSecond > 10000) {
-            break;
-        }
-    }
 }
 
 void ThreadPool::runCmdToCache(const Cmd &cmd)
@@ -9,6 +9,9 @@
 #include <QThreadPool>
 #include <QList>
 #include <QVector>
+#include <QSet>
+#include <QMutex>
+#include <QWaitCondition>
 
 /**
  * @brief The Cmd struct
@@ -33,16 +36,61 @@ public:
     explicit ThreadPool(QObject *parent = nullptr);
 
     /**
-     * @brief generateDeviceFile : load device info
+     * @brief generateDeviceFile : load device info, return after all tasks started
      */
     void loadDeviceInfo();
 
     /**
-     * @brief updateDeviceFile
+     * @brief updateDeviceFile : update device info, return after all tasks started
      */
     void updateDeviceInfo();
 
+    /**
+     * @brief waitForBatch : sleep until all tasks of current batch finished
+     * @param msecs : timeout
+     * @return true if the batch finished before timeout
+     */
+    bool waitForBatch(unsigned long msecs);
+
+    /**
+     * @brief isBatchRunning
+     * @return true if some tasks of current batch are not finished
+     */
+    bool isBatchRunning();
+
+    /**
+     * @brief isInfoPending : whether the info of the key is being loaded by current batch
+     * @param key : the key of DeviceInfoManager
+     * @return
+     */
+    bool isInfoPending(const QString &key);
+
+signals:
+    /**
+     * @brief cmdFinished : the info of the cmd has been added to cache, emitted in task thread
+     * @param key : the key of DeviceInfoManager
+     */
+    void cmdFinished(const QString &key);
+
+    /**
+     * @brief batchFinished : all tasks of current batch finished, emitted in task thread
+     */
+    void batchFinished();
+
+private slots:
+    /**
+     * @brief slotTaskFinished : called directly in task thread
+     * @param key
+     */
+    void slotTaskFinished(const QString &key);
+
 private:
+    /**
+     * @brief startBatch : start a task for every cmd
+     * @param cmds
+     */
+    void startBatch(const QList<Cmd> &cmds);
+
     /**
      * @brief runCmdToCache
      * @param cmd
@@ -57,6 +105,9 @@ private:
 private:
     QList<Cmd>        m_ListCmd;             // all cmd
     QList<Cmd>        m_ListUpdate;          // update cmd
+    QSet<QString>     m_PendingKeys;         // keys of unfinished tasks
+    QMutex            m_BatchMutex;          // protect m_PendingKeys
+    QWaitCondition    m_BatchFinished;       // wake up the waiter of the batch
 };
 
 #endif // THREADPOOL_H
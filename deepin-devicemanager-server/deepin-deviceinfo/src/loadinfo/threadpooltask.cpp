@@ -5,6 +5,8 @@
 #include "threadpooltask.h"
 #include "deviceinfomanager.h"
 #include "cpu/cpuinfo.h"
+#include "smart/smartinfo.h"
+#include "bluez/bluezinfo.h"
 #include "DDLog.h"
 using namespace DDLog;
 
@@ -37,10 +39,11 @@ void ThreadPoolTask::run()
     if (m_Cmd == "lscpu") {
         qCDebug(appLog) << "Loading CPU info";
         loadCpuInfo();
-        return;
+    } else {
+        runCmdToCache(m_Cmd);
     }
-    runCmdToCache(m_Cmd);
     qCDebug(appLog) << "Finished running task for cmd:" << m_Cmd;
+    emit finished(QString(m_File).replace(".txt", ""));
 }
 
 void ThreadPoolTask::runCmd(const QString &cmd)
@@ -177,9 +180,10 @@ void ThreadPoolTask::runCmdToCache(const QString &cmd)
         return;
     }
 
-    // 2. 执行命令获取设备信息
+    // 2. 执行命令获取设备信息，蓝牙配对设备优先通过 BlueZ 的 dbus 接口获取
     QString info;
-    runCmd(cmd, info);
+    if (m_File != "bt_device.txt" || !BluezInfo::pairedDevices(info))
+        runCmd(cmd, info);
     // 3. 管理设备信息
     // 如果命令是 lsblk  , 则需要执行 smartctl --all /dev/***命令
     if (m_File == "lsblk_d.txt") {
@@ -213,13 +217,16 @@ void ThreadPoolTask::loadSmartCtlInfoToCache(const QString &info)
             continue;
         }
 
-        QString smartCmd = QString("smartctl --all /dev/%1").arg(words[0].trimmed());
+        // 优先通过 ioctl 直接读取，失败时才启动 smartctl
         QString sInfo;
-        runCmd(smartCmd, sInfo);
-        // 在使用smartctl的时候会出现对 /dev/sda 出现判断错误的情况，此时可以对/dev/sda1进行处理
-        if (sInfo.contains("Read Device Identity failed:")) {
-            smartCmd = smartCmd + "1";
+        if (!SmartInfo::read(words[0].trimmed(), sInfo)) {
+            QString smartCmd = QString("smartctl --all /dev/%1").arg(words[0].trimmed());
             runCmd(smartCmd, sInfo);
+            // 在使用smartctl的时候会出现对 /dev/sda 出现判断错误的情况，此时可以对/dev/sda1进行处理
+            if (sInfo.contains("Read Device Identity failed:")) {
+                smartCmd = smartCmd + "1";
+                runCmd(smartCmd, sInfo);
+            }
         }
         DeviceInfoManager::getInstance()->addInfo(QString("smartctl_%1").arg(words[0].trimmed()), sInfo);
     }
@@ -252,9 +259,11 @@ void ThreadPoolTask::loadSgSmartCtlInfoToCache(const QString &info)
 
         QStringList words = line.split("/");
 
-        QString smartCmd = QString("smartctl --all /dev/%1").arg(words[2].trimmed());
         QString sInfo;
-        runCmd(smartCmd, sInfo);
+        if (!SmartInfo::read(words[2].trimmed(), sInfo)) {
+            QString smartCmd = QString("smartctl --all /dev/%1").arg(words[2].trimmed());
+            runCmd(smartCmd, sInfo);
+        }
         DeviceInfoManager::getInstance()->addInfo(QString("smartctl_%1").arg(words[2]), sInfo);
     }
 }
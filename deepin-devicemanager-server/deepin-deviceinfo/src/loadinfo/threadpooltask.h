@@ -25,8 +25,9 @@ public:
 signals:
     /**
      * @brief finished : finish task
+     * @param key : the key of DeviceInfoManager
      */
-    void finished();
+    void finished(const QString &key);
 
 protected:
     void run() override;
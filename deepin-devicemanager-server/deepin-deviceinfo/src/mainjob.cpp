@@ -34,6 +34,9 @@ MainJob::MainJob(const char *name, QObject *parent)
 {
     qCDebug(appLog) << "Initializing MainJob with name:" << name;
     m_deviceInterface = new DeviceInterface(name, this);
+    // 每个命令结束后立即回复等待该信息的DBus调用
+    connect(m_pool, &ThreadPool::cmdFinished, m_deviceInterface, &DeviceInterface::slotInfoReady, Qt::QueuedConnection);
+    connect(m_pool, &ThreadPool::batchFinished, this, &MainJob::slotBatchFinished, Qt::QueuedConnection);
     // 守护进程启动的时候加载所有信息
     updateAllDevice();
 
@@ -168,7 +171,15 @@ void MainJob::initDriverRepoSource()
 void MainJob::updateAllDevice()
 {
     qCDebug(appLog) << "Start updating device information, firstUpdate:" << m_firstUpdate;
+    // 上一轮加载尚未结束，结束后再更新一次
+    if (m_pool->isBatchRunning()) {
+        qCDebug(appLog) << "Device info is loading, update again after finished";
+        m_updateAgain = true;
+        return;
+    }
+
     PERF_PRINT_BEGIN("POINT-01", "MainJob::updateAllDevice()");
+    // 只启动任务，信息在各自命令结束时即可通过DBus获取
     if (m_firstUpdate) {
         qCDebug(appLog) << "Loading device info for the first time";
         m_pool->loadDeviceInfo();
@@ -176,11 +187,24 @@ void MainJob::updateAllDevice()
         qCDebug(appLog) << "Updating existing device info";
         m_pool->updateDeviceInfo();
     }
-    m_pool->waitForDone(60000);
-    PERF_PRINT_END("POINT-01");
     m_firstUpdate = false;
 }
 
+void MainJob::slotBatchFinished()
+{
+    PERF_PRINT_END("POINT-01");
+    qCDebug(appLog) << "Device info loaded, update again:" << m_updateAgain;
+    if (m_updateAgain) {
+        m_updateAgain = false;
+        updateAllDevice();
+    }
+}
+
+bool MainJob::isInfoPending(const QString &key)
+{
+    return m_pool->isInfoPending(key);
+}
+
 void MainJob::executeClientInstruction(const QString &instructions)
 {
     qCDebug(appLog) << "Received client instruction:" << instructions;
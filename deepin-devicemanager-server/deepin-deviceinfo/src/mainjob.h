@@ -34,6 +34,13 @@ public:
      */
     void setWorkingFlag(bool flag);
 
+    /**
+     * @brief isInfoPending 该信息是否正在加载
+     * @param key
+     * @return
+     */
+    bool isInfoPending(const QString &key);
+
 private slots:
     /**
      * @brief slotUsbChanged
@@ -48,6 +55,10 @@ private slots:
      * @brief slotWakeupHandle
      */
     void slotWakeupHandle(bool);
+    /**
+     * @brief slotBatchFinished 一轮设备信息加载结束
+     */
+    void slotBatchFinished();
 private:
     /**
      * @brief sqlCopytoKernel
@@ -79,6 +90,7 @@ private:
 private:
     ThreadPool            *m_pool = nullptr;                  //<! 生成文件的线程池
     bool                   m_firstUpdate;                      //<! 是否是第一次更新
+    bool                   m_updateAgain = false;              //<! 加载过程中收到更新请求，结束后再更新一次
     DeviceInterface       *m_deviceInterface = nullptr;        //<! 设备信息
     DetectThread          *mp_DetectThread = nullptr;         //<! 检测usb的线程
 };
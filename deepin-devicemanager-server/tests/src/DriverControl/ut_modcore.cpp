@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DISABLE_DRIVER
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "../stub.h"
+#include "modcore.h"
+
+static int s_LoadCount = 0;
+static int s_ValidateResult = KMOD_RESOURCES_OK;
+
+// 每创建一个上下文加载一次索引
+int ut_modcore_load_resources(struct kmod_ctx *)
+{
+    ++s_LoadCount;
+    return 0;
+}
+
+int ut_modcore_validate(struct kmod_ctx *)
+{
+    return s_ValidateResult;
+}
+
+class ModCore_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        ModCore::invalidateContext();
+        s_LoadCount = 0;
+        s_ValidateResult = KMOD_RESOURCES_OK;
+        m_core = new ModCore;
+    }
+    void TearDown()
+    {
+        delete m_core;
+        ModCore::invalidateContext();
+    }
+    ModCore *m_core = nullptr;
+};
+
+TEST_F(ModCore_UT, ModCore_UT_sharedContext)
+{
+    Stub stub;
+    stub.set(kmod_load_resources, ut_modcore_load_resources);
+    stub.set(kmod_validate_resources, ut_modcore_validate);
+
+    // 多次查询共用一个上下文
+    m_core->modGetPath("ut_not_exist_module");
+    m_core->modIsBuildIn("ut_not_exist_module");
+    m_core->modGetConfsWithType(ModCore::EBlackListConf);
+    EXPECT_EQ(1, s_LoadCount);
+
+    // 模块索引变化后重新创建
+    s_ValidateResult = KMOD_RESOURCES_MUST_RELOAD;
+    m_core->modGetPath("ut_not_exist_module");
+    EXPECT_EQ(2, s_LoadCount);
+
+    // depmod 后主动丢弃
+    s_ValidateResult = KMOD_RESOURCES_OK;
+    ModCore::invalidateContext();
+    m_core->modGetPath("ut_not_exist_module");
+    EXPECT_EQ(3, s_LoadCount);
+}
+
+#endif // DISABLE_DRIVER
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "../stub.h"
+#include "enablesqlmanager.h"
+
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+// 构造时不打开系统数据库
+void ut_enablesql_initDB()
+{
+}
+
+bool ut_enablesql_commitFailed()
+{
+    return false;
+}
+
+class EnableSqlManager_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        {
+            Stub stub;
+            stub.set(ADDR(EnableSqlManager, initDB), ut_enablesql_initDB);
+            m_Manager = new EnableSqlManager;
+        }
+        m_Manager->initDB(m_Dir.path() + "/enable.db");
+    }
+    void TearDown()
+    {
+        m_Manager->m_Statements.clear();
+        m_Manager->m_sqlQuery = QSqlQuery();
+        m_Manager->m_db.close();
+        m_Manager->m_db = QSqlDatabase();
+        delete m_Manager;
+        QSqlDatabase::removeDatabase("device-enable");
+    }
+
+    // 直接查询数据库中的记录数
+    int rowCount(const QString &sql)
+    {
+        QSqlQuery query(m_Manager->m_db);
+        if (query.exec(sql) && query.next())
+            return query.value(0).toInt();
+        return -1;
+    }
+
+    QTemporaryDir m_Dir;
+    EnableSqlManager *m_Manager = nullptr;
+};
+
+TEST_F(EnableSqlManager_UT, EnableSqlManager_UT_loadIndex)
+{
+    QSqlQuery query(m_Manager->m_db);
+    ASSERT_TRUE(query.exec("INSERT INTO authorized (class, name, path, unique_id, exist, driver) VALUES ('usb', 'mouse', '/devices/usb1/1-1', 'id1', 1, '');"));
+    ASSERT_TRUE(query.exec("INSERT INTO authorized (class, name, path, unique_id, exist, driver) VALUES ('usb', 'mouse', '/devices/usb1/1-2', 'id1', 1, '');"));
+    ASSERT_TRUE(query.exec("INSERT INTO remove (class, name, path, unique_id, driver) VALUES ('pci', 'audio', '/devices/pci0000:00/0000:00:1f.3', 'id2', '');"));
+    ASSERT_TRUE(query.exec("INSERT INTO wake (unique_id, path, wakeup) VALUES ('id3', '/devices/usb1/1-3', 1);"));
+    ASSERT_TRUE(query.exec("INSERT INTO monitor_dev (monitor_name, working_flag) VALUES ('usb', 0);"));
+    m_Manager->loadIndex();
+
+    // 与 SELECT 相同，返回最早插入的记录
+    EXPECT_EQ("/devices/usb1/1-1", m_Manager->authorizedPath("id1"));
+    EXPECT_TRUE(m_Manager->uniqueIDExisted("id1", "/devices/usb1/1-2"));
+    EXPECT_FALSE(m_Manager->uniqueIDExisted("id1", "/devices/usb1/1-9"));
+
+    QStringList lstPath;
+    m_Manager->removePathList(lstPath);
+    EXPECT_EQ(QStringList() << "/devices/pci0000:00/0000:00:1f.3", lstPath);
+
+    EXPECT_TRUE(m_Manager->isWakeupUniqueIdExisted("id3"));
+    EXPECT_TRUE(m_Manager->isWakeup("id3"));
+    EXPECT_FALSE(m_Manager->monitorWorkingFlag());
+}
+
+TEST_F(EnableSqlManager_UT, EnableSqlManager_UT_writeThrough)
+{
+    m_Manager->insertDataToAuthorizedTable("usb", "mouse", "/devices/usb1/1-1", "id1", true);
+    EXPECT_TRUE(m_Manager->uniqueIDExisted("id1"));
+    EXPECT_EQ(1, rowCount("SELECT COUNT(*) FROM authorized WHERE unique_id='id1';"));
+
+    m_Manager->updateDataToAuthorizedTable("id1", "/devices/usb1/1-2");
+    EXPECT_EQ("/devices/usb1/1-2", m_Manager->authorizedPath("id1"));
+    EXPECT_EQ(1, rowCount("SELECT COUNT(*) FROM authorized WHERE path='/devices/usb1/1-2';"));
+
+    m_Manager->removeDataFromAuthorizedTable("id1");
+    EXPECT_FALSE(m_Manager->uniqueIDExisted("id1"));
+    EXPECT_EQ(0, rowCount("SELECT COUNT(*) FROM authorized;"));
+
+    m_Manager->insertNetworkWakeup("enp2s0", true);
+    m_Manager->insertNetworkWakeup("enp2s0", false);
+    EXPECT_FALSE(m_Manager->isNetworkWakeup("enp2s0"));
+    EXPECT_EQ(1, rowCount("SELECT COUNT(*) FROM net_wake;"));
+}
+
+TEST_F(EnableSqlManager_UT, EnableSqlManager_UT_statementCache)
+{
+    // 同一条 sql 只预编译一次
+    for (int i = 0; i < 5; ++i)
+        m_Manager->insertDataToRemoveTable("pci", "audio", QString("/devices/pci/%1").arg(i), QString("id%1").arg(i));
+    EXPECT_EQ(1, m_Manager->m_Statements.size());
+    EXPECT_EQ(5, rowCount("SELECT COUNT(*) FROM remove;"));
+
+    m_Manager->removeDateFromRemoveTable("/devices/pci/0");
+    m_Manager->removeDateFromRemoveTable("/devices/pci/1");
+    EXPECT_EQ(2, m_Manager->m_Statements.size());
+    EXPECT_EQ(3, rowCount("SELECT COUNT(*) FROM remove;"));
+}
+
+TEST_F(EnableSqlManager_UT, EnableSqlManager_UT_transaction)
+{
+    // 嵌套时只有最外层提交
+    m_Manager->beginTransaction();
+    m_Manager->beginTransaction();
+    m_Manager->insertDataToAuthorizedTable("usb", "mouse", "/devices/usb1/1-1", "id1", true);
+    EXPECT_TRUE(m_Manager->commitTransaction());
+    EXPECT_EQ(1, m_Manager->m_TransactionLevel);
+    m_Manager->insertDataToAuthorizedTable("usb", "keyboard", "/devices/usb1/1-2", "id2", true);
+    EXPECT_TRUE(m_Manager->commitTransaction());
+    EXPECT_EQ(0, m_Manager->m_TransactionLevel);
+
+    EXPECT_EQ(2, rowCount("SELECT COUNT(*) FROM authorized;"));
+    EXPECT_TRUE(m_Manager->uniqueIDExisted("id2"));
+}
+
+TEST_F(EnableSqlManager_UT, EnableSqlManager_UT_commitFailed)
+{
+    m_Manager->insertDataToAuthorizedTable("usb", "mouse", "/devices/usb1/1-1", "id1", true);
+
+    Stub stub;
+    stub.set(ADDR(QSqlDatabase, commit), ut_enablesql_commitFailed);
+
+    // 提交失败时回滚，内存索引与数据库保持一致
+    m_Manager->beginTransaction();
+    m_Manager->insertDataToAuthorizedTable("usb", "keyboard", "/devices/usb1/1-2", "id2", true);
+    m_Manager->updateDataToAuthorizedTable("id1", "/devices/usb1/1-3");
+    EXPECT_TRUE(m_Manager->uniqueIDExisted("id2"));
+    EXPECT_FALSE(m_Manager->commitTransaction());
+
+    EXPECT_FALSE(m_Manager->uniqueIDExisted("id2"));
+    EXPECT_EQ("/devices/usb1/1-1", m_Manager->authorizedPath("id1"));
+    EXPECT_EQ(1, rowCount("SELECT COUNT(*) FROM authorized;"));
+}
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "../stub.h"
+#include "bluez/bluezinfo.h"
+
+class BluezInfo_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+static QVariantMap device(const QString &address, const QString &alias, bool paired)
+{
+    QVariantMap properties;
+    properties.insert("Address", address);
+    properties.insert("Alias", alias);
+    properties.insert("Paired", paired);
+    return properties;
+}
+
+TEST_F(BluezInfo_UT, BluezInfo_UT_formatPairedDevices)
+{
+    BluezObjectMap objects;
+    objects[QDBusObjectPath("/org/bluez")]["org.bluez.AgentManager1"] = QVariantMap();
+    objects[QDBusObjectPath("/org/bluez/hci0")]["org.bluez.Adapter1"] = device("E0:D4:62:EB:4C:38", "uos-PC", false);
+    objects[QDBusObjectPath("/org/bluez/hci0/dev_D4_0E_35_6A_12_9F")]["org.bluez.Device1"] = device("D4:0E:35:6A:12:9F", "MX Master 3", true);
+    objects[QDBusObjectPath("/org/bluez/hci0/dev_00_11_22_33_44_55")]["org.bluez.Device1"] = device("00:11:22:33:44:55", "Speaker", false);
+    objects[QDBusObjectPath("/org/bluez/hci0/dev_66_77_88_99_AA_BB")]["org.bluez.Device1"] = device("66:77:88:99:AA:BB", "", true);
+
+    QString info = BluezInfo::formatPairedDevices(objects);
+    EXPECT_TRUE(info.contains("Device D4:0E:35:6A:12:9F MX Master 3\n"));
+    EXPECT_TRUE(info.contains("Device 66:77:88:99:AA:BB 66:77:88:99:AA:BB\n"));
+    EXPECT_FALSE(info.contains("Speaker"));
+    EXPECT_FALSE(info.contains("E0:D4:62:EB:4C:38"));
+    EXPECT_TRUE(BluezInfo::formatPairedDevices(BluezObjectMap()).isEmpty());
+}
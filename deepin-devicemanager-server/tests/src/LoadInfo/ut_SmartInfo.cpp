@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "../stub.h"
+#include "smart/smartinfo.h"
+
+#include <QStringList>
+
+class SmartInfo_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+static void setWord(QByteArray &data, int index, quint16 value)
+{
+    data[index * 2] = static_cast<char>(value & 0xff);
+    data[index * 2 + 1] = static_cast<char>(value >> 8);
+}
+
+static void setLittleEndian(QByteArray &data, int offset, quint64 value, int size)
+{
+    for (int i = 0; i < size; ++i)
+        data[offset + i] = i < 8 ? static_cast<char>((value >> (8 * i)) & 0xff) : 0;
+}
+
+// identify 字符串按字交换字节，不足部分补空格
+static void setAtaString(QByteArray &data, int firstWord, int words, const QByteArray &str)
+{
+    QByteArray padded = str.leftJustified(words * 2, ' ');
+    for (int i = 0; i < words; ++i) {
+        data[(firstWord + i) * 2] = padded[i * 2 + 1];
+        data[(firstWord + i) * 2 + 1] = padded[i * 2];
+    }
+}
+
+static void setAttribute(QByteArray &smart, QByteArray &thresholds, int index, int id, quint16 flags, int value, int worst, quint64 raw, int threshold)
+{
+    int offset = 2 + index * 12;
+    smart[offset] = static_cast<char>(id);
+    setLittleEndian(smart, offset + 1, flags, 2);
+    smart[offset + 3] = static_cast<char>(value);
+    smart[offset + 4] = static_cast<char>(worst);
+    setLittleEndian(smart, offset + 5, raw, 6);
+    thresholds[offset] = static_cast<char>(id);
+    thresholds[offset + 1] = static_cast<char>(threshold);
+}
+
+// 按 Samsung SSD 860 EVO 500GB 的 IDENTIFY DEVICE 数据构造
+static QByteArray ataIdentifyFixture()
+{
+    QByteArray identify(512, 0);
+    setWord(identify, 0, 0x0040);
+    setAtaString(identify, 10, 10, "S3Z1NB0K123456A");
+    setAtaString(identify, 23, 4, "RVT02B6Q");
+    setAtaString(identify, 27, 20, "Samsung SSD 860 EVO 500GB");
+    setWord(identify, 76, 0x000e);      // Gen1/Gen2/Gen3
+    setWord(identify, 77, 0x0006);      // 当前 6.0 Gb/s
+    setWord(identify, 82, 0x0001);      // 支持 SMART
+    setWord(identify, 83, 0x0400);      // 48位地址
+    setWord(identify, 85, 0x0001);      // SMART 已启用
+    setLittleEndian(identify, 200, 976773168ULL, 8);
+    setWord(identify, 106, 0x4000);
+    setWord(identify, 168, 0x0003);     // 2.5 inches
+    setWord(identify, 217, 0x0001);     // SSD
+    setWord(identify, 222, 0x10ff);     // SATA 3.2
+    return identify;
+}
+
+static QStringList lines(const QString &info)
+{
+    QStringList result;
+    foreach (const QString &line, info.split("\n"))
+        result.append(line.simplified());
+    return result;
+}
+
+TEST_F(SmartInfo_UT, SmartInfo_UT_formatNumber)
+{
+    EXPECT_EQ("0", SmartInfo::formatNumber(0));
+    EXPECT_EQ("999", SmartInfo::formatNumber(999));
+    EXPECT_EQ("1,000", SmartInfo::formatNumber(1000));
+    EXPECT_EQ("500,107,862,016", SmartInfo::formatNumber(500107862016ULL));
+}
+
+TEST_F(SmartInfo_UT, SmartInfo_UT_formatCapacity)
+{
+    EXPECT_EQ("512 B", SmartInfo::formatCapacity(512));
+    EXPECT_EQ("500 GB", SmartInfo::formatCapacity(500107862016ULL));
+    EXPECT_EQ("1.00 TB", SmartInfo::formatCapacity(1000204886016ULL));
+    EXPECT_EQ("64.0 GB", SmartInfo::formatCapacity(64023257088ULL));
+}
+
+TEST_F(SmartInfo_UT, SmartInfo_UT_formatAta)
+{
+    QByteArray smart(512, 0);
+    QByteArray thresholds(512, 0);
+    setAttribute(smart, thresholds, 0, 5, 0x0033, 100, 100, 0, 10);
+    setAttribute(smart, thresholds, 1, 9, 0x0032, 99, 99, 1234, 0);
+    setAttribute(smart, thresholds, 2, 12, 0x0032, 99, 99, 56, 0);
+    setAttribute(smart, thresholds, 3, 194, 0x0022, 65, 52, 0x2d00140023ULL, 0);
+
+    QStringList info = lines(SmartInfo::formatAta(ataIdentifyFixture(), smart, thresholds));
+    EXPECT_TRUE(info.contains("Device Model: Samsung SSD 860 EVO 500GB"));
+    EXPECT_TRUE(info.contains("Serial Number: S3Z1NB0K123456A"));
+    EXPECT_TRUE(info.contains("Firmware Version: RVT02B6Q"));
+    EXPECT_TRUE(info.contains("User Capacity: 500,107,862,016 bytes [500 GB]"));
+    EXPECT_TRUE(info.contains("Sector Size: 512 bytes logical/physical"));
+    EXPECT_TRUE(info.contains("Rotation Rate: Solid State Device"));
+    EXPECT_TRUE(info.contains("Form Factor: 2.5 inches"));
+    EXPECT_TRUE(info.contains("SATA Version is: SATA 3.2, 6.0 Gb/s (current: 6.0 Gb/s)"));
+    EXPECT_TRUE(info.contains("SMART support is: Enabled"));
+    EXPECT_TRUE(info.contains("5 Reallocated_Sector_Ct 0x0033 100 100 010 Pre-fail Always - 0"));
+    EXPECT_TRUE(info.contains("9 Power_On_Hours 0x0032 099 099 000 Old_age Always - 1234"));
+    EXPECT_TRUE(info.contains("12 Power_Cycle_Count 0x0032 099 099 000 Old_age Always - 56"));
+    EXPECT_TRUE(info.contains("194 Temperature_Celsius 0x0022 065 052 000 Old_age Always - 35"));
+}
+
+TEST_F(SmartInfo_UT, SmartInfo_UT_formatAta_noSmart)
+{
+    QString info = SmartInfo::formatAta(ataIdentifyFixture(), QByteArray(), QByteArray());
+    EXPECT_TRUE(info.contains("Device Model:"));
+    EXPECT_FALSE(info.contains("ATTRIBUTE_NAME"));
+    EXPECT_TRUE(SmartInfo::formatAta(QByteArray(10, 0), QByteArray(), QByteArray()).isEmpty());
+}
+
+TEST_F(SmartInfo_UT, SmartInfo_UT_formatNvme)
+{
+    QByteArray controller(4096, ' ');
+    setLittleEndian(controller, 0, 0x144d, 2);
+    setLittleEndian(controller, 2, 0x144d, 2);
+    controller.replace(4, 15, "S4EWNX0R123456K");
+    controller.replace(24, 30, "Samsung SSD 970 EVO Plus 500GB");
+    controller.replace(64, 8, "2B2QEXM7");
+    setLittleEndian(controller, 73, 0x002538, 3);
+    setLittleEndian(controller, 78, 4, 2);
+    setLittleEndian(controller, 80, 0x00010300, 4);
+    setLittleEndian(controller, 280, 500107862016ULL, 16);
+    setLittleEndian(controller, 296, 0, 16);
+    setLittleEndian(controller, 516, 1, 4);
+
+    QByteArray nameSpace(4096, 0);
+    setLittleEndian(nameSpace, 0, 976773168ULL, 8);
+    setLittleEndian(nameSpace, 8, 976773168ULL, 8);
+    setLittleEndian(nameSpace, 16, 123456789ULL, 8);
+    nameSpace[130] = 9;     // lbaf[0].lbads: 512
+
+    QByteArray smartLog(512, 0);
+    setLittleEndian(smartLog, 1, 308, 2);
+    smartLog[3] = 100;
+    smartLog[4] = 10;
+    setLittleEndian(smartLog, 32, 1234567, 16);
+    setLittleEndian(smartLog, 112, 1234, 16);
+    setLittleEndian(smartLog, 128, 5678, 16);
+
+    QStringList info = lines(SmartInfo::formatNvme(controller, nameSpace, 1, smartLog));
+    EXPECT_TRUE(info.contains("Model Number: Samsung SSD 970 EVO Plus 500GB"));
+    EXPECT_TRUE(info.contains("Serial Number: S4EWNX0R123456K"));
+    EXPECT_TRUE(info.contains("Firmware Version: 2B2QEXM7"));
+    EXPECT_TRUE(info.contains("PCI Vendor/Subsystem ID: 0x144d"));
+    EXPECT_TRUE(info.contains("IEEE OUI Identifier: 0x002538"));
+    EXPECT_TRUE(info.contains("Total NVM Capacity: 500,107,862,016 [500 GB]"));
+    EXPECT_TRUE(info.contains("Unallocated NVM Capacity: 0"));
+    EXPECT_TRUE(info.contains("NVMe Version: 1.3"));
+    EXPECT_TRUE(info.contains("Namespace 1 Size/Capacity: 500,107,862,016 [500 GB]"));
+    EXPECT_TRUE(info.contains("Namespace 1 Formatted LBA Size: 512"));
+    EXPECT_TRUE(info.contains("SMART overall-health self-assessment test result: PASSED"));
+    EXPECT_TRUE(info.contains("Temperature: 35 Celsius"));
+    EXPECT_TRUE(info.contains("Available Spare: 100%"));
+    EXPECT_TRUE(info.contains("Data Units Read: 1,234,567 [632 GB]"));
+    EXPECT_TRUE(info.contains("Power Cycles: 1,234"));
+    EXPECT_TRUE(info.contains("Power On Hours: 5,678"));
+}
+
+TEST_F(SmartInfo_UT, SmartInfo_UT_formatScsi)
+{
+    QByteArray inquiry(36, ' ');
+    inquiry[0] = 0;
+    inquiry.replace(8, 7, "SEAGATE");
+    inquiry.replace(16, 12, "ST4000NM0023");
+    inquiry.replace(32, 4, "0004");
+
+    // READ CAPACITY(16): 最后一个 LBA 与块大小为大端
+    QByteArray capacity(32, 0);
+    quint64 lastLba = 7814037167ULL;
+    for (int i = 0; i < 8; ++i)
+        capacity[i] = static_cast<char>((lastLba >> (8 * (7 - i))) & 0xff);
+    capacity[10] = 0x02;
+
+    QByteArray serial(4, 0);
+    serial[1] = static_cast<char>(0x80);
+    serial[3] = 8;
+    serial.append("Z1Z2W3X4");
+
+    QByteArray characteristics(64, 0);
+    characteristics[4] = 0x1c;
+    characteristics[5] = 0x20;      // 7200 rpm
+
+    QStringList info = lines(SmartInfo::formatScsi(inquiry, capacity, serial, characteristics));
+    EXPECT_TRUE(info.contains("Vendor: SEAGATE"));
+    EXPECT_TRUE(info.contains("Product: ST4000NM0023"));
+    EXPECT_TRUE(info.contains("Revision: 0004"));
+    EXPECT_TRUE(info.contains("User Capacity: 4,000,787,030,016 bytes [4.00 TB]"));
+    EXPECT_TRUE(info.contains("Logical block size: 512 bytes"));
+    EXPECT_TRUE(info.contains("Rotation Rate: 7200 rpm"));
+    EXPECT_TRUE(info.contains("Serial number: Z1Z2W3X4"));
+    EXPECT_TRUE(info.contains("Device type: disk"));
+}
+
+TEST_F(SmartInfo_UT, SmartInfo_UT_read)
+{
+    QString info;
+    EXPECT_FALSE(SmartInfo::read("not-exist-device", info));
+    EXPECT_TRUE(info.isEmpty());
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "../stub.h"
+#include "threadpool.h"
+
+class ThreadPool_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_pool = new ThreadPool;
+    }
+    void TearDown()
+    {
+        delete m_pool;
+    }
+    ThreadPool *m_pool = nullptr;
+};
+
+TEST_F(ThreadPool_UT, ThreadPool_UT_isInfoPending)
+{
+    m_pool->m_PendingKeys << "lsblk_d" << "lspci";
+    EXPECT_TRUE(m_pool->isBatchRunning());
+    EXPECT_TRUE(m_pool->isInfoPending("lsblk_d"));
+    EXPECT_TRUE(m_pool->isInfoPending("smartctl_sda"));
+    EXPECT_TRUE(m_pool->isInfoPending("lspci_vs"));
+    EXPECT_FALSE(m_pool->isInfoPending("lshw"));
+
+    m_pool->slotTaskFinished("lsblk_d");
+    EXPECT_FALSE(m_pool->isInfoPending("smartctl_sda"));
+    EXPECT_FALSE(m_pool->waitForBatch(10));
+
+    m_pool->slotTaskFinished("lspci");
+    EXPECT_FALSE(m_pool->isBatchRunning());
+    EXPECT_TRUE(m_pool->waitForBatch(10));
+}
@@ -4,10 +4,15 @@
 
 #include "detectthread.h"
 #include "monitorusb.h"
+#include "usbinfocollector.h"
+#include "controlinterface.h"
 #include "../ut_Head.h"
 #include <gtest/gtest.h>
 #include "../stub.h"
 
+#include <QCoreApplication>
+#include <QTimer>
+
 class DetectThread_UT : public UT_HEAD
 {
 public:
@@ -33,3 +38,78 @@ TEST_F(DetectThread_UT, DetectThread_UT_monitor)
     stub.set(ADDR(MonitorUsb, monitor), ut_monitor1);
     m_thread->run();
 }
+
+TEST_F(DetectThread_UT, DetectThread_UT_slotDeviceChanged)
+{
+    int count = 0;
+    QObject::connect(m_thread, &DetectThread::usbChanged, [&count]() { ++count; });
+
+    // 模拟udev事件，同一设备重复的add只通知一次，未知设备的remove不通知
+    m_thread->slotDeviceChanged("add", "/devices/ut/usb9/9-1");
+    m_thread->slotDeviceChanged("add", "/devices/ut/usb9/9-1");
+    m_thread->slotDeviceChanged("remove", "/devices/ut/usb9/9-2");
+    EXPECT_TRUE(m_thread->m_Changed);
+    EXPECT_TRUE(m_thread->mp_Timer->isActive());
+
+    // 合并定时器到期
+    m_thread->slotUsbChanged();
+    EXPECT_EQ(1, count);
+    EXPECT_FALSE(m_thread->m_Changed);
+    EXPECT_FALSE(m_thread->mp_Timer->isActive());
+
+    m_thread->slotDeviceChanged("remove", "/devices/ut/usb9/9-1");
+    EXPECT_TRUE(m_thread->m_Changed);
+    EXPECT_FALSE(m_thread->m_Devices.contains("/devices/ut/usb9/9-1"));
+}
+
+static int s_SpawnCount = 0;
+QString ut_hwinfoUsbInfo()
+{
+    ++s_SpawnCount;
+    return QString();
+}
+
+static bool s_CollectResult = false;
+bool ut_collect()
+{
+    return s_CollectResult;
+}
+
+void ut_controlDevice()
+{
+    return;
+}
+
+TEST_F(DetectThread_UT, DetectThread_UT_spawnCount)
+{
+    Stub stub;
+    stub.set(ADDR(MonitorUsb, hwinfoUsbInfo), ut_hwinfoUsbInfo);
+    stub.set(ADDR(UsbInfoCollector, collect), ut_collect);
+    stub.set(ADDR(ControlInterface, disableOutDevice), ut_controlDevice);
+    stub.set(ADDR(ControlInterface, updateWakeup), ut_controlDevice);
+    MonitorUsb *monitor = m_thread->mp_MonitorUsb;
+
+    // 直接采集成功时不启动hwinfo
+    s_SpawnCount = 0;
+    s_CollectResult = true;
+    monitor->handleEvent("add", "usb", "/devices/ut/usb9/9-3", nullptr);
+    EXPECT_EQ(0, s_SpawnCount);
+
+    // 直接采集失败时每个事件最多启动一次hwinfo
+    s_CollectResult = false;
+    monitor->handleEvent("add", "usb", "/devices/ut/usb9/9-4", nullptr);
+    EXPECT_EQ(1, s_SpawnCount);
+
+    // 拔出和磁盘事件不启动hwinfo
+    s_SpawnCount = 0;
+    monitor->handleEvent("remove", "usb", "/devices/ut/usb9/9-3", nullptr);
+    monitor->handleEvent("add", "block", "/devices/ut/usb9/9-4/block/sdz", nullptr);
+    EXPECT_EQ(0, s_SpawnCount);
+
+    // 事件经队列连接到达DetectThread后更新设备集合
+    QCoreApplication::processEvents();
+    EXPECT_FALSE(m_thread->m_Devices.contains("/devices/ut/usb9/9-3"));
+    EXPECT_TRUE(m_thread->m_Devices.contains("/devices/ut/usb9/9-4"));
+    EXPECT_TRUE(m_thread->m_Devices.contains("/devices/ut/usb9/9-4/block/sdz"));
+    EXPECT_TRUE(m_thread->m_Changed);
+}
@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: 2019 ~ 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "../ut_Head.h"
+#include <gtest/gtest.h>
+#include "../stub.h"
+#include "usbinfocollector.h"
+
+#include <QMap>
+#include <QStringList>
+
+class UsbInfoCollector_UT : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+TEST_F(UsbInfoCollector_UT, UsbInfoCollector_UT_formatRecord)
+{
+    UsbInfoCollector::Record record;
+    record.append(qMakePair(QString("SysFS ID"), QString("/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0")));
+    record.append(qMakePair(QString("SysFS BusID"), QString("1-2:1.0")));
+    record.append(qMakePair(QString("Hardware Class"), QString("mouse")));
+    record.append(qMakePair(QString("Hotplug"), QString("USB")));
+    record.append(qMakePair(QString("Vendor"), QString("usb 0x046d \"Logitech, Inc.\"")));
+    record.append(qMakePair(QString("Device"), QString("usb 0xc52b")));
+    record.append(qMakePair(QString("Serial ID"), QString()));
+    record.append(qMakePair(QString("Module Alias"), QString("usb:v046DpC52Bd1201dc00dsc00dp00ic03isc01ip02in00")));
+
+    QString info = UsbInfoCollector::formatRecord(0, record);
+    QStringList lines = info.split("\n");
+    EXPECT_TRUE(lines.contains("  Vendor: usb 0x046d \"Logitech, Inc.\""));
+    EXPECT_TRUE(lines.contains("  SysFS BusID: 1-2:1.0"));
+    EXPECT_FALSE(info.contains("Serial ID"));
+    EXPECT_FALSE(info.contains("\n\n"));
+}
+
+TEST_F(UsbInfoCollector_UT, UsbInfoCollector_UT_hardwareClass)
+{
+    EXPECT_EQ("keyboard", UsbInfoCollector::hardwareClass("03", "01"));
+    EXPECT_EQ("mouse", UsbInfoCollector::hardwareClass("03", "02"));
+    EXPECT_EQ("hub", UsbInfoCollector::hardwareClass("09", "00"));
+    EXPECT_EQ("bluetooth", UsbInfoCollector::hardwareClass("e0", "01"));
+    EXPECT_EQ("unknown", UsbInfoCollector::hardwareClass("", ""));
+}
+
+TEST_F(UsbInfoCollector_UT, UsbInfoCollector_UT_collect)
+{
+    QString info;
+    EXPECT_FALSE(UsbInfoCollector::collect(nullptr, info));
+    EXPECT_TRUE(info.isEmpty());
+}
+
+// 模拟一个带有单个鼠标接口的usb设备，udev对象只用作区分设备的标识
+static char s_FakeUdev;
+static char s_FakeDevice;
+static char s_FakeIntf;
+static char s_FakeEnumerate;
+static char s_FakeEntry;
+
+static struct udev_device *fakeDevice()
+{
+    return reinterpret_cast<struct udev_device *>(&s_FakeDevice);
+}
+
+static struct udev_device *fakeIntf()
+{
+    return reinterpret_cast<struct udev_device *>(&s_FakeIntf);
+}
+
+static QByteArray fakeValue(struct udev_device *dev, const char *name)
+{
+    static const QMap<QByteArray, QByteArray> s_DeviceValues {
+        { "ID_VENDOR_ID", "046D" },
+        { "ID_MODEL_ID", "C52B" },
+        { "ID_VENDOR_FROM_DATABASE", "Logitech, Inc." },
+        { "ID_MODEL_FROM_DATABASE", "Unifying Receiver" },
+        { "version", " 2.00" },
+    };
+    static const QMap<QByteArray, QByteArray> s_IntfValues {
+        { "bInterfaceClass", "03" },
+        { "bInterfaceProtocol", "02" },
+        { "MODALIAS", "usb:v046DpC52Bd1201dc00dsc00dp00ic03isc01ip02in00" },
+    };
+    return (dev == fakeDevice() ? s_DeviceValues : s_IntfValues).value(name);
+}
+
+const char *ut_udev_device_get_value(struct udev_device *dev, const char *name)
+{
+    // 返回的字符串需要在调用者使用期间有效
+    static QMap<QByteArray, QByteArray> s_Cache;
+    QByteArray key = QByteArray::number(reinterpret_cast<quintptr>(dev)) + name;
+    QByteArray value = fakeValue(dev, name);
+    if (value.isEmpty())
+        return nullptr;
+    s_Cache[key] = value;
+    return s_Cache[key].constData();
+}
+
+const char *ut_udev_device_get_devtype(struct udev_device *dev)
+{
+    return dev == fakeDevice() ? "usb_device" : "usb_interface";
+}
+
+const char *ut_udev_device_get_devpath(struct udev_device *dev)
+{
+    return dev == fakeDevice() ? "/devices/ut/usb9/9-1" : "/devices/ut/usb9/9-1/9-1:1.0";
+}
+
+const char *ut_udev_device_get_sysname(struct udev_device *dev)
+{
+    return dev == fakeDevice() ? "9-1" : "9-1:1.0";
+}
+
+const char *ut_udev_device_get_driver(struct udev_device *)
+{
+    return "usbhid";
+}
+
+struct udev *ut_udev_device_get_udev(struct udev_device *)
+{
+    return reinterpret_cast<struct udev *>(&s_FakeUdev);
+}
+
+struct udev_device *ut_udev_device_new_from_syspath(struct udev *, const char *)
+{
+    return fakeIntf();
+}
+
+struct udev_device *ut_udev_device_unref(struct udev_device *)
+{
+    return nullptr;
+}
+
+struct udev_enumerate *ut_udev_enumerate_new(struct udev *)
+{
+    return reinterpret_cast<struct udev_enumerate *>(&s_FakeEnumerate);
+}
+
+struct udev_enumerate *ut_udev_enumerate_unref(struct udev_enumerate *)
+{
+    return nullptr;
+}
+
+int ut_udev_enumerate_int()
+{
+    return 0;
+}
+
+struct udev_list_entry *ut_udev_enumerate_get_list_entry(struct udev_enumerate *)
+{
+    return reinterpret_cast<struct udev_list_entry *>(&s_FakeEntry);
+}
+
+struct udev_list_entry *ut_udev_list_entry_get_next(struct udev_list_entry *)
+{
+    return nullptr;
+}
+
+const char *ut_udev_list_entry_get_name(struct udev_list_entry *)
+{
+    return "/sys/devices/ut/usb9/9-1/9-1:1.0";
+}
+
+TEST_F(UsbInfoCollector_UT, UsbInfoCollector_UT_collectRecord)
+{
+    Stub stub;
+    stub.set(udev_device_get_property_value, ut_udev_device_get_value);
+    stub.set(udev_device_get_sysattr_value, ut_udev_device_get_value);
+    stub.set(udev_device_get_devtype, ut_udev_device_get_devtype);
+    stub.set(udev_device_get_devpath, ut_udev_device_get_devpath);
+    stub.set(udev_device_get_sysname, ut_udev_device_get_sysname);
+    stub.set(udev_device_get_driver, ut_udev_device_get_driver);
+    stub.set(udev_device_get_udev, ut_udev_device_get_udev);
+    stub.set(udev_device_new_from_syspath, ut_udev_device_new_from_syspath);
+    stub.set(udev_device_unref, ut_udev_device_unref);
+    stub.set(udev_enumerate_new, ut_udev_enumerate_new);
+    stub.set(udev_enumerate_unref, ut_udev_enumerate_unref);
+    stub.set(udev_enumerate_add_match_parent, ut_udev_enumerate_int);
+    stub.set(udev_enumerate_add_match_subsystem, ut_udev_enumerate_int);
+    stub.set(udev_enumerate_add_match_property, ut_udev_enumerate_int);
+    stub.set(udev_enumerate_scan_devices, ut_udev_enumerate_int);
+    stub.set(udev_enumerate_get_list_entry, ut_udev_enumerate_get_list_entry);
+    stub.set(udev_list_entry_get_next, ut_udev_list_entry_get_next);
+    stub.set(udev_list_entry_get_name, ut_udev_list_entry_get_name);
+
+    QString info;
+    ASSERT_TRUE(UsbInfoCollector::collect(fakeDevice(), info));
+
+    QStringList lines = info.split("\n");
+    EXPECT_EQ("1: USB 00.0: 0000 USB Device", lines.first());
+    EXPECT_TRUE(lines.contains("  Parent ID: 9-1"));
+    EXPECT_TRUE(lines.contains("  SysFS ID: /devices/ut/usb9/9-1/9-1:1.0"));
+    EXPECT_TRUE(lines.contains("  SysFS BusID: 9-1:1.0"));
+    EXPECT_TRUE(lines.contains("  Hardware Class: mouse"));
+    EXPECT_TRUE(lines.contains("  Model: \"Logitech, Inc. Unifying Receiver\""));
+    EXPECT_TRUE(lines.contains("  Hotplug: USB"));
+    EXPECT_TRUE(lines.contains("  Vendor: usb 0x046d \"Logitech, Inc.\""));
+    EXPECT_TRUE(lines.contains("  Device: usb 0xc52b \"Unifying Receiver\""));
+    EXPECT_TRUE(lines.contains("  Revision: 2.00"));
+    EXPECT_TRUE(lines.contains("  Driver: \"usbhid\""));
+    EXPECT_TRUE(lines.contains("  Driver Modules: \"usbhid\""));
+    EXPECT_TRUE(lines.contains("  Module Alias: usb:v046DpC52Bd1201dc00dsc00dp00ic03isc01ip02in00"));
+    // 没有序列号和网卡时不输出对应的项
+    EXPECT_FALSE(info.contains("Serial ID"));
+    EXPECT_FALSE(info.contains("Device File"));
+    EXPECT_TRUE(lines.last().startsWith("  Config Status:"));
+}
@@ -1,6 +1,6 @@
-SYNCQT.HEADER_FILES = xlsxabstractooxmlfile.h xlsxabstractsheet.h xlsxcell.h xlsxcellformula.h xlsxcellrange.h xlsxcellreference.h xlsxchart.h xlsxchartsheet.h xlsxconditionalformatting.h xlsxdatavalidation.h xlsxdocument.h xlsxformat.h xlsxglobal.h xlsxrichstring.h xlsxworkbook.h xlsxworksheet.h 
+SYNCQT.HEADER_FILES = xlsxabstractooxmlfile.h xlsxabstractsheet.h xlsxcell.h xlsxcellformula.h xlsxcellrange.h xlsxcellreference.h xlsxchart.h xlsxchartsheet.h xlsxconditionalformatting.h xlsxdatavalidation.h xlsxdocument.h xlsxformat.h xlsxglobal.h xlsxrichstring.h xlsxstreamwriter.h xlsxworkbook.h xlsxworksheet.h 
 SYNCQT.GENERATED_HEADER_FILES = qtxlsxversion.h QtXlsxVersion QtXlsx 
 SYNCQT.PRIVATE_HEADER_FILES = xlsxabstractooxmlfile_p.h xlsxabstractsheet_p.h xlsxcell_p.h xlsxcellformula_p.h xlsxchart_p.h xlsxchartsheet_p.h xlsxcolor_p.h xlsxconditionalformatting_p.h xlsxcontenttypes_p.h xlsxdatavalidation_p.h xlsxdocpropsapp_p.h xlsxdocpropscore_p.h xlsxdocument_p.h xlsxdrawing_p.h xlsxdrawinganchor_p.h xlsxformat_p.h xlsxmediafile_p.h xlsxnumformatparser_p.h xlsxrelationships_p.h xlsxrichstring_p.h xlsxsharedstrings_p.h xlsxsimpleooxmlfile_p.h xlsxstyles_p.h xlsxtheme_p.h xlsxutility_p.h xlsxworkbook_p.h xlsxworksheet_p.h xlsxzipreader_p.h xlsxzipwriter_p.h 
 SYNCQT.QPA_HEADER_FILES = 
-SYNCQT.CLEAN_HEADER_FILES = xlsxabstractooxmlfile.h xlsxabstractsheet.h xlsxcell.h xlsxcellformula.h xlsxcellrange.h xlsxcellreference.h xlsxchart.h xlsxchartsheet.h xlsxconditionalformatting.h xlsxdatavalidation.h xlsxdocument.h xlsxformat.h xlsxglobal.h xlsxrichstring.h xlsxworkbook.h xlsxworksheet.h 
+SYNCQT.CLEAN_HEADER_FILES = xlsxabstractooxmlfile.h xlsxabstractsheet.h xlsxcell.h xlsxcellformula.h xlsxcellrange.h xlsxcellreference.h xlsxchart.h xlsxchartsheet.h xlsxconditionalformatting.h xlsxdatavalidation.h xlsxdocument.h xlsxformat.h xlsxglobal.h xlsxrichstring.h xlsxstreamwriter.h xlsxworkbook.h xlsxworksheet.h 
 SYNCQT.INJECTIONS = 
@@ -0,0 +1 @@
+#include "../../src/xlsx/xlsxstreamwriter.h"
@@ -0,0 +1,302 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: MIT
+
+#include "xlsxstreamwriter.h"
+#include "xlsxcellreference.h"
+#include "xlsxzipwriter_p.h"
+#include <QLoggingCategory>
+#include "DDLog.h"
+
+using namespace DDLog;
+
+namespace QXlsx {
+
+static const int s_DefaultFontSize = 11;
+
+static const char *s_SpreadsheetNs = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+static const char *s_RelationshipsNs = "http://schemas.openxmlformats.org/officeDocument/2006/relationships";
+static const char *s_PackageRelsNs = "http://schemas.openxmlformats.org/package/2006/relationships";
+
+StreamWriter::StreamWriter(const QString &filePath, const QString &sheetName)
+    : m_FilePath(filePath)
+    , m_SheetName(sheetName)
+    , m_Row(1)
+    , m_Finished(false)
+{
+    // 默认格式固定为索引0
+    m_Fonts.append(qMakePair(false, s_DefaultFontSize));
+
+    if (!m_SheetPart.open()) {
+        qCWarning(appLog) << "Failed to create temporary sheet part for" << filePath;
+        return;
+    }
+
+    m_Writer.setDevice(&m_SheetPart);
+    m_Writer.writeStartDocument(QStringLiteral("1.0"), true);
+    m_Writer.writeStartElement(QStringLiteral("worksheet"));
+    m_Writer.writeAttribute(QStringLiteral("xmlns"), QLatin1String(s_SpreadsheetNs));
+    m_Writer.writeAttribute(QStringLiteral("xmlns:r"), QLatin1String(s_RelationshipsNs));
+    m_Writer.writeStartElement(QStringLiteral("sheetData"));
+}
+
+StreamWriter::~StreamWriter()
+{
+}
+
+void StreamWriter::appendRow(const QStringList &cells, const Format &format)
+{
+    if (m_Finished || !m_SheetPart.isOpen())
+        return;
+
+    if (cells.isEmpty()) {
+        ++m_Row;
+        return;
+    }
+
+    int style = styleIndex(format);
+    m_Writer.writeStartElement(QStringLiteral("row"));
+    m_Writer.writeAttribute(QStringLiteral("r"), QString::number(m_Row));
+    for (int col = 0; col < cells.size(); ++col) {
+        m_Writer.writeStartElement(QStringLiteral("c"));
+        m_Writer.writeAttribute(QStringLiteral("r"), CellReference(m_Row, col + 1).toString());
+        if (style != 0)
+            m_Writer.writeAttribute(QStringLiteral("s"), QString::number(style));
+        m_Writer.writeAttribute(QStringLiteral("t"), QStringLiteral("inlineStr"));
+        m_Writer.writeStartElement(QStringLiteral("is"));
+        m_Writer.writeStartElement(QStringLiteral("t"));
+        const QString &text = cells[col];
+        if (!text.isEmpty() && (text.at(0).isSpace() || text.at(text.size() - 1).isSpace()))
+            m_Writer.writeAttribute(QStringLiteral("xml:space"), QStringLiteral("preserve"));
+        m_Writer.writeCharacters(text);
+        m_Writer.writeEndElement(); // t
+        m_Writer.writeEndElement(); // is
+        m_Writer.writeEndElement(); // c
+    }
+    m_Writer.writeEndElement(); // row
+    ++m_Row;
+}
+
+void StreamWriter::skipRows(int count)
+{
+    if (count > 0)
+        m_Row += count;
+}
+
+int StreamWriter::currentRow() const
+{
+    return m_Row;
+}
+
+bool StreamWriter::save()
+{
+    if (m_Finished || !m_SheetPart.isOpen())
+        return false;
+    m_Finished = true;
+
+    m_Writer.writeEndElement(); // sheetData
+    m_Writer.writeEndElement(); // worksheet
+    m_Writer.writeEndDocument();
+    if (m_Writer.hasError() || !m_SheetPart.flush() || !m_SheetPart.seek(0)) {
+        qCWarning(appLog) << "Failed to write temporary sheet part for" << m_FilePath;
+        return false;
+    }
+
+    ZipWriter zipWriter(m_FilePath);
+    if (zipWriter.error())
+        return false;
+
+    zipWriter.addFile(QStringLiteral("[Content_Types].xml"), contentTypesXml());
+    zipWriter.addFile(QStringLiteral("_rels/.rels"), rootRelsXml());
+    zipWriter.addFile(QStringLiteral("xl/workbook.xml"), workbookXml());
+    zipWriter.addFile(QStringLiteral("xl/_rels/workbook.xml.rels"), workbookRelsXml());
+    zipWriter.addFile(QStringLiteral("xl/styles.xml"), stylesXml());
+    zipWriter.addFile(QStringLiteral("xl/worksheets/sheet1.xml"), &m_SheetPart);
+    zipWriter.close();
+
+    m_SheetPart.close();
+    return !zipWriter.error();
+}
+
+int StreamWriter::styleIndex(const Format &format)
+{
+    QPair<bool, int> font(format.fontBold(), format.fontSize() > 0 ? format.fontSize() : s_DefaultFontSize);
+    int index = m_Fonts.indexOf(font);
+    if (index < 0) {
+        m_Fonts.append(font);
+        index = m_Fonts.size() - 1;
+    }
+    return index;
+}
+
+QByteArray StreamWriter::contentTypesXml() const
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartDocument(QStringLiteral("1.0"), true);
+    writer.writeStartElement(QStringLiteral("Types"));
+    writer.writeAttribute(QStringLiteral("xmlns"), QStringLiteral("http://schemas.openxmlformats.org/package/2006/content-types"));
+
+    writer.writeEmptyElement(QStringLiteral("Default"));
+    writer.writeAttribute(QStringLiteral("Extension"), QStringLiteral("rels"));
+    writer.writeAttribute(QStringLiteral("ContentType"), QStringLiteral("application/vnd.openxmlformats-package.relationships+xml"));
+    writer.writeEmptyElement(QStringLiteral("Default"));
+    writer.writeAttribute(QStringLiteral("Extension"), QStringLiteral("xml"));
+    writer.writeAttribute(QStringLiteral("ContentType"), QStringLiteral("application/xml"));
+
+    writer.writeEmptyElement(QStringLiteral("Override"));
+    writer.writeAttribute(QStringLiteral("PartName"), QStringLiteral("/xl/workbook.xml"));
+    writer.writeAttribute(QStringLiteral("ContentType"), QStringLiteral("application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml"));
+    writer.writeEmptyElement(QStringLiteral("Override"));
+    writer.writeAttribute(QStringLiteral("PartName"), QStringLiteral("/xl/worksheets/sheet1.xml"));
+    writer.writeAttribute(QStringLiteral("ContentType"), QStringLiteral("application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml"));
+    writer.writeEmptyElement(QStringLiteral("Override"));
+    writer.writeAttribute(QStringLiteral("PartName"), QStringLiteral("/xl/styles.xml"));
+    writer.writeAttribute(QStringLiteral("ContentType"), QStringLiteral("application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml"));
+
+    writer.writeEndElement(); // Types
+    writer.writeEndDocument();
+    return data;
+}
+
+QByteArray StreamWriter::rootRelsXml() const
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartDocument(QStringLiteral("1.0"), true);
+    writer.writeStartElement(QStringLiteral("Relationships"));
+    writer.writeAttribute(QStringLiteral("xmlns"), QLatin1String(s_PackageRelsNs));
+    writer.writeEmptyElement(QStringLiteral("Relationship"));
+    writer.writeAttribute(QStringLiteral("Id"), QStringLiteral("rId1"));
+    writer.writeAttribute(QStringLiteral("Type"), QStringLiteral("http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument"));
+    writer.writeAttribute(QStringLiteral("Target"), QStringLiteral("xl/workbook.xml"));
+    writer.writeEndElement(); // Relationships
+    writer.writeEndDocument();
+    return data;
+}
+
+QByteArray StreamWriter::workbookXml() const
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartDocument(QStringLiteral("1.0"), true);
+    writer.writeStartElement(QStringLiteral("workbook"));
+    writer.writeAttribute(QStringLiteral("xmlns"), QLatin1String(s_SpreadsheetNs));
+    writer.writeAttribute(QStringLiteral("xmlns:r"), QLatin1String(s_RelationshipsNs));
+    writer.writeStartElement(QStringLiteral("sheets"));
+    writer.writeEmptyElement(QStringLiteral("sheet"));
+    writer.writeAttribute(QStringLiteral("name"), m_SheetName);
+    writer.writeAttribute(QStringLiteral("sheetId"), QStringLiteral("1"));
+    writer.writeAttribute(QStringLiteral("r:id"), QStringLiteral("rId1"));
+    writer.writeEndElement(); // sheets
+    writer.writeEndElement(); // workbook
+    writer.writeEndDocument();
+    return data;
+}
+
+QByteArray StreamWriter::workbookRelsXml() const
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartDocument(QStringLiteral("1.0"), true);
+    writer.writeStartElement(QStringLiteral("Relationships"));
+    writer.writeAttribute(QStringLiteral("xmlns"), QLatin1String(s_PackageRelsNs));
+    writer.writeEmptyElement(QStringLiteral("Relationship"));
+    writer.writeAttribute(QStringLiteral("Id"), QStringLiteral("rId1"));
+    writer.writeAttribute(QStringLiteral("Type"), QStringLiteral("http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet"));
+    writer.writeAttribute(QStringLiteral("Target"), QStringLiteral("worksheets/sheet1.xml"));
+    writer.writeEmptyElement(QStringLiteral("Relationship"));
+    writer.writeAttribute(QStringLiteral("Id"), QStringLiteral("rId2"));
+    writer.writeAttribute(QStringLiteral("Type"), QStringLiteral("http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles"));
+    writer.writeAttribute(QStringLiteral("Target"), QStringLiteral("styles.xml"));
+    writer.writeEndElement(); // Relationships
+    writer.writeEndDocument();
+    return data;
+}
+
+QByteArray StreamWriter::stylesXml() const
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartDocument(QStringLiteral("1.0"), true);
+    writer.writeStartElement(QStringLiteral("styleSheet"));
+    writer.writeAttribute(QStringLiteral("xmlns"), QLatin1String(s_SpreadsheetNs));
+
+    writer.writeStartElement(QStringLiteral("fonts"));
+    writer.writeAttribute(QStringLiteral("count"), QString::number(m_Fonts.size()));
+    for (int i = 0; i < m_Fonts.size(); ++i) {
+        writer.writeStartElement(QStringLiteral("font"));
+        if (m_Fonts[i].first)
+            writer.writeEmptyElement(QStringLiteral("b"));
+        writer.writeEmptyElement(QStringLiteral("sz"));
+        writer.writeAttribute(QStringLiteral("val"), QString::number(m_Fonts[i].second));
+        writer.writeEmptyElement(QStringLiteral("name"));
+        writer.writeAttribute(QStringLiteral("val"), QStringLiteral("Calibri"));
+        writer.writeEmptyElement(QStringLiteral("family"));
+        writer.writeAttribute(QStringLiteral("val"), QStringLiteral("2"));
+        writer.writeEmptyElement(QStringLiteral("scheme"));
+        writer.writeAttribute(QStringLiteral("val"), QStringLiteral("minor"));
+        writer.writeEndElement(); // font
+    }
+    writer.writeEndElement(); // fonts
+
+    writer.writeStartElement(QStringLiteral("fills"));
+    writer.writeAttribute(QStringLiteral("count"), QStringLiteral("2"));
+    writer.writeStartElement(QStringLiteral("fill"));
+    writer.writeEmptyElement(QStringLiteral("patternFill"));
+    writer.writeAttribute(QStringLiteral("patternType"), QStringLiteral("none"));
+    writer.writeEndElement(); // fill
+    writer.writeStartElement(QStringLiteral("fill"));
+    writer.writeEmptyElement(QStringLiteral("patternFill"));
+    writer.writeAttribute(QStringLiteral("patternType"), QStringLiteral("gray125"));
+    writer.writeEndElement(); // fill
+    writer.writeEndElement(); // fills
+
+    writer.writeStartElement(QStringLiteral("borders"));
+    writer.writeAttribute(QStringLiteral("count"), QStringLiteral("1"));
+    writer.writeStartElement(QStringLiteral("border"));
+    writer.writeEmptyElement(QStringLiteral("left"));
+    writer.writeEmptyElement(QStringLiteral("right"));
+    writer.writeEmptyElement(QStringLiteral("top"));
+    writer.writeEmptyElement(QStringLiteral("bottom"));
+    writer.writeEmptyElement(QStringLiteral("diagonal"));
+    writer.writeEndElement(); // border
+    writer.writeEndElement(); // borders
+
+    writer.writeStartElement(QStringLiteral("cellStyleXfs"));
+    writer.writeAttribute(QStringLiteral("count"), QStringLiteral("1"));
+    writer.writeEmptyElement(QStringLiteral("xf"));
+    writer.writeAttribute(QStringLiteral("numFmtId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("fontId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("fillId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("borderId"), QStringLiteral("0"));
+    writer.writeEndElement(); // cellStyleXfs
+
+    writer.writeStartElement(QStringLiteral("cellXfs"));
+    writer.writeAttribute(QStringLiteral("count"), QString::number(m_Fonts.size()));
+    for (int i = 0; i < m_Fonts.size(); ++i) {
+        writer.writeEmptyElement(QStringLiteral("xf"));
+        writer.writeAttribute(QStringLiteral("numFmtId"), QStringLiteral("0"));
+        writer.writeAttribute(QStringLiteral("fontId"), QString::number(i));
+        writer.writeAttribute(QStringLiteral("fillId"), QStringLiteral("0"));
+        writer.writeAttribute(QStringLiteral("borderId"), QStringLiteral("0"));
+        writer.writeAttribute(QStringLiteral("xfId"), QStringLiteral("0"));
+        if (i != 0)
+            writer.writeAttribute(QStringLiteral("applyFont"), QStringLiteral("1"));
+    }
+    writer.writeEndElement(); // cellXfs
+
+    writer.writeStartElement(QStringLiteral("cellStyles"));
+    writer.writeAttribute(QStringLiteral("count"), QStringLiteral("1"));
+    writer.writeEmptyElement(QStringLiteral("cellStyle"));
+    writer.writeAttribute(QStringLiteral("name"), QStringLiteral("Normal"));
+    writer.writeAttribute(QStringLiteral("xfId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("builtinId"), QStringLiteral("0"));
+    writer.writeEndElement(); // cellStyles
+
+    writer.writeEndElement(); // styleSheet
+    writer.writeEndDocument();
+    return data;
+}
+
+} // namespace QXlsx
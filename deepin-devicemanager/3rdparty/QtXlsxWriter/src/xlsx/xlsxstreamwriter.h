@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef QXLSX_XLSXSTREAMWRITER_H
+#define QXLSX_XLSXSTREAMWRITER_H
+
+#include "xlsxglobal.h"
+#include "xlsxformat.h"
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <QTemporaryFile>
+#include <QXmlStreamWriter>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+/**
+ * @brief The StreamWriter class
+ * 按行写入单个工作表的xlsx文件
+ * Document 会把所有单元格保存在内存中直到保存，StreamWriter 在追加行时直接把
+ * 工作表 xml 写到临时文件，单元格使用内联字符串，内存占用与行数无关
+ * 只支持字体的加粗和字号两种格式
+ */
+class Q_XLSX_EXPORT StreamWriter
+{
+public:
+    explicit StreamWriter(const QString &filePath, const QString &sheetName = QStringLiteral("Sheet1"));
+    ~StreamWriter();
+
+    /**
+     * @brief appendRow 在当前行写入一行文本，从第一列开始
+     * @param cells 单元格内容，为空时只跳过当前行
+     * @param format 单元格格式
+     */
+    void appendRow(const QStringList &cells, const Format &format = Format());
+
+    /**
+     * @brief skipRows 跳过若干空行
+     * @param count 行数
+     */
+    void skipRows(int count = 1);
+
+    /**
+     * @brief currentRow 下一次写入的行号，从1开始
+     */
+    int currentRow() const;
+
+    /**
+     * @brief save 结束工作表并打包成xlsx文件，之后不能再追加行
+     * @return 是否保存成功
+     */
+    bool save();
+
+private:
+    Q_DISABLE_COPY(StreamWriter)
+
+    /**
+     * @brief styleIndex 获取格式对应的 cellXfs 索引，不存在时添加
+     */
+    int styleIndex(const Format &format);
+
+    QByteArray contentTypesXml() const;
+    QByteArray rootRelsXml() const;
+    QByteArray workbookXml() const;
+    QByteArray workbookRelsXml() const;
+    QByteArray stylesXml() const;
+
+    QString                   m_FilePath;       //<! 输出文件
+    QString                   m_SheetName;      //<! 工作表名称
+    QTemporaryFile            m_SheetPart;      //<! 工作表 xml 临时文件
+    QXmlStreamWriter          m_Writer;         //<! 写工作表 xml
+    int                       m_Row;            //<! 下一次写入的行号
+    bool                      m_Finished;       //<! 是否已经保存
+    QList<QPair<bool, int> >  m_Fonts;          //<! 已使用的字体(加粗, 字号)，索引即 cellXfs 索引
+};
+
+QT_END_NAMESPACE_XLSX
+
+#endif // QXLSX_XLSXSTREAMWRITER_H
@@ -41,7 +41,8 @@ SOURCES += \
     $$PWD/opc/packagewriter.cpp \
     $$PWD/opc/physpkgwriter.cpp \
     $$PWD/enums/enumtext.cpp \
-    $$PWD/length.cpp
+    $$PWD/length.cpp \
+    $$PWD/streamdocument.cpp
 
 HEADERS +=\
     $$PWD/docx_global.h \
@@ -75,6 +76,7 @@ HEADERS +=\
     $$PWD/opc/packagewriter.h \
     $$PWD/opc/physpkgwriter.h \
     $$PWD/enums/enumtext.h \
-    $$PWD/length.h
+    $$PWD/length.h \
+    $$PWD/streamdocument.h
 
 
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "streamdocument.h"
+#include "DDLog.h"
+
+#include <private/qzipreader_p.h>
+#include <private/qzipwriter_p.h>
+#include <QLoggingCategory>
+
+using namespace DDLog;
+
+namespace Docx {
+
+static const QString s_documentUri = QStringLiteral("word/document.xml");
+
+StreamDocument::StreamDocument(const QString &templateName)
+    : m_templateName(templateName)
+    , m_tableColumns(-1)
+    , m_valid(false)
+{
+    qCInfo(appLog) << "construct docx stream document from " << templateName;
+    QZipReader reader(templateName);
+    QByteArray document = reader.fileData(s_documentUri);
+
+    // 新内容写在最后一个 sectPr 之前，与 DocumentPart::addParagraph 相同
+    int pos = document.lastIndexOf("<w:sectPr");
+    if (pos < 0)
+        pos = document.lastIndexOf("</w:body>");
+    if (pos < 0) {
+        qCWarning(appLog) << "invalid docx template: " << templateName;
+        return;
+    }
+
+    if (!m_documentPart.open()) {
+        qCWarning(appLog) << "can not create temporary document part";
+        return;
+    }
+
+    m_bodyEnd = document.mid(pos);
+    m_documentPart.write(document.constData(), pos);
+    m_writer.setDevice(&m_documentPart);
+    m_valid = true;
+}
+
+StreamDocument::~StreamDocument()
+{
+}
+
+/*!
+ * \brief 添加段落
+ * \param text  文本
+ * \param style 样式
+ */
+void StreamDocument::addParagraph(const QString &text, const QString &style)
+{
+    if (!m_valid)
+        return;
+
+    m_writer.writeStartElement(QStringLiteral("w:p"));
+    if (!text.isEmpty()) {
+        m_writer.writeStartElement(QStringLiteral("w:pPr"));
+        if (!style.isEmpty()) {
+            m_writer.writeEmptyElement(QStringLiteral("w:pStyle"));
+            m_writer.writeAttribute(QStringLiteral("w:val"), style);
+        }
+        m_writer.writeEmptyElement(QStringLiteral("w:jc"));
+        m_writer.writeAttribute(QStringLiteral("w:val"), QStringLiteral("left"));
+        m_writer.writeEndElement(); // w:pPr
+        writeRun(text);
+    }
+    m_writer.writeEndElement(); // w:p
+}
+
+/*!
+ * \brief 添加标题
+ * \param text
+ * \param level
+ */
+void StreamDocument::addHeading(const QString &text, int level)
+{
+    QString style;
+    if (level == 0)
+        style = "Title";
+    else
+        style = QString("%1").arg(level);
+    addParagraph(text, style);
+}
+
+void StreamDocument::beginTable(const QStringList &header, const QString &style)
+{
+    if (!m_valid)
+        return;
+
+    endTable();
+    m_tableColumns = header.size();
+    if (m_tableColumns == 0)
+        return;
+
+    m_writer.writeStartElement(QStringLiteral("w:tbl"));
+
+    // 样式与 CT_Tbl::setStyle 相同
+    m_writer.writeStartElement(QStringLiteral("w:tblPr"));
+    m_writer.writeEmptyElement(QStringLiteral("w:tblStyle"));
+    m_writer.writeAttribute(QStringLiteral("w:val"), style);
+    m_writer.writeStartElement(QStringLiteral("w:tblBorders"));
+    const QStringList borders = {"w:top", "w:left", "w:bottom", "w:right", "w:insideH", "w:insideV"};
+    for (const QString &border : borders) {
+        m_writer.writeEmptyElement(border);
+        m_writer.writeAttribute(QStringLiteral("w:val"), QStringLiteral("single"));
+        m_writer.writeAttribute(QStringLiteral("w:color"), QStringLiteral("auto"));
+        m_writer.writeAttribute(QStringLiteral("w:sz"), QStringLiteral("4"));
+        m_writer.writeAttribute(QStringLiteral("w:space"), QStringLiteral("0"));
+    }
+    m_writer.writeEndElement(); // w:tblBorders
+    m_writer.writeEndElement(); // w:tblPr
+
+    m_writer.writeStartElement(QStringLiteral("w:tblGrid"));
+    for (int i = 0; i < m_tableColumns; ++i) {
+        m_writer.writeEmptyElement(QStringLiteral("w:gridCol"));
+        m_writer.writeAttribute(QStringLiteral("w:w"), QStringLiteral("1600"));
+    }
+    m_writer.writeEndElement(); // w:tblGrid
+
+    writeRow(header);
+}
+
+/*!
+ * \brief 添加表格行，多余的单元格被忽略，不足的为空
+ * \param cells
+ */
+void StreamDocument::addTableRow(const QStringList &cells)
+{
+    if (!m_valid || m_tableColumns <= 0)
+        return;
+    writeRow(cells);
+}
+
+void StreamDocument::endTable()
+{
+    if (m_tableColumns > 0)
+        m_writer.writeEndElement(); // w:tbl
+    m_tableColumns = -1;
+}
+
+bool StreamDocument::save(const QString &path)
+{
+    qCInfo(appLog) << "save docx stream document: " << path;
+    if (!m_valid)
+        return false;
+    m_valid = false;
+
+    endTable();
+    m_documentPart.write(m_bodyEnd);
+    if (m_writer.hasError() || !m_documentPart.flush() || !m_documentPart.seek(0)) {
+        qCWarning(appLog) << "failed to write temporary document part";
+        return false;
+    }
+
+    // 模板中的其它部件原样复制
+    QZipReader reader(m_templateName);
+    QZipWriter writer(path, QIODevice::WriteOnly);
+    writer.setCompressionPolicy(QZipWriter::AutoCompress);
+    foreach (const QZipReader::FileInfo &info, reader.fileInfoList()) {
+        if (!info.isFile || info.filePath == s_documentUri)
+            continue;
+        writer.addFile(info.filePath, reader.fileData(info.filePath));
+    }
+    writer.addFile(s_documentUri, &m_documentPart);
+    writer.close();
+
+    m_documentPart.close();
+    return writer.status() == QZipWriter::NoError;
+}
+
+void StreamDocument::writeRun(const QString &text)
+{
+    m_writer.writeStartElement(QStringLiteral("w:r"));
+    m_writer.writeStartElement(QStringLiteral("w:t"));
+    m_writer.writeAttribute(QStringLiteral("xml:space"), QStringLiteral("preserve"));
+    m_writer.writeCharacters(text);
+    m_writer.writeEndElement(); // w:t
+    m_writer.writeEndElement(); // w:r
+}
+
+/*!
+ * \brief 写一行，单元格与 Row::addTc 相同
+ * \param cells
+ */
+void StreamDocument::writeRow(const QStringList &cells)
+{
+    m_writer.writeStartElement(QStringLiteral("w:tr"));
+    for (int col = 0; col < m_tableColumns; ++col) {
+        m_writer.writeStartElement(QStringLiteral("w:tc"));
+        m_writer.writeStartElement(QStringLiteral("w:tcPr"));
+        m_writer.writeEmptyElement(QStringLiteral("w:tcW"));
+        m_writer.writeAttribute(QStringLiteral("w:w"), QStringLiteral("2000"));
+        m_writer.writeAttribute(QStringLiteral("w:type"), QStringLiteral("dxa"));
+        m_writer.writeStartElement(QStringLiteral("w:tcBorders"));
+        m_writer.writeEmptyElement(QStringLiteral("w:tl2br"));
+        m_writer.writeAttribute(QStringLiteral("w:val"), QStringLiteral("nil"));
+        m_writer.writeEmptyElement(QStringLiteral("w:tr2bl"));
+        m_writer.writeAttribute(QStringLiteral("w:val"), QStringLiteral("nil"));
+        m_writer.writeEndElement(); // w:tcBorders
+        m_writer.writeEndElement(); // w:tcPr
+
+        // 单元格必须包含一个段落
+        m_writer.writeStartElement(QStringLiteral("w:p"));
+        if (col < cells.size() && !cells[col].isEmpty()) {
+            m_writer.writeStartElement(QStringLiteral("w:pPr"));
+            m_writer.writeEmptyElement(QStringLiteral("w:jc"));
+            m_writer.writeAttribute(QStringLiteral("w:val"), QStringLiteral("left"));
+            m_writer.writeEndElement(); // w:pPr
+            writeRun(cells[col]);
+        }
+        m_writer.writeEndElement(); // w:p
+        m_writer.writeEndElement(); // w:tc
+    }
+    m_writer.writeEndElement(); // w:tr
+}
+
+}
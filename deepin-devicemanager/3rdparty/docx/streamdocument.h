@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef STREAMDOCUMENT_H
+#define STREAMDOCUMENT_H
+
+#include "docx_global.h"
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QTemporaryFile>
+#include <QXmlStreamWriter>
+
+namespace Docx {
+
+/*!
+ * \brief 只能向后追加内容的docx文档
+ *
+ * Document 会把整个 word/document.xml 保存在 DOM 中直到保存，
+ * StreamDocument 在追加段落和表格行时直接把 xml 写到临时文件，
+ * 保存时与模板中的其它部件一起打包，内存占用与文档长度无关。
+ * 生成的段落和表格与 Document 的 addParagraph、addHeading、addTable 一致。
+ */
+class DOCX_EXPORT StreamDocument
+{
+public:
+    explicit StreamDocument(const QString &templateName);
+    virtual ~StreamDocument();
+
+    void addParagraph(const QString &text = QString(), const QString &style = QString());
+    void addHeading(const QString &text = QString(), int level = 1);
+
+    /*!
+     * \brief 开始一个表格，表头作为第一行，之后的行与表头列数相同
+     * \param header 表头，为空时不添加表格
+     * \param style 表格样式
+     */
+    void beginTable(const QStringList &header, const QString &style = QString::fromLatin1("TableGrid"));
+    void addTableRow(const QStringList &cells);
+    void endTable();
+
+    bool save(const QString &path);
+
+private:
+    Q_DISABLE_COPY(StreamDocument)
+
+    void writeRun(const QString &text);
+    void writeRow(const QStringList &cells);
+
+    QString          m_templateName;
+    QByteArray       m_bodyEnd;         // 模板 document.xml 中 sectPr 及之后的部分
+    QTemporaryFile   m_documentPart;    // word/document.xml 临时文件
+    QXmlStreamWriter m_writer;
+    int              m_tableColumns;    // 当前表格列数，-1 表示不在表格中
+    bool             m_valid;
+};
+
+}
+
+#endif // STREAMDOCUMENT_H
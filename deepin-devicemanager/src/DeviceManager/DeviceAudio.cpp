@@ -457,3 +457,17 @@ void DeviceAudio::loadTableData()
 //    0x9dc8
 //    deep@nuc8:/sys/class/sound/card0$ cat hwC0D0/vendor_id
 //    0x10ec0235
+
+void DeviceAudio::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_BusInfo << m_Irq << m_Memory << m_Width << m_Clock << m_Capabilities
+        << m_Chip << m_DriverModules << m_IsCatDevice;
+}
+
+void DeviceAudio::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_BusInfo >> m_Irq >> m_Memory >> m_Width >> m_Clock >> m_Capabilities
+       >> m_Chip >> m_DriverModules >> m_IsCatDevice;
+}
@@ -312,3 +312,15 @@ void DeviceBios::loadTableData()
 {
     // qCDebug(appLog) << "Loading table data";
 }
+
+void DeviceBios::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_ProductName << m_ChipsetFamily << m_IsBoard << m_tomlName;
+}
+
+void DeviceBios::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_ProductName >> m_ChipsetFamily >> m_IsBoard >> m_tomlName;
+}
@@ -120,6 +120,18 @@ public:
      */
     const QString getOverviewInfo() override;
 
+    /**
+     * @brief saveSnapshot:将设备属性写入快照
+     * @param out:快照数据流
+     */
+    void saveSnapshot(QDataStream &out) const override;
+
+    /**
+     * @brief loadSnapshot:从快照中读取设备属性
+     * @param in:快照数据流
+     */
+    void loadSnapshot(QDataStream &in) override;
+
 protected:
 
     /**
@@ -305,3 +305,17 @@ void DeviceBluetooth::loadTableData()
     m_TableData.append(m_Vendor);
     m_TableData.append(m_Model);
 }
+
+void DeviceBluetooth::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_MAC << m_LogicalName << m_BusInfo << m_Capabilities << m_DriverVersion
+        << m_MaximumPower << m_Speed << m_Alias;
+}
+
+void DeviceBluetooth::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_MAC >> m_LogicalName >> m_BusInfo >> m_Capabilities >> m_DriverVersion
+       >> m_MaximumPower >> m_Speed >> m_Alias;
+}
@@ -193,3 +193,14 @@ void DeviceCdrom::loadTableData()
     qCDebug(appLog) << "Table data loaded.";
 }
 
+void DeviceCdrom::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Type << m_BusInfo << m_Capabilities << m_MaxPower << m_Speed;
+}
+
+void DeviceCdrom::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Type >> m_BusInfo >> m_Capabilities >> m_MaxPower >> m_Speed;
+}
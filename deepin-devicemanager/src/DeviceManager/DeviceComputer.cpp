@@ -213,3 +213,15 @@ void DeviceComputer::loadTableData()
     // qCDebug(appLog) << "DeviceComputer::loadTableData called. No data to load based on existing function body.";
 
 }
+
+void DeviceComputer::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_HomeUrl << m_OsDescription << m_OS << m_Type;
+}
+
+void DeviceComputer::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_HomeUrl >> m_OsDescription >> m_OS >> m_Type;
+}
@@ -433,3 +433,26 @@ void DeviceCpu::loadTableData()
     m_TableData.append(m_Frequency);
     m_TableData.append(m_Architecture);
 }
+
+void DeviceCpu::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_PhysicalID << m_CoreID << m_ThreadNum << m_Frequency << m_CurFrequency
+        << m_MaxFrequency << m_BogoMIPS << m_Architecture << m_Familly << m_Model << m_Step
+        << m_CacheL1Data << m_CacheL1Order << m_CacheL2 << m_CacheL3 << m_CacheL4 << m_Extensions
+        << m_Flags << m_HardwareVirtual << qint32(m_LogicalCPUNum) << qint32(m_CPUCoreNum)
+        << m_FrequencyIsRange << m_FrequencyIsCur;
+}
+
+void DeviceCpu::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    qint32 logicalCPUNum = 0;
+    qint32 cpuCoreNum = 0;
+    in >> m_PhysicalID >> m_CoreID >> m_ThreadNum >> m_Frequency >> m_CurFrequency >> m_MaxFrequency
+       >> m_BogoMIPS >> m_Architecture >> m_Familly >> m_Model >> m_Step >> m_CacheL1Data
+       >> m_CacheL1Order >> m_CacheL2 >> m_CacheL3 >> m_CacheL4 >> m_Extensions >> m_Flags
+       >> m_HardwareVirtual >> logicalCPUNum >> cpuCoreNum >> m_FrequencyIsRange >> m_FrequencyIsCur;
+    m_LogicalCPUNum = logicalCPUNum;
+    m_CPUCoreNum = cpuCoreNum;
+}
@@ -464,3 +464,21 @@ void DeviceGpu::appendExtraInfoToOtherInfo()
             m_LstOtherInfo.append(QPair<QString, QString>(iter.key(), iter.value()));
     }
 }
+
+void DeviceGpu::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_GraphicsMemory << m_Width << m_DisplayPort << m_Clock << m_IRQ
+        << m_Capabilities << m_DisplayOutput << m_VGA << m_HDMI << m_eDP << m_DVI << m_Digital
+        << m_CurrentResolution << m_MinimumResolution << m_MaximumResolution << m_Type << m_BusInfo
+        << m_IOPort << m_MemAddress << m_extraInfo;
+}
+
+void DeviceGpu::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_GraphicsMemory >> m_Width >> m_DisplayPort >> m_Clock >> m_IRQ
+       >> m_Capabilities >> m_DisplayOutput >> m_VGA >> m_HDMI >> m_eDP >> m_DVI >> m_Digital
+       >> m_CurrentResolution >> m_MinimumResolution >> m_MaximumResolution >> m_Type >> m_BusInfo
+       >> m_IOPort >> m_MemAddress >> m_extraInfo;
+}
@@ -250,3 +250,15 @@ void DeviceImage::loadTableData()
     m_TableData.append(m_Model);
     qCDebug(appLog) << "Table data loaded.";
 }
+
+void DeviceImage::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_BusInfo << m_Capabilities << m_MaximumPower << m_Speed;
+}
+
+void DeviceImage::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_BusInfo >> m_Capabilities >> m_MaximumPower >> m_Speed;
+}
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceIndex.h"
+#include "DeviceInfo.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+
+void DeviceIndex::insert(DeviceBaseInfo *device)
+{
+    QMutexLocker locker(&m_Mutex);
+    if (!device || m_Entries.contains(device))
+        return;
+    insertEntry(device, m_Seq++);
+}
+
+void DeviceIndex::remove(DeviceBaseInfo *device)
+{
+    QMutexLocker locker(&m_Mutex);
+    removeEntry(device);
+}
+
+void DeviceIndex::update(DeviceBaseInfo *device)
+{
+    QMutexLocker locker(&m_Mutex);
+    auto it = m_Entries.find(device);
+    if (it == m_Entries.end())
+        return;
+
+    qint64 seq = it->seq;
+    removeEntry(device);
+    insertEntry(device, seq);
+}
+
+void DeviceIndex::rebuild(const QList<DeviceBaseInfo *> &lstDevice)
+{
+    QMutexLocker locker(&m_Mutex);
+    rebuildEntries(lstDevice);
+}
+
+void DeviceIndex::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Entries.clear();
+    for (int key = 0; key < IK_Count; ++key)
+        m_Index[key].clear();
+    m_Seq = 0;
+}
+
+int DeviceIndex::size() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Entries.size();
+}
+
+QList<DeviceBaseInfo *> DeviceIndex::find(IndexKey key, const QString &value) const
+{
+    return find(key, QStringList() << value);
+}
+
+QList<DeviceBaseInfo *> DeviceIndex::find(IndexKey key, const QStringList &values) const
+{
+    QMutexLocker locker(&m_Mutex);
+    QList<DeviceBaseInfo *> lstDevice;
+    foreach (const QString &value, values) {
+        auto bucket = m_Index[key].constFind(value);
+        if (bucket != m_Index[key].constEnd())
+            lstDevice.append(*bucket);
+    }
+    sortEntries(lstDevice);
+    return lstDevice;
+}
+
+void DeviceIndex::sort(QList<DeviceBaseInfo *> &lstDevice) const
+{
+    QMutexLocker locker(&m_Mutex);
+    sortEntries(lstDevice);
+}
+
+QStringList DeviceIndex::lshwKeys(const QMap<QString, QString> &mapInfo)
+{
+    QStringList keys;
+    // 网卡设备与序列号匹配上 或者加上逻辑设备名
+    if (mapInfo.contains("logical name") && mapInfo.contains("serial")) {
+        keys.append(mapInfo["serial"] + mapInfo["logical name"]);
+        keys.append(mapInfo["serial"]);
+    }
+
+    if (!mapInfo.contains("bus info"))
+        return keys;
+
+    // 非usb设备
+    const QString &busInfo = mapInfo["bus info"];
+    if (busInfo.startsWith("pci")) {
+        QStringList words = busInfo.split("@");
+        if (2 == words.size())
+            keys.append(words[1]);
+    }
+
+    // USB 设备
+    keys.append(busInfo);
+    return keys;
+}
+
+QString DeviceIndex::keyValue(IndexKey key, const DeviceBaseInfo *device)
+{
+    switch (key) {
+    case IK_UniqueID:
+        return device->uniqueID();
+    case IK_BusInfo:
+        return device->hwinfoLshwKey();
+    case IK_SysPath:
+        return device->sysPath();
+    case IK_Modalias:
+        return normalize(key, device->getModalias());
+    case IK_VIDPID:
+        return normalize(key, device->getVIDAndPID());
+    default:
+        return QString();
+    }
+}
+
+QString DeviceIndex::normalize(IndexKey key, const QString &value)
+{
+    switch (key) {
+    case IK_Modalias:
+        // sysfs 中的 modalias 为大写十六进制，toml 中的为小写
+        return value.toLower();
+    case IK_VIDPID:
+        // hwinfo 中为 0x8086xxxx，toml 中为 8086xxxx
+        return value.toLower().remove("0x");
+    default:
+        return value;
+    }
+}
+
+void DeviceIndex::removeEntry(DeviceBaseInfo *device)
+{
+    auto it = m_Entries.find(device);
+    if (it == m_Entries.end())
+        return;
+
+    for (int key = 0; key < IK_Count; ++key) {
+        auto bucket = m_Index[key].find(it->keys[key]);
+        if (bucket == m_Index[key].end())
+            continue;
+        bucket->removeOne(device);
+        if (bucket->isEmpty())
+            m_Index[key].erase(bucket);
+    }
+    m_Entries.erase(it);
+}
+
+void DeviceIndex::rebuildEntries(const QList<DeviceBaseInfo *> &lstDevice)
+{
+    m_Entries.clear();
+    for (int key = 0; key < IK_Count; ++key)
+        m_Index[key].clear();
+    m_Seq = 0;
+    foreach (DeviceBaseInfo *device, lstDevice) {
+        if (device && !m_Entries.contains(device))
+            insertEntry(device, m_Seq++);
+    }
+}
+
+void DeviceIndex::sortEntries(QList<DeviceBaseInfo *> &lstDevice) const
+{
+    // 保持与遍历设备列表相同的先后顺序
+    std::sort(lstDevice.begin(), lstDevice.end(), [this](DeviceBaseInfo *a, DeviceBaseInfo *b) {
+        return m_Entries.value(a).seq < m_Entries.value(b).seq;
+    });
+    lstDevice.erase(std::unique(lstDevice.begin(), lstDevice.end()), lstDevice.end());
+}
+
+void DeviceIndex::insertEntry(DeviceBaseInfo *device, qint64 seq)
+{
+    Entry entry;
+    entry.seq = seq;
+    for (int key = 0; key < IK_Count; ++key) {
+        entry.keys[key] = keyValue(static_cast<IndexKey>(key), device);
+        m_Index[key][entry.keys[key]].append(device);
+    }
+    m_Entries.insert(device, entry);
+}
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICEINDEX_H
+#define DEVICEINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+class DeviceBaseInfo;
+
+/**
+ * @brief The DeviceIndex class
+ * 同一类设备的哈希索引，按唯一ID、总线信息、sysfs路径、modalias、VID:PID查找设备
+ * 查找结果只是候选设备，调用者仍需用原有的匹配规则确认
+ * 设备增删和关键属性被修改时由 DeviceManager 同步更新索引，查找时不再遍历设备列表
+ * 生成设备的线程会并发访问，所有接口都加锁
+ */
+class DeviceIndex
+{
+public:
+    enum IndexKey {
+        IK_UniqueID = 0,  // uniqueID()
+        IK_BusInfo,       // hwinfoLshwKey()，与lshw的 bus info 对应
+        IK_SysPath,       // sysPath()
+        IK_Modalias,      // getModalias()，不区分大小写
+        IK_VIDPID,        // getVIDAndPID()，不区分大小写并去掉0x
+        IK_Count
+    };
+
+    /**
+     * @brief insert:添加设备到索引，设备排在已有设备之后
+     * @param device:设备
+     */
+    void insert(DeviceBaseInfo *device);
+
+    /**
+     * @brief remove:从索引中删除设备
+     * @param device:设备
+     */
+    void remove(DeviceBaseInfo *device);
+
+    /**
+     * @brief update:设备的关键属性被修改后重新计算索引，保持设备原有顺序
+     * @param device:设备
+     */
+    void update(DeviceBaseInfo *device);
+
+    /**
+     * @brief rebuild:按设备列表重建索引
+     * @param lstDevice:设备列表
+     */
+    void rebuild(const QList<DeviceBaseInfo *> &lstDevice);
+
+    /**
+     * @brief clear:清空索引
+     */
+    void clear();
+
+    /**
+     * @brief size:已索引的设备数
+     * @return
+     */
+    int size() const;
+
+    /**
+     * @brief find:查找关键属性值等于value的设备
+     * @param key:索引类型
+     * @param value:属性值
+     * @return 按设备列表顺序排列的候选设备
+     */
+    QList<DeviceBaseInfo *> find(IndexKey key, const QString &value) const;
+
+    /**
+     * @brief find:查找关键属性值等于values中任意一个的设备
+     * @param key:索引类型
+     * @param values:属性值列表
+     * @return 按设备列表顺序排列的候选设备，不重复
+     */
+    QList<DeviceBaseInfo *> find(IndexKey key, const QStringList &values) const;
+
+    /**
+     * @brief sort:去掉重复设备，并按设备列表顺序排列
+     * @param lstDevice:已索引的设备
+     */
+    void sort(QList<DeviceBaseInfo *> &lstDevice) const;
+
+    /**
+     * @brief lshwKeys:获取lshw信息可能匹配到的 IK_BusInfo 值，与 DeviceBaseInfo::matchToLshw 规则一致
+     * @param mapInfo:lshw信息
+     * @return
+     */
+    static QStringList lshwKeys(const QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief keyValue:获取设备的关键属性值
+     * @param key:索引类型
+     * @param device:设备
+     * @return
+     */
+    static QString keyValue(IndexKey key, const DeviceBaseInfo *device);
+
+    /**
+     * @brief normalize:将属性值转换为索引中保存的形式，查找 modalias 和 VID:PID 前需先转换
+     * @param key:索引类型
+     * @param value:属性值
+     * @return
+     */
+    static QString normalize(IndexKey key, const QString &value);
+
+private:
+    struct Entry {
+        qint64  seq = 0;              //<! 设备在列表中的先后顺序
+        QString keys[IK_Count];       //<! 加入索引时的关键属性值
+    };
+
+    void insertEntry(DeviceBaseInfo *device, qint64 seq);
+    void removeEntry(DeviceBaseInfo *device);
+    void rebuildEntries(const QList<DeviceBaseInfo *> &lstDevice);
+    void sortEntries(QList<DeviceBaseInfo *> &lstDevice) const;
+
+    QHash<DeviceBaseInfo *, Entry>                   m_Entries;          //<! 已索引的设备
+    QHash<QString, QList<DeviceBaseInfo *>>          m_Index[IK_Count];  //<! 关键属性值与设备的对应关系
+    qint64                                           m_Seq = 0;          //<! 下一个设备的顺序号
+    mutable QMutex                                   m_Mutex;            //<! 保护以上成员
+};
+
+#endif // DEVICEINDEX_H
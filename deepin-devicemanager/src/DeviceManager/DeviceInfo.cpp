@@ -8,6 +8,7 @@
 #include "commondefine.h"
 #include"DeviceManager.h"
 #include "DDLog.h"
+#include "HwIdResolver.h"
 
 #include <DApplication>
 
@@ -15,6 +16,11 @@
 #include <QProcess>
 #include <QMap>
 #include <QRegularExpression>
+#include <QMutex>
+#include <QHash>
+#include <QLocale>
+
+#include <libkmod.h>
 using namespace DDLog;
 
 DWIDGET_USE_NAMESPACE
@@ -30,6 +36,7 @@ DeviceBaseInfo::DeviceBaseInfo(QObject *parent)
     , m_HwinfoToLshw("")
     , m_VID_PID("")
     , m_Modalias("")
+    , m_TrGeneration(-1)
     , m_Enable(true)
     , m_CanEnable(false)
     , m_CanUninstall(false)
@@ -46,9 +53,81 @@ DeviceBaseInfo::~DeviceBaseInfo()
     qCDebug(appLog) << "DeviceBaseInfo destructor called.";
 }
 
+// 翻译结果缓存，所有设备共用，语言变化时清空
+static QHash<QString, QString> s_TranslateCache;
+static QString s_TranslateLocale;
+static int s_TranslateGeneration = 0;
+static QMutex s_TranslateMutex;
+
+static void checkTranslateLocale()
+{
+    const QString locale = QLocale().name();
+    if (locale != s_TranslateLocale) {
+        s_TranslateCache.clear();
+        s_TranslateLocale = locale;
+        ++s_TranslateGeneration;
+    }
+}
+
 const QString DeviceBaseInfo::translateStr(const QString &inStr)
 {
-    return tr(inStr.toUtf8());
+    QMutexLocker locker(&s_TranslateMutex);
+    checkTranslateLocale();
+    auto it = s_TranslateCache.constFind(inStr);
+    if (it != s_TranslateCache.constEnd())
+        return *it;
+
+    QString str = tr(inStr.toUtf8());
+    s_TranslateCache.insert(inStr, str);
+    return str;
+}
+
+void DeviceBaseInfo::clearTranslationCache()
+{
+    QMutexLocker locker(&s_TranslateMutex);
+    s_TranslateCache.clear();
+    ++s_TranslateGeneration;
+}
+
+int DeviceBaseInfo::translationGeneration()
+{
+    QMutexLocker locker(&s_TranslateMutex);
+    checkTranslateLocale();
+    return s_TranslateGeneration;
+}
+
+void DeviceBaseInfo::checkTranslationGeneration()
+{
+    int generation = translationGeneration();
+    if (generation == m_TrGeneration)
+        return;
+
+    // 语言变化后所有列表都需要重新翻译
+    m_TrGeneration = generation;
+    m_LstBaseInfoTrSrc.clear();
+    m_LstBaseInfoTr.clear();
+    m_LstOtherInfoTrSrc.clear();
+    m_LstOtherInfoTr.clear();
+    m_TableHeaderTrSrc.clear();
+    m_TableHeaderTr.clear();
+}
+
+void DeviceBaseInfo::translateAttribs(const QList<QPair<QString, QString> > &src, QList<QPair<QString, QString> > &trSrc, QList<QPair<QString, QString> > &trLst)
+{
+    // 属性没有变化时沿用上次翻译的结果
+    if (src == trSrc)
+        return;
+
+    trLst.clear();
+    trLst.reserve(src.size());
+    for (const auto &pair : src) {
+        QString trKey = translateStr(pair.first);
+        if (trKey.isEmpty())
+            trLst.append(qMakePair(pair.first, pair.second)); // 添加到目标列表
+        else
+            trLst.append(qMakePair(trKey, pair.second));
+    }
+    trSrc = src;
 }
 
 const QString DeviceBaseInfo::nameTr()
@@ -78,36 +157,24 @@ const QList<QPair<QString, QString> > &DeviceBaseInfo::getBaseAttribs()
 
 const QList<QPair<QString, QString> > &DeviceBaseInfo::getOtherTranslationAttribs()
 {
-    m_LstOtherInfoTr.clear();
+    checkTranslationGeneration();
     getOtherAttribs();
-    for (const auto &pair : m_LstOtherInfo) {
-        QString trKey =translateStr(pair.first);
-        if (trKey.isEmpty())
-            m_LstOtherInfoTr.append(qMakePair(pair.first, pair.second)); // 添加到目标列表
-        else
-            m_LstOtherInfoTr.append(qMakePair(trKey, pair.second));
-    }
+    translateAttribs(m_LstOtherInfo, m_LstOtherInfoTrSrc, m_LstOtherInfoTr);
     return m_LstOtherInfoTr;
 }
 
 const QList<QPair<QString, QString> > &DeviceBaseInfo::getBaseTranslationAttribs()
 {
-    m_LstBaseInfoTr.clear();
+    checkTranslationGeneration();
     getBaseAttribs();
-    for (const auto &pair : m_LstBaseInfo) {
-        QString trKey = translateStr(pair.first);
-        if (trKey.isEmpty())
-            m_LstBaseInfoTr.append(qMakePair(pair.first, pair.second)); // 添加到目标列表
-        else
-            m_LstBaseInfoTr.append(qMakePair(trKey, pair.second));
-    }
+    translateAttribs(m_LstBaseInfo, m_LstBaseInfoTrSrc, m_LstBaseInfoTr);
     return m_LstBaseInfoTr;
 }
 
 const QStringList &DeviceBaseInfo::getTableHeader()
 {
-    m_TableHeaderTr.clear();
     qCDebug(appLog) << "DeviceBaseInfo::getTableHeader called.";
+    checkTranslationGeneration();
     // 获取表头
     if (m_TableHeader.size() == 0) {
         qCDebug(appLog) << "Table header is empty, loading.";
@@ -115,12 +182,17 @@ const QStringList &DeviceBaseInfo::getTableHeader()
         m_TableHeader.append(m_CanEnable ? "yes" : "no");
     }
 
-    for (const auto &item : m_TableHeader) {
-        QString trKey = tr(item.toUtf8());
-        if (trKey.isEmpty())
-            m_TableHeaderTr.append(item);
-        else
-            m_TableHeaderTr.append(trKey);
+    // 表头没有变化时沿用上次翻译的结果
+    if (m_TableHeader != m_TableHeaderTrSrc) {
+        m_TableHeaderTr.clear();
+        for (const auto &item : m_TableHeader) {
+            QString trKey = translateStr(item);
+            if (trKey.isEmpty())
+                m_TableHeaderTr.append(item);
+            else
+                m_TableHeaderTr.append(trKey);
+        }
+        m_TableHeaderTrSrc = m_TableHeader;
     }
 
     qCDebug(appLog) << "Table header: " << m_TableHeader;
@@ -133,14 +205,8 @@ const QStringList &DeviceBaseInfo::getTableData()
     // 获取表格数据
     m_TableData.clear();
     loadTableData();
-    m_TableDataTr.clear();
-    for (const auto &item : m_TableData) {
-        QString trKey = item;
-        if (trKey.isEmpty())
-            m_TableDataTr.append(item);
-        else
-            m_TableDataTr.append(trKey);
-    }
+    // 表格内容不需要翻译，与 m_TableData 共享数据
+    m_TableDataTr = m_TableData;
     qCDebug(appLog) << "Table data loaded. Count: " << m_TableData.count();
     return m_TableDataTr;
 }
@@ -307,7 +373,7 @@ void DeviceBaseInfo::subTitleToHTML(QDomDocument &doc)
     }
 }
 
-void DeviceBaseInfo::toDocString(Docx::Document &doc)
+void DeviceBaseInfo::toDocString(Docx::StreamDocument &doc)
 {
     qCDebug(appLog) << "DeviceBaseInfo::toDocString called.";
     // 设备信息转为doc
@@ -316,7 +382,7 @@ void DeviceBaseInfo::toDocString(Docx::Document &doc)
     qCDebug(appLog) << "Doc string conversion finished.";
 }
 
-void DeviceBaseInfo::baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QString> > &infoLst)
+void DeviceBaseInfo::baseInfoToDoc(Docx::StreamDocument &doc, QList<QPair<QString, QString> > &infoLst)
 {
     qCDebug(appLog) << "DeviceBaseInfo::baseInfoToDoc called for info list.";
     // 设备信息保存为Doc
@@ -337,7 +403,7 @@ void DeviceBaseInfo::baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QSt
     qCDebug(appLog) << "Finished adding items to Doc.";
 }
 
-void DeviceBaseInfo::toXlsxString(QXlsx::Document &xlsx, QXlsx::Format &boldFont)
+void DeviceBaseInfo::toXlsxString(QXlsx::StreamWriter &xlsx, QXlsx::Format &boldFont)
 {
     qCDebug(appLog) << "DeviceBaseInfo::toXlsxString called.";
     // 设备信息转为xlxs表格
@@ -346,7 +412,7 @@ void DeviceBaseInfo::toXlsxString(QXlsx::Document &xlsx, QXlsx::Format &boldFont
     qCDebug(appLog) << "Xlsx string conversion finished.";
 }
 
-void DeviceBaseInfo::baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString> > &infoLst)
+void DeviceBaseInfo::baseInfoToXlsx(QXlsx::StreamWriter &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString> > &infoLst)
 {
     qCDebug(appLog) << "DeviceBaseInfo::baseInfoToXlsx called for info list.";
     // 设置表格内容字体不加粗,字号10
@@ -363,11 +429,7 @@ void DeviceBaseInfo::baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFo
             continue;
         }
 
-        // 获取行数
-        int _row = DeviceManager::instance()->currentXlsRow();
-        xlsx.write(_row, 1, item.first, boldFont);
-        xlsx.write(_row, 2, item.second, boldFont);
-        // qCDebug(appLog) << "Written to Xlsx at row " << _row << ": " << item.first << " = " << item.second;
+        xlsx.appendRow(QStringList() << item.first << item.second, boldFont);
     }
     qCDebug(appLog) << "Finished writing items to Xlsx.";
 }
@@ -510,15 +572,10 @@ void DeviceBaseInfo::tableHeaderToHtml(QFile &html)
     qCDebug(appLog) << "Finished writing table header to HTML.";
 }
 
-void DeviceBaseInfo::tableInfoToDoc(Docx::Table *tab, int &row)
+void DeviceBaseInfo::tableInfoToDoc(Docx::StreamDocument &doc)
 {
-    qCDebug(appLog) << "DeviceBaseInfo::tableInfoToDoc called with row: " << row;
+    qCDebug(appLog) << "DeviceBaseInfo::tableInfoToDoc called.";
     // 表格信息保存为Doc
-    if (nullptr == tab) {
-        qCDebug(appLog) << "Table pointer is null, returning.";
-        return;
-    }
-
     // 获取表格数据
     getTableData();
 
@@ -527,16 +584,12 @@ void DeviceBaseInfo::tableInfoToDoc(Docx::Table *tab, int &row)
         return;
     }
 
-    // 添加doc表格
-    for (int col = 0; col < m_TableDataTr.size(); ++col) {
-        auto cel = tab->cell(row, col);
-        cel->addText(m_TableDataTr[col]);
-        // qCDebug(appLog) << "Added table info to Doc cell (" << row << ", " << col << "): " << m_TableDataTr[col];
-    }
+    // 添加doc表格行
+    doc.addTableRow(m_TableDataTr);
     qCDebug(appLog) << "Finished adding table info to Doc.";
 }
 
-void DeviceBaseInfo::tableHeaderToDoc(Docx::Table *tab)
+void DeviceBaseInfo::tableHeaderToDoc(Docx::StreamDocument &doc)
 {
     qCDebug(appLog) << "DeviceBaseInfo::tableHeaderToDoc called.";
     // 表头保存为doc
@@ -547,17 +600,12 @@ void DeviceBaseInfo::tableHeaderToDoc(Docx::Table *tab)
         return;
     }
 
-    // 添加表头信息
-    for (int col = 0; col < m_TableHeaderTr.size() - 1; ++col)  {
-        tab->addColumn();
-        auto cel = tab->cell(0, col);
-        cel->addText(m_TableHeaderTr[col]);
-        // qCDebug(appLog) << "Added table header to Doc cell (0, " << col << "): " << m_TableHeaderTr[col];
-    }
+    // 添加表头信息，最后一列不导出
+    doc.beginTable(m_TableHeaderTr.mid(0, m_TableHeaderTr.size() - 1));
     qCDebug(appLog) << "Finished adding table header to Doc.";
 }
 
-void DeviceBaseInfo::tableInfoToXlsx(QXlsx::Document &xlsx)
+void DeviceBaseInfo::tableInfoToXlsx(QXlsx::StreamWriter &xlsx)
 {
     qCDebug(appLog) << "DeviceBaseInfo::tableInfoToXlsx called.";
     // 获取表格信息
@@ -569,15 +617,11 @@ void DeviceBaseInfo::tableInfoToXlsx(QXlsx::Document &xlsx)
     }
 
     // 添加表格信息
-    int curRow = DeviceManager::instance()->currentXlsRow();
-    for (int col = 0; col < m_TableDataTr.size(); ++col) {
-        xlsx.write(curRow, col + 1, m_TableDataTr[col]);
-        // qCDebug(appLog) << "Written table info to Xlsx at row " << curRow << ", col " << col + 1 << ": " << m_TableDataTr[col];
-    }
+    xlsx.appendRow(m_TableDataTr);
     qCDebug(appLog) << "Finished writing table info to Xlsx.";
 }
 
-void DeviceBaseInfo::tableHeaderToXlsx(QXlsx::Document &xlsx)
+void DeviceBaseInfo::tableHeaderToXlsx(QXlsx::StreamWriter &xlsx)
 {
     qCDebug(appLog) << "DeviceBaseInfo::tableHeaderToXlsx called.";
     // 获取表头
@@ -589,14 +633,11 @@ void DeviceBaseInfo::tableHeaderToXlsx(QXlsx::Document &xlsx)
     }
 
     // 添加表头信息
-    int curRow = DeviceManager::instance()->currentXlsRow();
-    for (int col = 0; col < m_TableHeaderTr.size() - 1; ++col) {
-        QXlsx::Format boldFont;
-        boldFont.setFontSize(10);
-        boldFont.setFontBold(true);
-        xlsx.write(curRow, col + 1, m_TableHeaderTr[col], boldFont);
-        // qCDebug(appLog) << "Written table header to Xlsx at row " << curRow << ", col " << col + 1 << ": " << m_TableHeaderTr[col];
-    }
+    // 最后一列不导出
+    QXlsx::Format boldFont;
+    boldFont.setFontSize(10);
+    boldFont.setFontBold(true);
+    xlsx.appendRow(m_TableHeaderTr.mid(0, m_TableHeaderTr.size() - 1), boldFont);
     qCDebug(appLog) << "Finished writing table header to Xlsx.";
 }
 
@@ -681,13 +722,81 @@ bool DeviceBaseInfo::driverIsKernelIn(const QString &driver)
         return false;
     }
 
-    // 判断lsmod是否能查询
-    QString outInfo = Common::executeClientCmd("modinfo", QStringList() << driver, QString(), -1);
-    bool isKernelIn = !outInfo.contains("filename:");
-    qCDebug(appLog) << "Driver: " << driver << ", modinfo output contains filename: " << !isKernelIn << ", returning: " << isKernelIn;
+    // 找不到模块文件的驱动属于核内驱动
+    ModuleInfo info = moduleInfo(driver);
+    bool isKernelIn = info.path.isEmpty();
+    qCDebug(appLog) << "Driver: " << driver << ", module path: " << info.path << ", returning: " << isKernelIn;
     return isKernelIn;
 }
 
+// 驱动模块查询结果缓存，同一模块会被多个设备查询，刷新设备时清空
+static QMap<QString, ModuleInfo> s_ModuleInfo;
+static QMutex s_ModuleMutex;
+static struct kmod_ctx *s_Ctx = nullptr;
+
+ModuleInfo DeviceBaseInfo::moduleInfo(const QString &module)
+{
+    QMutexLocker locker(&s_ModuleMutex);
+    auto it = s_ModuleInfo.constFind(module);
+    if (it != s_ModuleInfo.constEnd())
+        return *it;
+
+    ModuleInfo info;
+    if (!s_Ctx) {
+        s_Ctx = kmod_new(nullptr, nullptr);
+        if (!s_Ctx) {
+            qCWarning(appLog) << "kmod_new() failed!";
+            return info;
+        }
+        kmod_load_resources(s_Ctx);
+    }
+
+    // 与 modinfo 相同，按模块名或别名查找
+    struct kmod_list *modlist = nullptr;
+    if (kmod_module_new_from_lookup(s_Ctx, module.toStdString().c_str(), &modlist) < 0 || !modlist) {
+        qCDebug(appLog) << "Module not found: " << module;
+        s_ModuleInfo.insert(module, info);
+        return info;
+    }
+
+    struct kmod_module *mod = kmod_module_get_module(modlist);
+    info.found = true;
+    info.builtIn = KMOD_MODULE_BUILTIN == kmod_module_get_initstate(mod);
+    if (!info.builtIn)
+        info.path = QString(kmod_module_get_path(mod));
+
+    struct kmod_list *infolist = nullptr;
+    if (kmod_module_get_info(mod, &infolist) >= 0) {
+        struct kmod_list *itr = nullptr;
+        kmod_list_foreach(itr, infolist) {
+            QString key = kmod_module_info_get_key(itr);
+            if ("version" == key)
+                info.version = QString(kmod_module_info_get_value(itr)).trimmed();
+            else if ("signer" == key)
+                info.signer = QString(kmod_module_info_get_value(itr)).trimmed();
+        }
+        kmod_module_info_free_list(infolist);
+    }
+
+    kmod_module_unref(mod);
+    kmod_module_unref_list(modlist);
+    s_ModuleInfo.insert(module, info);
+    return info;
+}
+
+void DeviceBaseInfo::clearModuleInfo()
+{
+    QMutexLocker locker(&s_ModuleMutex);
+    s_ModuleInfo.clear();
+
+    // 安装或卸载驱动后 depmod 会更新模块索引，与 ModCore 相同，索引变化时重新创建上下文
+    if (s_Ctx && KMOD_RESOURCES_OK != kmod_validate_resources(s_Ctx)) {
+        qCDebug(appLog) << "Module indexes changed, recreating kmod context";
+        kmod_unref(s_Ctx);
+        s_Ctx = nullptr;
+    }
+}
+
 void DeviceBaseInfo::setCanEnable(bool can)
 {
     // qCDebug(appLog) << "DeviceBaseInfo::setCanEnale called with can: " << can;
@@ -746,6 +855,11 @@ const QString &DeviceBaseInfo::sysPath() const
     return m_SysPath;
 }
 
+const QString &DeviceBaseInfo::hwinfoLshwKey() const
+{
+    return m_HwinfoToLshw;
+}
+
 const QString DeviceBaseInfo::getVendorOrModelId(const QString &sysPath, bool flag)
 {
     qCDebug(appLog) << "DeviceBaseInfo::getVendorOrModelId called with sysPath: " << sysPath << ", flag: " << flag;
@@ -788,43 +902,26 @@ const QString DeviceBaseInfo::getVendorOrModelId(const QString &sysPath, bool fl
 void DeviceBaseInfo::setVendorNameBylsusbLspci(const QString &vidpid, const QString &modalias)
 {
     if (!vidpid.isEmpty() && modalias.contains("usb")) {
-        QProcess process;
         QString vendorId = vidpid.toLower().remove("0x").trimmed().left(4);
         QString deviceId = vidpid.toLower().remove("0x").trimmed().right(4);
-        process.start("lsusb", QStringList() << "-v" << "-d" << QString("%1:%2").arg(vendorId, deviceId));
-        process.waitForFinished(-1);
-
-        QString output = process.readAllStandardOutput();
 
-        foreach (QString out, output.split("\n")) {
-            // 从USB设备获取制造商和设备名称
-            if (out.contains("idVendor", Qt::CaseSensitive)) {
-                m_Vendor = out.remove(0, out.indexOf(vendorId) + 4).trimmed();
-            } else if (out.contains("idProduct", Qt::CaseSensitive)) {
-                m_Name = out.remove(0, out.indexOf(deviceId) + 4).trimmed();
-            }
-        }
+        // 从usb.ids获取制造商和设备名称，与 lsusb 显示的名称一致
+        QString vendor = HwIdResolver::instance().vendorName(HwIdResolver::IT_Usb, vendorId);
+        if (!vendor.isEmpty())
+            m_Vendor = vendor;
+        QString name = HwIdResolver::instance().productName(HwIdResolver::IT_Usb, vendorId, deviceId);
+        if (!name.isEmpty())
+            m_Name = name;
     }
 }
 
 const QString DeviceBaseInfo::getDriverVersion()
 {
     qCDebug(appLog) << "DeviceBaseInfo::getDriverVersion called.";
-    QString outInfo = Common::executeClientCmd("modinfo", QStringList() << driver(), QString(), -1);
-    if (outInfo.isEmpty()) {
-        qCDebug(appLog) << "Modinfo output is empty, returning empty string.";
-        return  QString("");
-    }
+    if (driver().isEmpty())
+        return QString("");
 
-    foreach (QString out, outInfo.split("\n")) {
-        QStringList item = out.split(":", QT_SKIP_EMPTY_PARTS);
-        if (!item.isEmpty() && "version" == item[0].trimmed()) {
-            // qCDebug(appLog) << "Found driver version: " << item[1].trimmed();
-            return item[1].trimmed();
-        }
-    }
-    qCDebug(appLog) << "Driver version not found, returning empty string.";
-    return QString("");
+    return moduleInfo(driver()).version;
 }
 
 const QString DeviceBaseInfo::getOverviewInfo()
@@ -1476,3 +1573,23 @@ void DeviceBaseInfo::setUniqueID(const QString &UniqueID)
 {
     m_UniqueID = UniqueID;
 }
+
+void DeviceBaseInfo::saveSnapshot(QDataStream &out) const
+{
+    out << m_Name << m_Vendor << m_PhysID << m_VID_PID << m_VID << m_PID << m_Modalias
+        << m_Version << m_Description << m_UniqueID << m_SerialID << m_SysPath
+        << m_HardwareClass << m_HwinfoToLshw << m_Enable << m_CanEnable << m_CanUninstall
+        << m_Available << m_forcedDisplay << qint32(m_Index) << m_PhysIDMap << m_Driver
+        << m_MapOtherInfo;
+}
+
+void DeviceBaseInfo::loadSnapshot(QDataStream &in)
+{
+    qint32 index = 0;
+    in >> m_Name >> m_Vendor >> m_PhysID >> m_VID_PID >> m_VID >> m_PID >> m_Modalias
+       >> m_Version >> m_Description >> m_UniqueID >> m_SerialID >> m_SysPath
+       >> m_HardwareClass >> m_HwinfoToLshw >> m_Enable >> m_CanEnable >> m_CanUninstall
+       >> m_Available >> m_forcedDisplay >> index >> m_PhysIDMap >> m_Driver
+       >> m_MapOtherInfo;
+    m_Index = index;
+}
@@ -6,9 +6,8 @@
 #ifndef DEVICEINFO_H
 #define DEVICEINFO_H
 
-#include "document.h"
-#include "xlsxdocument.h"
-#include "table.h"
+#include "streamdocument.h"
+#include "xlsxstreamwriter.h"
 #include "DeviceManager.h"
 
 #include <QString>
@@ -19,6 +18,7 @@
 #include <QPair>
 #include <QDomDocument>
 #include <QFile>
+#include <QDataStream>
 
 /**
  * @brief The EnableDeviceStatus enum
@@ -31,6 +31,18 @@ enum EnableDeviceStatus {
     EDS_Success
 };
 
+/**
+ * @brief The ModuleInfo struct
+ * 通过 libkmod 查询到的驱动模块信息，等同于 modinfo 的输出
+ */
+struct ModuleInfo {
+    bool    found = false;      //<! 是否找到模块
+    bool    builtIn = false;    //<! 是否编译进内核
+    QString path;               //<! 模块文件路径，内建模块为空
+    QString version;            //<! 模块版本
+    QString signer;             //<! 模块签名者
+};
+
 /**
  * @brief The DeviceBaseInfo class
  * 各个摄像头描述类的基类
@@ -45,6 +57,11 @@ public:
 
     const QString translateStr(const QString &inStr);
     const QString nameTr();
+
+    /**
+     * @brief clearTranslationCache:清空翻译缓存，重新加载翻译文件后调用
+     */
+    static void clearTranslationCache();
     /**
      * @brief name:获取设备名称
      * @return 设备名称
@@ -163,6 +180,18 @@ public:
      */
     virtual bool driverIsKernelIn(const QString &driver);
 
+    /**
+     * @brief moduleInfo 查询驱动模块信息，同一模块只查询一次
+     * @param module 模块名称或别名
+     * @return 模块信息
+     */
+    static ModuleInfo moduleInfo(const QString &module);
+
+    /**
+     * @brief clearModuleInfo 清空驱动模块信息缓存，刷新设备时调用
+     */
+    static void clearModuleInfo();
+
     /**
      * @brief setCanEnable : set can enable or not
      * @param can
@@ -216,6 +245,12 @@ public:
      */
     const QString &sysPath() const;
 
+    /**
+     * @brief hwinfoLshwKey:获取匹配hwinfo和lshw的key
+     * @return
+     */
+    const QString &hwinfoLshwKey() const;
+
     /**
      * @brief getVendorOrModelId:获取Vendor 或 Model Id
      * @param sysPath 属性sysFS ID
@@ -294,29 +329,29 @@ public:
      * @brief toDocString:导出信息为html格式
      * @param doc:doc文档
      */
-    void toDocString(Docx::Document &doc);
+    void toDocString(Docx::StreamDocument &doc);
 
     /**
      * @brief baseInfoToDoc:基本信息导出doc
      * @param doc:doc文档
      * @param infoLst:信息列表
      */
-    void baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QString>> &infoLst);
+    void baseInfoToDoc(Docx::StreamDocument &doc, QList<QPair<QString, QString>> &infoLst);
 
     /**
      * @brief toXlsxString:导出信息为xlsx格式
-     * @param xlsx:xlsx文档
+     * @param xlsx:按行写入的xlsx文件
      * @param boldFontc:字体格式
      */
-    void toXlsxString(QXlsx::Document &xlsx, QXlsx::Format &boldFont);
+    void toXlsxString(QXlsx::StreamWriter &xlsx, QXlsx::Format &boldFont);
 
     /**
      * @brief baseInfoToXlsx:基本信息导出xlsx
-     * @param xlsx:xlsx文档
+     * @param xlsx:按行写入的xlsx文件
      * @param boldFont:字体格式
      * @param infoLst:信息列表
      */
-    void baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString>> &infoLst);
+    void baseInfoToXlsx(QXlsx::StreamWriter &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString>> &infoLst);
 
     /**
      * @brief toTxtString:导出信息为txt格式
@@ -357,28 +392,27 @@ public:
 
     /**
      * @brief tableInfoToDoc:表格信息写到doc
-     * @param tab:doc文档表格
-     * @param row:表格行数，第row行
+     * @param doc:doc文档，当前表格追加一行
      */
-    void tableInfoToDoc(Docx::Table *tab, int &row);
+    void tableInfoToDoc(Docx::StreamDocument &doc);
 
     /**
      * @brief tableHeaderToDoc:表头信息写到doc
-     * @param tab doc文档的表格
+     * @param doc:doc文档，以表头开始一个表格
      */
-    void tableHeaderToDoc(Docx::Table *tab);
+    void tableHeaderToDoc(Docx::StreamDocument &doc);
 
     /**
      * @brief tableInfoToXlsx:表格信息写到xlsx
      * @param xlsx xlsx文件
      */
-    void tableInfoToXlsx(QXlsx::Document &xlsx);
+    void tableInfoToXlsx(QXlsx::StreamWriter &xlsx);
 
     /**
      * @brief tableHeaderToXlsx:表头信息写到xlsx
      * @param xlsx xlsx文件
      */
-    void tableHeaderToXlsx(QXlsx::Document &xlsx);
+    void tableHeaderToXlsx(QXlsx::StreamWriter &xlsx);
 
     /**
      * @brief setOtherDeviceInfo:设置其他信息信息
@@ -397,6 +431,18 @@ public:
     void setUniqueID(const QString &UniqueID);
     void setSysPath(const QString &newSysPath);
 
+    /**
+     * @brief saveSnapshot:将设备属性写入快照，子类需先调用基类再写入自己的属性
+     * @param out:快照数据流
+     */
+    virtual void saveSnapshot(QDataStream &out) const;
+
+    /**
+     * @brief loadSnapshot:从快照中读取设备属性，读取顺序与 saveSnapshot 一致
+     * @param in:快照数据流
+     */
+    virtual void loadSnapshot(QDataStream &in);
+
 protected:
     /**
      * @brief:初始化过滤信息
@@ -505,6 +551,25 @@ protected:
 private:
     void generatorTranslate();
 
+    /**
+     * @brief translationGeneration:获取翻译缓存的版本，语言变化时版本增加
+     * @return 翻译缓存的版本
+     */
+    static int translationGeneration();
+
+    /**
+     * @brief checkTranslationGeneration:翻译缓存版本变化时丢弃已翻译的列表
+     */
+    void checkTranslationGeneration();
+
+    /**
+     * @brief translateAttribs:属性列表变化时重新翻译
+     * @param src:当前的属性列表
+     * @param trSrc:上次翻译时的属性列表
+     * @param trLst:翻译后的属性列表
+     */
+    void translateAttribs(const QList<QPair<QString, QString>> &src, QList<QPair<QString, QString>> &trSrc, QList<QPair<QString, QString>> &trLst);
+
 protected:
     QString            m_Name;         //<! 【名称】
     QString            m_Vendor;       //<! 【制造商
@@ -525,8 +590,12 @@ protected:
     QList<QPair<QString, QString>> m_LstOtherInfo;  //<! 其它信息
     QList<QPair<QString, QString>> m_LstBaseInfoTr;   //<! 基本信息 翻译后的
     QList<QPair<QString, QString>> m_LstOtherInfoTr;  //<! 其它信息 翻译后的
+    QList<QPair<QString, QString>> m_LstBaseInfoTrSrc;  //<! 生成 m_LstBaseInfoTr 时的基本信息
+    QList<QPair<QString, QString>> m_LstOtherInfoTrSrc; //<! 生成 m_LstOtherInfoTr 时的其它信息
     QStringList                    m_TableHeader;   //<! 用于存放表格的表头
     QStringList                    m_TableHeaderTr;   //<! 用于存放表格的表头 翻译后的
+    QStringList                    m_TableHeaderTrSrc;  //<! 生成 m_TableHeaderTr 时的表头
+    int                            m_TrGeneration;      //<! 已翻译列表对应的翻译缓存版本
     QStringList                    m_TableDataTr;     //<! 用于存放表格的内容  翻译后的
     QStringList                    m_TableData;     //<! 用于存放表格的内容
     QSet<QString>                  m_FilterKey;     //<! 用于避免添加重复信息
@@ -10,6 +10,8 @@
 #include "DBusWakeupInterface.h"
 #include "DDLog.h"
 #include "commondefine.h"
+#include "InputDeviceParser.h"
+#include "DBusBluezInterface.h"
 
 // Qt库文件
 #include <QLoggingCategory>
@@ -260,48 +262,17 @@ bool DeviceInput::getPS2Syspath(const QString &dfs)
         return false;
     }
 
-    QFile file("/proc/bus/input/devices");
-    if (!file.open(QIODevice::ReadOnly)) {
-        qCDebug(appLog) << "Failed to open /proc/bus/input/devices. Returning false.";
+    QList<InputDeviceRecord> devices = InputDeviceParser::devices();
+    if (devices.isEmpty()) {
+        qCDebug(appLog) << "Failed to read /proc/bus/input/devices. Returning false.";
         return false;
     }
 
-    QString info = file.readAll();
-    qCDebug(appLog) << "Successfully read /proc/bus/input/devices.";
-    QStringList lstDevices = info.split("\n\n");
-    foreach (const QString &item, lstDevices) {
-        // qCDebug(appLog) << "Processing device item: " << item.left(50) << "...";
-        QStringList lines = item.split("\n");
-        QString sysfs = "";
-        QString event = "";
-        foreach (const QString &line, lines) {
-            if (line.startsWith("S:")) {
-                sysfs = line;
-                // qCDebug(appLog) << "Found sysfs line: " << sysfs;
-                continue;
-            }
-            QRegularExpression reg("H: Handlers=.*(event[0-9]{1,2}).*");
-            QRegularExpressionMatch match = reg.match(line);
-            if (match.hasMatch()) {
-                event = match.captured(1);
-                // qCDebug(appLog) << "Matched event using QRegularExpression: " << event;
-            }
-        }
-
-        if (!event.isEmpty() && !sysfs.isEmpty()) {
-            // qCDebug(appLog) << "Event and sysfs are not empty. Checking for match.";
-            if (event == eventdfs) {
-                QRegularExpression regfs;
-                if (sysfs.contains("i2c_designware"))
-                    regfs = QRegularExpression("S: Sysfs=(.*)/input/input[0-9]{1,2}");
-                else
-                    regfs = QRegularExpression("S: Sysfs=(.*)/input[0-9]{1,2}");
-                QRegularExpressionMatch match = regfs.match(sysfs);
-                if (match.hasMatch()) {
-                    m_SysPath = match.captured(1);
-                }
-            }
-        }
+    InputDeviceRecord record;
+    if (InputDeviceParser::findByEvent(devices, eventdfs, record) && !record.sysfs.isEmpty()) {
+        QString sysPath = InputDeviceParser::ps2SysPath(record.sysfs);
+        if (!sysPath.isEmpty())
+            m_SysPath = sysPath;
     }
 
     qCDebug(appLog) << "getPS2Syspath end";
@@ -318,45 +289,28 @@ bool DeviceInput::isBluetoothDevice(const QString &dfs)
         return false;
     }
 
-    QFile file("/proc/bus/input/devices");
-    if (!file.open(QIODevice::ReadOnly)) {
-        qCDebug(appLog) << "open file failed";
-        return false;
-    }
-
-    QString info = file.readAll();
-    QStringList lstDevices = info.split("\n\n");
-    foreach (const QString &item, lstDevices) {
-        QStringList lines = item.split("\n");
-        QString Uniq = "";
-        QString event = "";
-        foreach (const QString &line, lines) {
-            if (line.startsWith("U:")) {
-                Uniq = line;
-                continue;
-            }
-            QRegularExpression reg("H: Handlers=.*(event[0-9]{1,2}).*");
-            QRegularExpressionMatch match = reg.match(line);
-            if (match.hasMatch()) {
-                event = match.captured(1);
-            }
-        }
-
-        if (event == eventdfs) {
-            QRegularExpression regUniq(".*([0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}).*");
-            QRegularExpressionMatch match = regUniq.match(Uniq);
-            if (match.hasMatch()) {
-                QString id = match.captured(1);
-                QProcess process;
-                process.start("hcitool con");
-                process.waitForFinished(-1);
-                QString hciInfo = process.readAllStandardOutput();
-                if (!hciInfo.contains(id))
+    InputDeviceRecord record;
+    if (InputDeviceParser::findByEvent(InputDeviceParser::devices(), eventdfs, record)) {
+        QRegularExpression regUniq(".*([0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}:[0-9A-Z]{2}).*");
+        QRegularExpressionMatch match = regUniq.match(record.uniq);
+        if (match.hasMatch()) {
+            QString id = match.captured(1);
+            DBusBluezInterface *bluez = DBusBluezInterface::getInstance();
+            if (bluez->isValid()) {
+                if (!bluez->isConnected(id))
                     m_BluetoothIsConnected = false;
-                qCDebug(appLog) << "id:" << id << "hciInfo:" << hciInfo << "m_BluetoothIsConnected:" << m_BluetoothIsConnected;
+                qCDebug(appLog) << "id:" << id << "m_BluetoothIsConnected:" << m_BluetoothIsConnected;
                 return true;
             }
-            break;
+
+            QProcess process;
+            process.start("hcitool con");
+            process.waitForFinished(-1);
+            QString hciInfo = process.readAllStandardOutput();
+            if (!hciInfo.contains(id))
+                m_BluetoothIsConnected = false;
+            qCDebug(appLog) << "id:" << id << "hciInfo:" << hciInfo << "m_BluetoothIsConnected:" << m_BluetoothIsConnected;
+            return true;
         }
     }
 
@@ -420,55 +374,15 @@ InputDeviceBusInfo DeviceInput::getDetailBusInfo(const QString &busId)
 
 void DeviceInput::getMouseInfoFromBusDevice()
 {
-    QProcess process;
-    process.start("cat", QStringList() << "/proc/bus/input/devices");
-    process.waitForFinished(10000);
-    QString rawContent = process.readAllStandardOutput();
-
-    QMap<QString, QString> nameToBusMap;
-
-    if (rawContent.isEmpty()) {
-        return ;
-    }
-
-    QStringList deviceBlocks = rawContent.split("\n\n", QT_SKIP_EMPTY_PARTS);
-
-    for (const QString &block : deviceBlocks) {
-        QString bus, name;
-        QStringList lines = block.split("\n", QT_SKIP_EMPTY_PARTS);
-
-        for (const QString &line : lines) {
-            QString trimmedLine = line.trimmed();
-
-            // 提取 Bus 信息 (I: Bus=0019 ...)
-            if (trimmedLine.startsWith("I:") && trimmedLine.contains("Bus=")) {
-                QRegularExpression busRegex("Bus=([0-9a-fA-F]+)");
-                QRegularExpressionMatch match = busRegex.match(trimmedLine);
-                if (match.hasMatch()) {
-                    bus = match.captured(1);
-                }
-            }
-
-            // 提取 Name 信息 (N: Name="Sleep Button")
-            if (trimmedLine.startsWith("N:") && trimmedLine.contains("Name=")) {
-                QRegularExpression nameRegex("Name=\"([^\"]+)\"");
-                QRegularExpressionMatch match = nameRegex.match(trimmedLine);
-                if (match.hasMatch()) {
-                    name = match.captured(1);
-                }
-            }
-        }
-
-        // 如果同时找到了 name 和 bus，则添加到映射中
-        if (!name.isEmpty() && !bus.isEmpty()) {
-            nameToBusMap.insert(name, bus);
-        }
+    // 同名设备以最后一个为准
+    QString busID;
+    foreach (const InputDeviceRecord &record, InputDeviceParser::devices()) {
+        if (!record.name.isEmpty() && record.name == m_Name)
+            busID = record.busId();
     }
 
-    if (nameToBusMap.contains(m_Name)) {
-        QString busID = nameToBusMap.value(m_Name);
+    if (!busID.isEmpty())
         m_Interface = getDetailBusInfo(busID).interfaceType;
-    }
 }
 
 QString DeviceInput::getBusInfo() const
@@ -769,3 +683,18 @@ void DeviceInput::loadTableData()
     qCDebug(appLog) << "loadTableData end";
 }
 
+void DeviceInput::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_Interface << m_BusInfo << m_Capabilities << m_MaximumPower << m_Speed
+        << m_KeyToLshw << m_WakeupID << m_BluetoothIsConnected << m_wakeupChanged
+        << m_keysToPairedDevice;
+}
+
+void DeviceInput::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_Interface >> m_BusInfo >> m_Capabilities >> m_MaximumPower >> m_Speed
+       >> m_KeyToLshw >> m_WakeupID >> m_BluetoothIsConnected >> m_wakeupChanged
+       >> m_keysToPairedDevice;
+}
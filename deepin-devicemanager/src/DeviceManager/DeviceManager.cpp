@@ -11,7 +11,10 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QMutexLocker>
-#include <QProcess>
+#include <QDir>
+#include <QLocale>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 // 其它头文件
 #include "DeviceCpu.h"
@@ -32,18 +35,24 @@
 #include "DeviceCdrom.h"
 #include "DeviceInput.h"
 #include "MacroDefinition.h"
+#include "HwIdResolver.h"
+#include "DBusBluezInterface.h"
 #include <QRegularExpression>   
 #include <algorithm> // for std::sort
 
 using namespace DDLog;
 
 DeviceManager    *DeviceManager::sInstance = nullptr;
-int DeviceManager::m_CurrentXlsRow = 1;
 
 static QMutex addCmdMutex;
 
+static const quint32 SnapshotMagic = 0x44444d53;    // 快照文件标识
+static const quint32 SnapshotVersion = 1;           // 设备类的快照字段变化时需要增加版本号
+
 DeviceManager::DeviceManager()
     : m_CpuNum(1)
+    , m_SnapshotCpuNum(0)
+    , m_Loading(false)
 {
     qCDebug(appLog) << "DeviceManager constructor initialized";
 }
@@ -52,6 +61,7 @@ DeviceManager::~DeviceManager()
 {
     qCDebug(appLog) << "DeviceManager destructor started";
     clear();
+    releaseRetiredDevices();
 }
 
 void DeviceManager::clear()
@@ -61,84 +71,34 @@ void DeviceManager::clear()
     // 清除所有命令
     m_cmdInfo.clear();
 
-    // 清除内存中的所有设备指针
-    foreach (auto device, m_ListDeviceMouse)
-        delete device;
-
-    foreach (auto device, m_ListDeviceStorage)
-        delete device;
-
-    foreach (auto device, m_ListDeviceMonitor)
-        delete device;
-
-    foreach (auto device, m_ListDeviceBluetooth)
-        delete device;
-
-    foreach (auto device, m_ListDeviceAudio)
-        delete device;
-
-    foreach (auto device, m_ListDeviceImage)
-        delete device;
-
-    foreach (auto device, m_ListDeviceKeyboard)
-        delete device;
-
-    foreach (auto device, m_ListDeviceOthers)
-        delete device;
-
-    foreach (auto device, m_ListDevicePower)
-        delete device;
-
-    foreach (auto device, m_ListDevicePrint)
-        delete device;
-
-    foreach (auto device, m_ListDeviceOtherPCI)
-        delete device;
-
-    foreach (auto device, m_ListDeviceCdrom)
-        delete device;
-
-    foreach (auto device, m_ListDeviceComputer)
-        delete device;
-
-    foreach (auto device, m_ListDeviceNetwork)
-        delete device;
-
-    foreach (auto device, m_ListDeviceBios)
-        delete device;
-
-    foreach (auto device, m_ListDeviceGPU)
-        delete device;
-
-    foreach (auto device, m_ListDeviceMemory)
-        delete device;
-
-    foreach (auto device, m_ListDeviceCPU)
-        delete device;
-
-    // 清空存储设备指针的列表
-    m_ListDeviceMouse.clear();
-    m_ListDeviceStorage.clear();
-    m_ListDeviceMonitor.clear();
-    m_ListDeviceBluetooth.clear();
-    m_ListDeviceAudio.clear();
-    m_ListDeviceImage.clear();
-    m_ListDeviceKeyboard.clear();
-    m_ListDeviceOthers.clear();
-    m_ListDevicePower.clear();
-    m_ListDevicePrint.clear();
-    m_ListDeviceOtherPCI.clear();
-    m_ListDeviceCdrom.clear();
-    m_ListDeviceComputer.clear();
-    m_ListDeviceNetwork.clear();
-    m_ListDeviceBios.clear();
-    m_ListDeviceGPU.clear();
-    m_ListDeviceMemory.clear();
-    m_ListDeviceCPU.clear();
+    // 界面可能还在显示这些设备，先保留，由 restoreUnchangedDevices 复用或 releaseRetiredDevices 释放
+    for (int type = DT_Audio; type <= DT_Others; ++type) {
+        DeviceType deviceType = static_cast<DeviceType>(type);
+        QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
+        // 已有保留的设备时，当前设备还没有显示过，可以直接释放
+        if (m_RetiredDevices.contains(deviceType))
+            qDeleteAll(*lst);
+        else
+            m_RetiredDevices.insert(deviceType, *lst);
+        lst->clear();
+    }
+    clearDeviceIndex();
     m_DeviceClassMap.clear();
+    // 驱动可能已被安装或卸载，重新查询模块信息
+    DeviceBaseInfo::clearModuleInfo();
     qCDebug(appLog) << "All device resources cleared successfully";
 }
 
+void DeviceManager::setLoading(bool loading)
+{
+    m_Loading = loading;
+}
+
+bool DeviceManager::isLoading() const
+{
+    return m_Loading;
+}
+
 const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
 {
     qCDebug(appLog) << "Getting device types";
@@ -428,6 +388,163 @@ DeviceBaseInfo *DeviceManager::createDevice(DeviceType deviceType)
     return vTemp;
 }
 
+QString DeviceManager::snapshotPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/device-snapshot.dat";
+}
+
+bool DeviceManager::loadSnapshot(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCDebug(appLog) << "No device snapshot:" << filePath;
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_11);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != SnapshotMagic || version != SnapshotVersion) {
+        qCWarning(appLog) << "Device snapshot version mismatch:" << version;
+        return false;
+    }
+
+    // 快照中有生成设备时翻译的文字，语言变化后不再使用
+    QString locale;
+    qint32 cpuNum = 1;
+    qint32 typeCount = 0;
+    in >> locale >> cpuNum >> typeCount;
+    if (locale != QLocale::system().name()) {
+        qCDebug(appLog) << "Device snapshot locale changed:" << locale;
+        return false;
+    }
+
+    QMap<DeviceType, QByteArray> mapData;
+    QMap<DeviceType, QList<DeviceBaseInfo *>> mapDevice;
+    bool ok = true;
+    for (int i = 0; i < typeCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 type = DT_Null;
+        QByteArray data;
+        in >> type >> data;
+        QList<DeviceBaseInfo *> lst;
+        if (type <= DT_Null || type > DT_Others || !loadSnapshotData(static_cast<DeviceType>(type), data, lst)) {
+            ok = false;
+            break;
+        }
+        mapData.insert(static_cast<DeviceType>(type), data);
+        mapDevice.insert(static_cast<DeviceType>(type), lst);
+    }
+
+    if (!ok || in.status() != QDataStream::Ok) {
+        qCWarning(appLog) << "Device snapshot is damaged:" << filePath;
+        foreach (const QList<DeviceBaseInfo *> &lst, mapDevice)
+            qDeleteAll(lst);
+        return false;
+    }
+
+    for (auto iter = mapDevice.begin(); iter != mapDevice.end(); ++iter) {
+        *convertDeviceListAddr(iter.key()) = iter.value();
+        m_DeviceIndex[iter.key()].rebuild(iter.value());
+    }
+    m_SnapshotData = mapData;
+    m_CpuNum = cpuNum;
+    m_SnapshotCpuNum = cpuNum;
+    qCInfo(appLog) << "Device snapshot loaded:" << filePath;
+    return true;
+}
+
+bool DeviceManager::saveSnapshot(const QString &filePath)
+{
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(appLog) << "Failed to write device snapshot:" << filePath;
+        return false;
+    }
+
+    m_SnapshotData.clear();
+    for (int type = DT_Audio; type <= DT_Others; ++type)
+        m_SnapshotData.insert(static_cast<DeviceType>(type), snapshotData(static_cast<DeviceType>(type)));
+    m_SnapshotCpuNum = m_CpuNum;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_11);
+    out << SnapshotMagic << SnapshotVersion << QLocale::system().name() << qint32(m_CpuNum) << qint32(m_SnapshotData.size());
+    for (auto iter = m_SnapshotData.begin(); iter != m_SnapshotData.end(); ++iter)
+        out << qint32(iter.key()) << iter.value();
+
+    return file.commit();
+}
+
+bool DeviceManager::restoreUnchangedDevices()
+{
+    bool changed = m_CpuNum != m_SnapshotCpuNum;
+    for (int type = DT_Audio; type <= DT_Others; ++type) {
+        DeviceType deviceType = static_cast<DeviceType>(type);
+        QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
+        QByteArray data = snapshotData(deviceType);
+
+        auto iter = m_SnapshotData.find(deviceType);
+        if (iter != m_SnapshotData.end() && iter.value() == data
+                && m_RetiredDevices.value(deviceType).size() == lst->size()) {
+            // 与界面正在显示的设备完全相同，继续使用原来的设备，界面不需要更新
+            qDeleteAll(*lst);
+            *lst = m_RetiredDevices.take(deviceType);
+            m_DeviceIndex[deviceType].rebuild(*lst);
+            continue;
+        }
+
+        qCDebug(appLog) << "Devices changed, deviceType:" << deviceType;
+        m_SnapshotData[deviceType] = data;
+        changed = true;
+    }
+    m_SnapshotCpuNum = m_CpuNum;
+    return changed;
+}
+
+void DeviceManager::releaseRetiredDevices()
+{
+    foreach (const QList<DeviceBaseInfo *> &lst, m_RetiredDevices)
+        qDeleteAll(lst);
+    m_RetiredDevices.clear();
+}
+
+QByteArray DeviceManager::snapshotData(DeviceType deviceType)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_11);
+
+    const QList<DeviceBaseInfo *> &lst = *convertDeviceListAddr(deviceType);
+    out << qint32(lst.size());
+    foreach (DeviceBaseInfo *device, lst)
+        device->saveSnapshot(out);
+    return data;
+}
+
+bool DeviceManager::loadSnapshotData(DeviceType deviceType, const QByteArray &data, QList<DeviceBaseInfo *> &lst)
+{
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_5_11);
+
+    qint32 count = 0;
+    in >> count;
+    for (int i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        DeviceBaseInfo *device = createDevice(deviceType);
+        device->loadSnapshot(in);
+        lst.append(device);
+    }
+
+    if (in.status() != QDataStream::Ok || !in.atEnd()) {
+        qDeleteAll(lst);
+        lst.clear();
+        return false;
+    }
+    return true;
+}
+
 TomlFixMethod DeviceManager::tomlDeviceMapSet(DeviceType deviceType,  DeviceBaseInfo *device, const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting TOML device for deviceType:" << deviceType;
@@ -512,6 +629,7 @@ TomlFixMethod DeviceManager::tomlDeviceMapSet(DeviceType deviceType,  DeviceBase
         (TOML_Del == tomldevice->setInfoFromTomlBase(mapInfo)) ? ret = TOML_Del : ret = tomldevice->setInfoFromTomlOneByOne(mapInfo);
     } break;
     }
+    m_DeviceIndex[deviceType].update(device);
     return ret;
 }
 
@@ -644,63 +762,80 @@ void DeviceManager::tomlDeviceSet(DeviceType deviceType)
     QString deviceTypeName = convertDeviceTomlClassName(deviceType);
     const QList<QMap<QString, QString>> &tomlMapLst = cmdInfo(deviceTypeName);
     for (int j = 0; j < tomlMapLst.size(); j++) { // 加载从toml中获取的信息
-        bool fixSameOne = false;                  //初始值设为该项信息没有用过
-        bool isSameOne = false;
-
         QString tomltomlmatchkey = tomlMapLst[j]["tomlmatchkey"];
         QString tomltomlconfigdemanding = PhysID(tomlMapLst[j], "tomlconfigdemanding");
-        QList<DeviceBaseInfo *> lst = convertDeviceList(deviceType);
-        for (int i = 0; i < lst.size(); i++) {   // toml中获取的信息 与 原设备信息遍历，相比较作处理
-            DeviceBaseInfo *device = lst[i];
-            QString modalias = PhysID(tomlMapLst[j], "Modalias");
-            QString vid = PhysID(tomlMapLst[j], "Vendor_ID");
-            QString pid = PhysID(tomlMapLst[j], "Product_ID");
-            QString vendor = PhysID(tomlMapLst[j], "Vendor");
-            QString name = PhysID(tomlMapLst[j], "Name");
-            bool isSameOne = false;                   //初始值设为该项信息不属于该设备
-
-
-            isSameOne = tomlSetBytomlmatchkey(deviceType, device, tomltomlmatchkey,tomltomlconfigdemanding);
-
-            if (tomltomlconfigdemanding == "adjust") {
-                fixSameOne = true;   //标记为该项信息有用过 ，
-                if (isSameOne)
+
+        if (tomltomlconfigdemanding == "adjust" || tomltomlconfigdemanding == "delete") {
+            QList<DeviceBaseInfo *> lst = convertDeviceList(deviceType);
+            for (int i = 0; i < lst.size(); i++) {   // toml中获取的信息 与 原设备信息遍历，按匹配规则作处理
+                DeviceBaseInfo *device = lst[i];
+                if (!tomlSetBytomlmatchkey(deviceType, device, tomltomlmatchkey, tomltomlconfigdemanding))
+                    continue;
+
+                if (tomltomlconfigdemanding == "adjust") {
                     tomlDeviceMapSet(deviceType, device, tomlMapLst[j]);
-            } else if (tomltomlconfigdemanding == "delete") {
-                fixSameOne = true;   //标记为该项信息有用过 ，
-                if (isSameOne) {
+                } else {
                     tomlDeviceDel(deviceType, device); //toml 去掉该设备
                     delete (device);
                 }
-            } else if (tomltomlconfigdemanding == "add" && !fixSameOne) {
-
-            } else {
-                //取出toml中获取的关键字信息设备唯一标识硬件IDS "Modalias"， "Vendor_ID"， "Vendor"，"Name"；作比较处理
-                if (!isSameOne)
-                    isSameOne = findByModalias(deviceType, device, modalias);
-                if (!isSameOne) {
-                    isSameOne = findByVIDPID(deviceType, device, vid, pid);
-                }
-                if (!isSameOne) {
-                    isSameOne = findByVendorName(deviceType, device, vendor, name);
-                }
-                if (isSameOne&& !fixSameOne) {   //存在 就合并信息
-                    fixSameOne = true;   //标记为该项信息有用过 ，
-                    if (TOML_Del == tomlDeviceMapSet(deviceType, device, tomlMapLst[j])) {
-                        tomlDeviceDel(deviceType, device); //toml 去掉该设备
-                        delete (device);
-                    }
-                }
             }
-        }  //与原设备信息遍历相比完再作添加设备
-        if (tomltomlconfigdemanding == "add" && !fixSameOne) {
-            fixSameOne = true;   //标记为该项信息有用过
+        } else if (tomltomlconfigdemanding == "add") {
             DeviceBaseInfo *newDevice = createDevice(deviceType);
             tomlDeviceMapSet(deviceType, newDevice, tomlMapLst[j]);
             tomlDeviceAdd(deviceType, newDevice); //加
+        } else {
+            //取出toml中获取的关键字信息设备唯一标识硬件IDS "Modalias"， "Vendor_ID"， "Vendor"，"Name"；存在 就合并信息
+            DeviceBaseInfo *device = tomlFindDevice(deviceType, tomlMapLst[j]);
+            if (device && TOML_Del == tomlDeviceMapSet(deviceType, device, tomlMapLst[j])) {
+                tomlDeviceDel(deviceType, device); //toml 去掉该设备
+                delete (device);
+            }
         }
     } //end of for (int j = 0;...
 }
+
+DeviceBaseInfo *DeviceManager::tomlFindDevice(DeviceType deviceType, const QMap<QString, QString> &mapInfo)
+{
+    QString tomltomlmatchkey = mapInfo["tomlmatchkey"];
+    QString tomltomlconfigdemanding = PhysID(mapInfo, "tomlconfigdemanding");
+    QString modalias = PhysID(mapInfo, "Modalias");
+    QString vid = PhysID(mapInfo, "Vendor_ID");
+    QString pid = PhysID(mapInfo, "Product_ID");
+    QString vendor = PhysID(mapInfo, "Vendor");
+    QString name = PhysID(mapInfo, "Name");
+
+    // 没有匹配规则时，硬件ID相同的设备通过索引查找，仍用原有的规则确认
+    if (tomltomlmatchkey.isEmpty()) {
+        DeviceIndex &index = deviceIndex(deviceType);
+        QList<DeviceBaseInfo *> candidates;
+        if (!modalias.isEmpty())
+            candidates += index.find(DeviceIndex::IK_Modalias, DeviceIndex::normalize(DeviceIndex::IK_Modalias, modalias));
+        if (!vid.isEmpty() && !pid.isEmpty())
+            candidates += index.find(DeviceIndex::IK_VIDPID, DeviceIndex::normalize(DeviceIndex::IK_VIDPID, vid + pid));
+        index.sort(candidates);
+        foreach (DeviceBaseInfo *device, candidates) {
+            if (findByModalias(deviceType, device, modalias) || findByVIDPID(deviceType, device, vid, pid))
+                return device;
+        }
+
+        // 标准的 modalias 和 VID:PID 只能精确匹配，没有厂商名称时不需要再逐个比较
+        bool customModalias = !modalias.isEmpty() && !modalias.startsWith("pci") && !modalias.startsWith("usb");
+        bool byVendorName = !name.isEmpty() && (!vendor.isEmpty() || deviceType == DT_Bios || deviceType == DT_Computer);
+        if (!customModalias && !byVendorName)
+            return nullptr;
+    }
+
+    QList<DeviceBaseInfo *> lst = convertDeviceList(deviceType);
+    foreach (DeviceBaseInfo *device, lst) {
+        if (tomlSetBytomlmatchkey(deviceType, device, tomltomlmatchkey, tomltomlconfigdemanding)
+                || findByModalias(deviceType, device, modalias)
+                || findByVIDPID(deviceType, device, vid, pid)
+                || findByVendorName(deviceType, device, vendor, name))
+            return device;
+    }
+    return nullptr;
+}
+
 QString DeviceManager::PhysID(const QMap<QString, QString> &mapInfo, const QString &key)
 {
     qCDebug(appLog) << "Getting PhysID for key:" << key;
@@ -725,6 +860,7 @@ void DeviceManager::tomlDeviceDel(DeviceType deviceType, DeviceBaseInfo *const d
     }
     QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
     lst->removeOne(device);
+    m_DeviceIndex[deviceType].remove(device);
 }
 
 void DeviceManager::tomlDeviceAdd(DeviceType deviceType, DeviceBaseInfo *const device)
@@ -736,6 +872,7 @@ void DeviceManager::tomlDeviceAdd(DeviceType deviceType, DeviceBaseInfo *const d
     }
     QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
     lst->append(device);
+    m_DeviceIndex[deviceType].insert(device);
 }
 
 bool DeviceManager::findByModalias(DeviceType deviceType, DeviceBaseInfo *device, const QString &modalias)
@@ -876,11 +1013,39 @@ DeviceBaseInfo *DeviceManager::getBluetoothAtIndex(int index)
     return m_ListDeviceBluetooth[index];
 }
 
+void DeviceManager::updateDeviceIndex(DeviceType deviceType, DeviceBaseInfo *device)
+{
+    m_DeviceIndex[deviceType].update(device);
+}
+
+DeviceIndex &DeviceManager::deviceIndex(DeviceType deviceType)
+{
+    return m_DeviceIndex[deviceType];
+}
+
+void DeviceManager::clearDeviceIndex()
+{
+    for (DeviceIndex &index : m_DeviceIndex)
+        index.clear();
+}
+
+QList<DeviceBaseInfo *> DeviceManager::lshwCandidates(DeviceType deviceType, const QMap<QString, QString> &mapInfo)
+{
+    // 候选设备仍由 matchToLshw 确认，这里只排除不可能匹配的设备
+    return deviceIndex(deviceType).find(DeviceIndex::IK_BusInfo, DeviceIndex::lshwKeys(mapInfo));
+}
+
+QList<DeviceBaseInfo *> DeviceManager::uniqueIDCandidates(DeviceType deviceType, const QString &unique_id)
+{
+    return deviceIndex(deviceType).find(DeviceIndex::IK_UniqueID, unique_id);
+}
+
 void DeviceManager::addMouseDevice(DeviceInput *const device)
 {
     // qCDebug(appLog) << "Adding mouse device";
     // 如果不是重复设备则添加到设备列表
     m_ListDeviceMouse.append(device);
+    m_DeviceIndex[DT_Mouse].insert(device);
 }
 
 DeviceBaseInfo *DeviceManager::getMouseDevice(const QString &unique_id)
@@ -890,10 +1055,10 @@ DeviceBaseInfo *DeviceManager::getMouseDevice(const QString &unique_id)
         qCDebug(appLog) << "Unique ID is empty";
         return nullptr;
     }
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMouse.begin(); it != m_ListDeviceMouse.end(); ++it) {
-        DeviceInput *mouse = dynamic_cast<DeviceInput *>(*it);
+    foreach (DeviceBaseInfo *device, uniqueIDCandidates(DT_Mouse, unique_id)) {
+        DeviceInput *mouse = dynamic_cast<DeviceInput *>(device);
         if (mouse && mouse->uniqueID() == unique_id) {
-            return *it;
+            return device;
         }
     }
     qCDebug(appLog) << "Mouse device with unique ID:" << unique_id << "not found";
@@ -904,9 +1069,8 @@ bool DeviceManager::addMouseInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Adding mouse info from lshw";
     // 从lshw中添加鼠标信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMouse.begin();
-    for (; it != m_ListDeviceMouse.end(); ++it) {
-        DeviceInput *device = dynamic_cast<DeviceInput *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Mouse, mapInfo)) {
+        DeviceInput *device = dynamic_cast<DeviceInput *>(cur);
         if (!device)
             continue;
 
@@ -924,12 +1088,14 @@ void DeviceManager::addCpuDevice(DeviceCpu *const device)
     // qCDebug(appLog) << "Adding CPU device";
     // 添加CPU设备
     m_ListDeviceCPU.append(device);
+    m_DeviceIndex[DT_Cpu].insert(device);
 }
 
 void DeviceManager::addStorageDeivce(DeviceStorage *const device)
 {
     // qCDebug(appLog) << "Adding storage device";
     m_ListDeviceStorage.append(device);
+    m_DeviceIndex[DT_Storage].insert(device);
 }
 
 void DeviceManager::addLshwinfoIntoStorageDevice(const QMap<QString, QString> &mapInfo)
@@ -1006,6 +1172,8 @@ void DeviceManager::mergeDisk()
         delete curDevice;
     }
 
+    m_DeviceIndex[DT_Storage].rebuild(m_ListDeviceStorage);
+
     for (int i = 0; i < m_ListDeviceStorage.size(); ++i) {
         DeviceStorage *device = dynamic_cast<DeviceStorage *>(m_ListDeviceStorage[i]);
         device->unitConvertByDecimal();
@@ -1068,6 +1236,7 @@ void DeviceManager::orderDiskByType()
 
     // 使用自定义比较函数对列表进行排序
     std::sort(m_ListDeviceStorage.begin(), m_ListDeviceStorage.end(), compareDevices);
+    m_DeviceIndex[DT_Storage].rebuild(m_ListDeviceStorage);
 }
 
 bool DeviceManager::setStorageDeviceMediaType(const QString &name, const QString &value)
@@ -1093,15 +1262,15 @@ void DeviceManager::addGpuDevice(DeviceGpu *const device)
     // qCDebug(appLog) << "Adding GPU device";
     // 添加显示适配器
     m_ListDeviceGPU.append(device);
+    m_DeviceIndex[DT_Gpu].insert(device);
 }
 
 void DeviceManager::setGpuInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting GPU info from lshw";
     // 从lshw中添加显示适配器信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceGPU.begin();
-    for (; it != m_ListDeviceGPU.end(); ++it) {
-        DeviceGpu *device = dynamic_cast<DeviceGpu *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Gpu, mapInfo)) {
+        DeviceGpu *device = dynamic_cast<DeviceGpu *>(cur);
         if (!device)
             continue;
 
@@ -1142,6 +1311,7 @@ void DeviceManager::addMemoryDevice(DeviceMemory *const device)
     // qCDebug(appLog) << "Adding memory device";
     // 添加内存
     m_ListDeviceMemory.append(device);
+    m_DeviceIndex[DT_Memory].insert(device);
 }
 
 void DeviceManager::setMemoryInfoFromDmidecode(const QMap<QString, QString> &mapInfo)
@@ -1164,6 +1334,7 @@ void DeviceManager::addMonitor(DeviceMonitor *const device)
     // qCDebug(appLog) << "Adding monitor device";
     // 添加显示设备
     m_ListDeviceMonitor.append(device);
+    m_DeviceIndex[DT_Monitor].insert(device);
 }
 
 void DeviceManager::setMonitorInfoFromXrandr(const QString &main, const QString &edid, const QString &rate, const QString &xrandr)
@@ -1201,6 +1372,7 @@ void DeviceManager::addBiosDevice(DeviceBios *const device)
     // qCDebug(appLog) << "Adding bios device";
     // 添加主板信息
     m_ListDeviceBios.append(device);
+    m_DeviceIndex[DT_Bios].insert(device);
 }
 
 void DeviceManager::setLanguageInfo(const QMap<QString, QString> &mapInfo)
@@ -1222,15 +1394,15 @@ void DeviceManager::addBluetoothDevice(DeviceBluetooth *const device)
 {
     // qCDebug(appLog) << "Adding bluetooth device";
     m_ListDeviceBluetooth.append(device);
+    m_DeviceIndex[DT_Bluetoorh].insert(device);
 }
 
 void DeviceManager::setBluetoothInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting bluetooth info from lshw";
     // 从lshw中获取蓝牙信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBluetooth.begin();
-    for (; it != m_ListDeviceBluetooth.end(); ++it) {
-        DeviceBluetooth *device = dynamic_cast<DeviceBluetooth *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Bluetoorh, mapInfo)) {
+        DeviceBluetooth *device = dynamic_cast<DeviceBluetooth *>(cur);
         if (!device)
             continue;
 
@@ -1249,8 +1421,10 @@ bool DeviceManager::setBluetoothInfoFromHwinfo(const QMap<QString, QString> &map
         if (!device)
             continue;
 
-        if (device->setInfoFromHwinfo(mapInfo))
+        if (device->setInfoFromHwinfo(mapInfo)) {
+            m_DeviceIndex[DT_Bluetoorh].update(device);
             return true;
+        }
     }
     return false;
 }
@@ -1258,10 +1432,10 @@ bool DeviceManager::setBluetoothInfoFromHwinfo(const QMap<QString, QString> &map
 DeviceBaseInfo *DeviceManager::getBluetoothDevice(const QString &unique_id)
 {
     qCDebug(appLog) << "Getting bluetooth device with unique ID:" << unique_id;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBluetooth.begin(); it != m_ListDeviceBluetooth.end(); ++it) {
-        DeviceBluetooth *bt = dynamic_cast<DeviceBluetooth *>(*it);
+    foreach (DeviceBaseInfo *device, uniqueIDCandidates(DT_Bluetoorh, unique_id)) {
+        DeviceBluetooth *bt = dynamic_cast<DeviceBluetooth *>(device);
         if (bt && bt->uniqueID() == unique_id) {
-            return *it;
+            return device;
         }
     }
     return nullptr;
@@ -1271,12 +1445,14 @@ void DeviceManager::addAudioDevice(DeviceAudio *const device)
 {
     // qCDebug(appLog) << "Adding audio device";
     m_ListDeviceAudio.append(device);
+    m_DeviceIndex[DT_Audio].insert(device);
 }
 
 void DeviceManager::delAudioDevice(DeviceAudio *const device)
 {
     // qCDebug(appLog) << "Deleting audio device";
     m_ListDeviceAudio.removeOne(device);
+    m_DeviceIndex[DT_Audio].remove(device);
 }
 
 void DeviceManager::deleteDisableDuplicate_AudioDevice(void)
@@ -1331,6 +1507,8 @@ void DeviceManager::deleteDisableDuplicate_AudioDevice(void)
         }
         setAudioDeviceEnable(enabledDevices.value(it), enabledDevices.value(it)->enable());
     }
+    // 设备被替换或启用时修改了sysfs路径和唯一ID，重建索引
+    m_DeviceIndex[DT_Audio].rebuild(m_ListDeviceAudio);
     qWarning()<<"delete after: "<< m_ListDeviceAudio.size();
 }
 
@@ -1361,8 +1539,22 @@ void DeviceManager::setAudioDeviceEnable(DeviceAudio * const devivce, bool enabl
 DeviceBaseInfo *DeviceManager::getAudioDevice(const QString &path)
 {
     qCDebug(appLog) << "Getting audio device with path:" << path;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceAudio.begin(); it != m_ListDeviceAudio.end(); ++it) {
+    // 唯一ID末位为1-9时按0比较，1.1:1.1 -> 1.1:1.0，因此path末位为0时需查找末位为0-9的唯一ID
+    QStringList uniqueIDs = QStringList() << path;
+    if (path.endsWith('0')) {
+        for (char i = '1'; i <= '9'; ++i)
+            uniqueIDs.append(path.left(path.size() - 1) + QChar(i));
+    }
+    DeviceIndex &index = deviceIndex(DT_Audio);
+    QList<DeviceBaseInfo *> candidates = index.find(DeviceIndex::IK_UniqueID, uniqueIDs)
+                                         + index.find(DeviceIndex::IK_SysPath, path)
+                                         + index.find(DeviceIndex::IK_Modalias, DeviceIndex::normalize(DeviceIndex::IK_Modalias, path))
+                                         + index.find(DeviceIndex::IK_VIDPID, DeviceIndex::normalize(DeviceIndex::IK_VIDPID, path));
+    index.sort(candidates);
+    for (QList<DeviceBaseInfo *>::iterator it = candidates.begin(); it != candidates.end(); ++it) {
         DeviceAudio *audio = dynamic_cast<DeviceAudio *>(*it);
+        if (!audio)
+            continue;
         QString tpath = audio->uniqueID();
         // 判断该设备是否已经存在，1.1:1.1 -> 1.1:1.0
         if (audio && path == tpath.replace(QRegularExpression("[1-9]$"), "0")) {
@@ -1390,9 +1582,8 @@ void DeviceManager::setAudioInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting audio info from lshw";
     // 从lshw中获取音频适配器信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceAudio.begin();
-    for (; it != m_ListDeviceAudio.end(); ++it) {
-        DeviceAudio *device = dynamic_cast<DeviceAudio *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Audio, mapInfo)) {
+        DeviceAudio *device = dynamic_cast<DeviceAudio *>(cur);
         if (!device)
             continue;
 
@@ -1420,15 +1611,18 @@ void DeviceManager::addNetworkDevice(DeviceNetwork *const device)
     // qCDebug(appLog) << "Adding network device";
     // 添加网络适配器
     m_ListDeviceNetwork.append(device);
+    m_DeviceIndex[DT_Network].insert(device);
 }
 
 DeviceBaseInfo *DeviceManager::getNetworkDevice(const QString &unique_id)
 {
     qCDebug(appLog) << "Getting network device with unique ID:" << unique_id;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceNetwork.begin(); it != m_ListDeviceNetwork.end(); ++it) {
-        DeviceNetwork *net = dynamic_cast<DeviceNetwork *>(*it);
-        if (!unique_id.isEmpty() && net && net->uniqueID() == unique_id) {
-            return *it;
+    if (!unique_id.isEmpty()) {
+        foreach (DeviceBaseInfo *device, uniqueIDCandidates(DT_Network, unique_id)) {
+            DeviceNetwork *net = dynamic_cast<DeviceNetwork *>(device);
+            if (net && net->uniqueID() == unique_id) {
+                return device;
+            }
         }
     }
     qCDebug(appLog) << "Network device with unique ID:" << unique_id << "not found";
@@ -1492,15 +1686,16 @@ void DeviceManager::addImageDevice(DeviceImage *const device)
     // qCDebug(appLog) << "Adding image device";
     // 添加图像设备
     m_ListDeviceImage.append(device);
+    m_DeviceIndex[DT_Image].insert(device);
 }
 
 DeviceBaseInfo *DeviceManager::getImageDevice(const QString &unique_id)
 {
     qCDebug(appLog) << "Getting image device with unique ID:" << unique_id;
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceImage.begin(); it != m_ListDeviceImage.end(); ++it) {
-        DeviceImage *image = dynamic_cast<DeviceImage *>(*it);
+    foreach (DeviceBaseInfo *device, uniqueIDCandidates(DT_Image, unique_id)) {
+        DeviceImage *image = dynamic_cast<DeviceImage *>(device);
         if (image && image->uniqueID() == unique_id) {
-            return *it;
+            return device;
         }
     }
     qCDebug(appLog) << "Image device with unique ID:" << unique_id << "not found";
@@ -1511,9 +1706,8 @@ void DeviceManager::setCameraInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting camera info from lshw";
     // 从lshw获取图像设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceImage.begin();
-    for (; it != m_ListDeviceImage.end(); ++it) {
-        DeviceImage *device = dynamic_cast<DeviceImage *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Image, mapInfo)) {
+        DeviceImage *device = dynamic_cast<DeviceImage *>(cur);
         if (!device)
             continue;
 
@@ -1542,40 +1736,15 @@ void DeviceManager::addKeyboardDevice(DeviceInput *const device)
         return;
     }
 
-    QProcess process;
-    process.start("lsusb");
-    process.waitForFinished(3000);
-    
-    if (process.exitCode() != 0) {
-        qCWarning(appLog) << "Failed to execute lsusb command, adding keyboard device without verification";
-        device->deleteLater();
-        return;
-    }
-    
-    QString lsusbOutput = process.readAllStandardOutput();
+    // 与 lsusb 相同，检查 sysfs 中是否有该USB设备
+    bool deviceExists = HwIdResolver::instance().usbDeviceExists(normalizedVid, normalizedPid);
 
-    // lsusb output: Bus xxx Device xxx: ID xxxx:xxxx Description
-    QRegularExpression regex(QString("ID\\s+([0-9a-fA-F]{4}):([0-9a-fA-F]{4})"));
-    QRegularExpressionMatchIterator iterator = regex.globalMatch(lsusbOutput);
-    
-    bool deviceExists = false;
-    while (iterator.hasNext()) {
-        QRegularExpressionMatch match = iterator.next();
-        QString lsusbVid = match.captured(1).toLower();
-        QString lsusbPid = match.captured(2).toLower();
-        
-        if (lsusbVid == normalizedVid && lsusbPid == normalizedPid) {
-            deviceExists = true;
-            qCDebug(appLog) << "Found matching device in lsusb output:" << lsusbVid << ":" << lsusbPid;
-            break;
-        }
-    }
-    
     if (deviceExists) {
         m_ListDeviceKeyboard.append(device);
+        m_DeviceIndex[DT_Keyboard].insert(device);
         qCDebug(appLog) << "Keyboard device added successfully";
     } else {
-        qCDebug(appLog) << "Keyboard device not found in lsusb output, device not added";
+        qCDebug(appLog) << "Keyboard device not found in usb devices, device not added";
         device->deleteLater();
     }
 }
@@ -1584,9 +1753,8 @@ void DeviceManager::setKeyboardInfoFromLshw(const QMap<QString, QString> &mapInf
 {
     qCDebug(appLog) << "Setting keyboard info from lshw";
     // 从lshw获取键盘信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceKeyboard.begin();
-    for (; it != m_ListDeviceKeyboard.end(); ++it) {
-        DeviceInput *device = dynamic_cast<DeviceInput *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Keyboard, mapInfo)) {
+        DeviceInput *device = dynamic_cast<DeviceInput *>(cur);
         if (!device)
             continue;
 
@@ -1613,8 +1781,10 @@ void DeviceManager::addOthersDevice(DeviceOthers *const device)
     }
 
     // 添加其他设备
-    if (isOtherDevice)
+    if (isOtherDevice) {
         m_ListDeviceOthers.append(device);
+        m_DeviceIndex[DT_Others].insert(device);
+    }
 }
 
 DeviceBaseInfo *DeviceManager::getOthersDevice(const QString &unique_id)
@@ -1623,10 +1793,10 @@ DeviceBaseInfo *DeviceManager::getOthersDevice(const QString &unique_id)
     if (unique_id.isEmpty()) {
         return nullptr;
     }
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceOthers.begin(); it != m_ListDeviceOthers.end(); ++it) {
-        DeviceOthers *other = dynamic_cast<DeviceOthers *>(*it);
+    foreach (DeviceBaseInfo *device, uniqueIDCandidates(DT_Others, unique_id)) {
+        DeviceOthers *other = dynamic_cast<DeviceOthers *>(device);
         if (other && other->uniqueID() == unique_id) {
-            return *it;
+            return device;
         }
     }
     qCDebug(appLog) << "Others device with unique ID:" << unique_id << "not found";
@@ -1647,15 +1817,15 @@ void DeviceManager::addOthersDeviceFromHwinfo(DeviceOthers *const device)
     }
     qCDebug(appLog) << "Adding others device from hwinfo";
     m_ListDeviceOthers.append(device);
+    m_DeviceIndex[DT_Others].insert(device);
 }
 
 void DeviceManager::setOthersDeviceInfoFromLshw(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Setting others device info from lshw";
     //从lshw中获取其他设备信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceOthers.begin();
-    for (; it != m_ListDeviceOthers.end(); ++it) {
-        DeviceOthers *device = dynamic_cast<DeviceOthers *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Others, mapInfo)) {
+        DeviceOthers *device = dynamic_cast<DeviceOthers *>(cur);
         if (!device)
             continue;
 
@@ -1681,6 +1851,7 @@ void DeviceManager::addPowerDevice(DevicePower *const device)
     // qCDebug(appLog) << "Adding power device";
     // 添加电池设备
     m_ListDevicePower.append(device);
+    m_DeviceIndex[DT_Power].insert(device);
 }
 
 void DeviceManager::addPrintDevice(DevicePrint *const device)
@@ -1688,6 +1859,7 @@ void DeviceManager::addPrintDevice(DevicePrint *const device)
     // qCDebug(appLog) << "Adding print device";
     // 添加打印机信息
     m_ListDevicePrint.append(device);
+    m_DeviceIndex[DT_Print].insert(device);
 }
 
 void DeviceManager::addOtherPCIDevice(DeviceOtherPCI *const device)
@@ -1695,6 +1867,7 @@ void DeviceManager::addOtherPCIDevice(DeviceOtherPCI *const device)
     // qCDebug(appLog) << "Adding other PCI device";
     // 添加其他PCI设备
     m_ListDeviceOtherPCI.append(device);
+    m_DeviceIndex[DT_OtherPCI].insert(device);
 }
 
 void DeviceManager::addComputerDevice(DeviceComputer *const device)
@@ -1702,6 +1875,7 @@ void DeviceManager::addComputerDevice(DeviceComputer *const device)
     // qCDebug(appLog) << "Adding computer device";
     // 添加计算机设备
     m_ListDeviceComputer.append(device);
+    m_DeviceIndex[DT_Computer].insert(device);
 }
 
 void DeviceManager::addCdromDevice(DeviceCdrom *const device)
@@ -1709,15 +1883,15 @@ void DeviceManager::addCdromDevice(DeviceCdrom *const device)
     // qCDebug(appLog) << "Adding CDROM device";
     // 添加CDROM
     m_ListDeviceCdrom.append(device);
+    m_DeviceIndex[DT_Cdrom].insert(device);
 }
 
 void DeviceManager::addLshwinfoIntoCdromDevice(const QMap<QString, QString> &mapInfo)
 {
     qCDebug(appLog) << "Adding CDROM info from lshw";
     // 从lshw中添加CDROM信息
-    QList<DeviceBaseInfo *>::iterator it = m_ListDeviceCdrom.begin();
-    for (; it != m_ListDeviceCdrom.end(); ++it) {
-        DeviceCdrom *device = dynamic_cast<DeviceCdrom *>(*it);
+    foreach (DeviceBaseInfo *cur, lshwCandidates(DT_Cdrom, mapInfo)) {
+        DeviceCdrom *device = dynamic_cast<DeviceCdrom *>(cur);
         if (!device)
             continue;
 
@@ -1751,11 +1925,12 @@ void DeviceManager::addCmdInfo(const QMap<QString, QList<QMap<QString, QString>
     }
 }
 
-const QList<QMap<QString, QString>> &DeviceManager::cmdInfo(const QString &key)
+QList<QMap<QString, QString>> DeviceManager::cmdInfo(const QString &key)
 {
     // qCDebug(appLog) << "Getting command info";
+    // 返回副本，命令线程可能在锁释放后继续修改 m_cmdInfo
     QMutexLocker locker(&addCmdMutex);
-    return m_cmdInfo[key];
+    return m_cmdInfo.value(key);
 }
 
 bool DeviceManager::exportToTxt(const QString &filePath)
@@ -1793,8 +1968,8 @@ bool DeviceManager::exportToTxt(const QString &filePath)
 bool DeviceManager::exportToXlsx(const QString &filePath)
 {
     qCDebug(appLog) << "Exporting to xlsx file";
-    // 导出设备信息到xlsx表格
-    QXlsx::Document xlsx;
+    // 导出设备信息到xlsx表格，按行写入，不在内存中保存所有单元格
+    QXlsx::StreamWriter xlsx(filePath);
     QXlsx::Format boldFont;
     overviewToXlsx(xlsx, boldFont);
     EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
@@ -1814,17 +1989,15 @@ bool DeviceManager::exportToXlsx(const QString &filePath)
     EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
     EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
     EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-    m_CurrentXlsRow = 1;
-    xlsx.saveAs(filePath);
 
-    return true;
+    return xlsx.save();
 }
 
 bool DeviceManager::exportToDoc(const QString &filePath)
 {
     qCDebug(appLog) << "Exporting to doc file";
-    // 导出设备信息到doc文件
-    Docx::Document doc(":/template.docx");
+    // 导出设备信息到doc文件，内容直接写到 document.xml，不在内存中构建整个文档
+    Docx::StreamDocument doc(":/template.docx");
     overviewToDoc(doc);
     EXPORT_TO_DOC(doc, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
     EXPORT_TO_DOC(doc, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
@@ -1844,9 +2017,7 @@ bool DeviceManager::exportToDoc(const QString &filePath)
     EXPORT_TO_DOC(doc, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
     EXPORT_TO_DOC(doc, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
 
-    doc.save(filePath);
-
-    return true;
+    return doc.save(filePath);
 }
 
 bool DeviceManager::exportToHtml(const QString &filePath)
@@ -1889,12 +2060,6 @@ bool DeviceManager::exportToHtml(const QString &filePath)
     return true;
 }
 
-int DeviceManager::currentXlsRow()
-{
-    // qCDebug(appLog) << "Getting current XLS row";
-    return m_CurrentXlsRow++;
-}
-
 void DeviceManager::overviewToTxt(QTextStream &out)
 {
     qCDebug(appLog) << "Exporting overview to txt";
@@ -1963,7 +2128,7 @@ void DeviceManager::overviewToHtml(QFile &html)
     html.write(doc.toString().toStdString().data());
 }
 
-void DeviceManager::overviewToDoc(Docx::Document &doc)
+void DeviceManager::overviewToDoc(Docx::StreamDocument &doc)
 {
     qCDebug(appLog) << "Exporting overview to doc";
     // 导出概况信息到doc文件
@@ -1991,24 +2156,22 @@ void DeviceManager::overviewToDoc(Docx::Document &doc)
     doc.addParagraph("\n");
 }
 
-void DeviceManager::overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont)
+void DeviceManager::overviewToXlsx(QXlsx::StreamWriter &xlsx, QXlsx::Format &boldFont)
 {
     qCDebug(appLog) << "Exporting overview to xlsx";
     // 导出概况信息到xlsx文件
     boldFont.setFontBold(true);
-    xlsx.write(m_CurrentXlsRow++, 1, "[" + tr("Overview") + "]", boldFont);
+    xlsx.appendRow(QStringList() << "[" + tr("Overview") + "]", boldFont);
 
     // 设置字体格式
     boldFont.setFontBold(false);
     boldFont.setFontSize(10);
 
     // 导出设备信息到xlsx文件
-    xlsx.write(m_CurrentXlsRow, 1, tr("Device"), boldFont);
-    xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap["Overview"], boldFont);
+    xlsx.appendRow(QStringList() << tr("Device") << m_OveriewMap["Overview"], boldFont);
 
     // 导出操作系统信息到xlsx文件
-    xlsx.write(m_CurrentXlsRow, 1, tr("OS"), boldFont);
-    xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap["OS"], boldFont);
+    xlsx.appendRow(QStringList() << tr("OS") << m_OveriewMap["OS"], boldFont);
 
     // 导出设备概况信息到xlsx文件
     foreach (auto iter, m_ListDeviceType) {
@@ -2017,11 +2180,10 @@ void DeviceManager::overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFon
 
         if (m_OveriewMap.find(iter.first) != m_OveriewMap.end()) {
 
-            xlsx.write(m_CurrentXlsRow, 1, iter.first, boldFont);
-            xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap[iter.first], boldFont);
+            xlsx.appendRow(QStringList() << iter.first << m_OveriewMap[iter.first], boldFont);
         }
     }
-    m_CurrentXlsRow++;
+    xlsx.skipRows();
 }
 
 void DeviceManager::infoToHtml(QDomDocument &doc, const QString &key, const QString &value)
@@ -2147,6 +2309,9 @@ const QMap<QString, QString> &DeviceManager::inputInfo(const QString &key)
 bool DeviceManager::isDeviceExistInPairedDevice(const QString &mac)
 {
     qCDebug(appLog) << "Checking if device exists in paired device";
+    if (DBusBluezInterface::getInstance()->isPaired(mac))
+        return true;
+
     // 获取蓝牙设备配对信息
     const QList<QMap<QString, QString> >  &cmdInfo = DeviceManager::instance()->cmdInfo("bt_device");
 
@@ -6,9 +6,10 @@
 #ifndef DEVICEMANAGER_H
 #define DEVICEMANAGER_H
 
-#include "document.h"
-#include "xlsxdocument.h"
+#include "streamdocument.h"
+#include "xlsxstreamwriter.h"
 #include "GenerateDevicePool.h"
+#include "DeviceIndex.h"
 
 #include <QList>
 #include <QMap>
@@ -18,6 +19,7 @@
 #include <QFile>
 #include <QMutex>
 #include <QRegularExpression>
+#include <QByteArray>
 #include <algorithm> // for std::sort
 
 //class DeviceMouse;
@@ -128,6 +130,49 @@ public:
 
     DeviceBaseInfo *createDevice(DeviceType deviceType);
 
+    /**
+     * @brief snapshotPath:设备快照文件路径，位于用户缓存目录
+     * @return
+     */
+    static QString snapshotPath();
+
+    /**
+     * @brief loadSnapshot:从快照文件加载上一次生成的设备，启动时先显示快照，后台再刷新
+     * @param filePath:快照文件路径
+     * @return 文件不存在、版本或语言不一致、内容损坏时返回false，设备列表不变
+     */
+    bool loadSnapshot(const QString &filePath);
+
+    /**
+     * @brief saveSnapshot:将当前所有设备保存到快照文件
+     * @param filePath:快照文件路径
+     * @return
+     */
+    bool saveSnapshot(const QString &filePath);
+
+    /**
+     * @brief restoreUnchangedDevices:刷新完成后，属性与界面正在显示的设备完全相同的设备类型继续使用原来的设备
+     * @return 是否有设备发生变化
+     */
+    bool restoreUnchangedDevices();
+
+    /**
+     * @brief releaseRetiredDevices:释放 clear 时保留下来的旧设备，界面不再显示旧设备后调用
+     */
+    void releaseRetiredDevices();
+
+    /**
+     * @brief setLoading:设置是否正在后台加载设备信息，加载期间设备列表会被清空重建
+     * @param loading:是否正在加载
+     */
+    void setLoading(bool loading);
+
+    /**
+     * @brief isLoading:是否正在后台加载设备信息，加载期间不能导出和刷新
+     * @return
+     */
+    bool isLoading() const;
+
     /**
      * @brief getAudioDevice 获取设备
      * @param name  见 添加设备类型与设备指针列表的映射关系 void DeviceManager::setDeviceListClass()
@@ -138,6 +183,13 @@ public:
     bool findByVIDPID(DeviceType deviceType, DeviceBaseInfo *device, const QString &vid, const QString &pid);
     bool findByVendorName(DeviceType deviceType, DeviceBaseInfo *device, const QString &vendor, const QString &name);
 
+    /**
+     * @brief updateDeviceIndex:设备关键属性(唯一ID、总线信息、sysfs路径等)被修改后更新索引
+     * @param deviceType:设备类型
+     * @param device:设备
+     */
+    void updateDeviceIndex(DeviceType deviceType, DeviceBaseInfo *device);
+
     /**
      * @brief getBluetoothAtIndex 根据索引获取device
      * @param index
@@ -528,7 +580,7 @@ public:
      * @param key:命令值
      * @return 信息map组成的信息List
      */
-    const QList<QMap<QString, QString>> &cmdInfo(const QString &key);
+    QList<QMap<QString, QString>> cmdInfo(const QString &key);
 
     /**
      * @brief exportToTxt:导出到txt
@@ -558,12 +610,6 @@ public:
      */
     bool exportToHtml(const QString &filePath);
 
-    /**
-     * @brief currentXlsRow:获取xlsx当前行
-     * @return xlsx当前行
-     */
-    static int currentXlsRow();
-
     /**
      * @brief overviewToTxt:概况信息写到txt
      * @param out:txt文件流
@@ -580,14 +626,14 @@ public:
      * @brief overviewToDoc:概况信息写到doc
      * @param doc:doc文件
      */
-    void overviewToDoc(Docx::Document &doc);
+    void overviewToDoc(Docx::StreamDocument &doc);
 
     /**
      * @brief overviewToXlsx:概况信息写到表格
      * @param xlsx:xlsx文件
      * @param boldFont:字体格式
      */
-    void overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont);
+    void overviewToXlsx(QXlsx::StreamWriter &xlsx, QXlsx::Format &boldFont);
 
     /**
      * @brief infoToHtml:将信息写到html中
@@ -647,6 +693,60 @@ protected:
     ~DeviceManager();
 
 private:
+    /**
+     * @brief deviceIndex:获取设备索引
+     * @param deviceType:设备类型
+     * @return
+     */
+    DeviceIndex &deviceIndex(DeviceType deviceType);
+
+    /**
+     * @brief clearDeviceIndex:清空所有类型的设备索引
+     */
+    void clearDeviceIndex();
+
+    /**
+     * @brief lshwCandidates:通过索引获取可能与lshw信息匹配的设备，顺序与设备列表一致
+     * @param deviceType:设备类型
+     * @param mapInfo:lshw信息
+     * @return
+     */
+    QList<DeviceBaseInfo *> lshwCandidates(DeviceType deviceType, const QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief uniqueIDCandidates:通过索引获取唯一ID等于unique_id的设备
+     * @param deviceType:设备类型
+     * @param unique_id:唯一ID
+     * @return
+     */
+    QList<DeviceBaseInfo *> uniqueIDCandidates(DeviceType deviceType, const QString &unique_id);
+
+    /**
+     * @brief tomlFindDevice:查找与toml信息匹配的第一个设备
+     * 硬件ID（Modalias、Vendor_ID和Product_ID）通过索引查找，
+     * 匹配规则、自定义的Modalias和厂商名称无法通过索引查找时才逐个比较
+     * @param deviceType:设备类型
+     * @param mapInfo:toml信息
+     * @return 没有匹配的设备时返回nullptr
+     */
+    DeviceBaseInfo *tomlFindDevice(DeviceType deviceType, const QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief snapshotData:将一类设备序列化为快照数据
+     * @param deviceType:设备类型
+     * @return
+     */
+    QByteArray snapshotData(DeviceType deviceType);
+
+    /**
+     * @brief loadSnapshotData:从快照数据中创建一类设备
+     * @param deviceType:设备类型
+     * @param data:快照数据
+     * @param lst:创建的设备
+     * @return 数据损坏时返回false，不创建任何设备
+     */
+    bool loadSnapshotData(DeviceType deviceType, const QByteArray &data, QList<DeviceBaseInfo *> &lst);
+
     static DeviceManager    *sInstance;
 
     QList<DeviceBaseInfo *>              m_ListDeviceMouse;                //<! 鼠标设备
@@ -675,10 +775,14 @@ private:
     QMap<QString, QList<DeviceBaseInfo *>>         m_DeviceClassMap;       //<! 所有的设备类型与其对应设备列表
     QMap<QString, QMap<QString, QStringList>>      m_DeviceDriverPool;     //<! 所有的设备驱动与与其对应的设备类型，设备名称列表
     QMap<QString, QMap<QString, QString> >         m_InputDeviceInfo;
+    DeviceIndex                                    m_DeviceIndex[DT_Others + 1]; //<! 各类设备的哈希索引，按设备类型预先建好，生成线程不会改动容器结构
+    QMap<DeviceType, QList<DeviceBaseInfo *>>      m_RetiredDevices;       //<! clear 时保留的旧设备，界面可能还在显示
+    QMap<DeviceType, QByteArray>                   m_SnapshotData;         //<! 界面正在显示的设备的快照数据
+    int                                            m_SnapshotCpuNum;       //<! 界面正在显示的物理cpu个数
 
     int                                            m_CpuNum;               //<! 物理cpu个数
+    bool                                           m_Loading;              //<! 是否正在后台加载设备信息
 
-    static int m_CurrentXlsRow;       //<! xlsx表格当前行
     QStringList m_networkDriver; //网络驱动
 };
 
@@ -264,3 +264,19 @@ const QString DeviceMemory::getOverviewInfo()
     qCDebug(appLog) << "Memory overview info:" << ov;
     return ov;
 }
+
+void DeviceMemory::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_Size << m_Type << m_Speed << m_TotalBandwidth << m_DataBandwidth
+        << m_Locator << m_SerialNumber << m_ConfiguredSpeed << m_MinimumVoltage << m_MaximumVoltage
+        << m_ConfiguredVoltage << m_MatchedFromDmi;
+}
+
+void DeviceMemory::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_Size >> m_Type >> m_Speed >> m_TotalBandwidth >> m_DataBandwidth >> m_Locator
+       >> m_SerialNumber >> m_ConfiguredSpeed >> m_MinimumVoltage >> m_MaximumVoltage
+       >> m_ConfiguredVoltage >> m_MatchedFromDmi;
+}
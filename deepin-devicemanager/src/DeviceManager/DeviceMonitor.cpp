@@ -674,3 +674,24 @@ QMap<QString, QStringList> DeviceMonitor::getMonitorResolutionMap(QString rawTex
 
     return monitorResolutionMap;
 }
+
+void DeviceMonitor::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_DisplayInput << m_VGA << m_HDMI << m_DVI << m_Interface << m_ScreenSize
+        << m_AspectRatio << m_MainScreen << m_CurrentResolution << m_SerialNumber
+        << m_ProductionWeek << m_SupportResolution << m_RefreshRate << qint32(m_Width)
+        << qint32(m_Height) << m_IsTomlSet << m_RawInterface;
+}
+
+void DeviceMonitor::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    qint32 width = 0;
+    qint32 height = 0;
+    in >> m_Model >> m_DisplayInput >> m_VGA >> m_HDMI >> m_DVI >> m_Interface >> m_ScreenSize
+       >> m_AspectRatio >> m_MainScreen >> m_CurrentResolution >> m_SerialNumber >> m_ProductionWeek
+       >> m_SupportResolution >> m_RefreshRate >> width >> height >> m_IsTomlSet >> m_RawInterface;
+    m_Width = width;
+    m_Height = height;
+}
@@ -370,3 +370,21 @@ void DeviceNetwork::loadTableData()
     m_TableData.append(m_Vendor);
     m_TableData.append(m_Model);
 }
+
+void DeviceNetwork::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_BusInfo << m_LogicalName << m_MACAddress << m_Irq << m_Memory << m_Width
+        << m_Clock << m_Capabilities << m_Autonegotiation << m_Broadcast << m_DriverModules
+        << m_DriverVersion << m_Duplex << m_Firmware << m_Port << m_Link << m_Ip << m_Speed
+        << m_Capacity << m_Latency << m_Multicast << m_IsWireless;
+}
+
+void DeviceNetwork::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_BusInfo >> m_LogicalName >> m_MACAddress >> m_Irq >> m_Memory >> m_Width
+       >> m_Clock >> m_Capabilities >> m_Autonegotiation >> m_Broadcast >> m_DriverModules
+       >> m_DriverVersion >> m_Duplex >> m_Firmware >> m_Port >> m_Link >> m_Ip >> m_Speed
+       >> m_Capacity >> m_Latency >> m_Multicast >> m_IsWireless;
+}
@@ -113,3 +113,17 @@ void DeviceOtherPCI::loadTableData()
     m_TableData.append(m_Vendor);
     m_TableData.append(m_Model);
 }
+
+void DeviceOtherPCI::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_BusInfo << m_Width << m_Clock << m_Capabilities << m_Irq << m_Memory
+        << m_Latency << m_InputOutput;
+}
+
+void DeviceOtherPCI::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_BusInfo >> m_Width >> m_Clock >> m_Capabilities >> m_Irq >> m_Memory
+       >> m_Latency >> m_InputOutput;
+}
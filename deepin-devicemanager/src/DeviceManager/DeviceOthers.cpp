@@ -254,3 +254,17 @@ void DeviceOthers::loadTableData()
     m_TableData.append(m_Vendor);
     m_TableData.append(m_Model);
 }
+
+void DeviceOthers::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_BusInfo << m_Capabilities << m_MaximumPower << m_Speed << m_BusID
+        << m_LogicalName << m_Avail;
+}
+
+void DeviceOthers::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_BusInfo >> m_Capabilities >> m_MaximumPower >> m_Speed >> m_BusID
+       >> m_LogicalName >> m_Avail;
+}
@@ -244,3 +244,21 @@ void DevicePower::loadTableData()
     m_TableData.append(m_Vendor);
     m_TableData.append(m_Model);
 }
+
+void DevicePower::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_Type << m_SerialNumber << m_ElectricType << m_MaxPower << m_Status
+        << m_Enabled << m_HotSwitch << m_Capacity << m_Voltage << m_Slot << m_DesignCapacity
+        << m_DesignVoltage << m_SBDSChemistry << m_SBDSManufactureDate << m_SBDSSerialNumber
+        << m_SBDSVersion << m_Temp;
+}
+
+void DevicePower::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_Type >> m_SerialNumber >> m_ElectricType >> m_MaxPower >> m_Status
+       >> m_Enabled >> m_HotSwitch >> m_Capacity >> m_Voltage >> m_Slot >> m_DesignCapacity
+       >> m_DesignVoltage >> m_SBDSChemistry >> m_SBDSManufactureDate >> m_SBDSSerialNumber
+       >> m_SBDSVersion >> m_Temp;
+}
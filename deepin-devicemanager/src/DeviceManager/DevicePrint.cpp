@@ -201,3 +201,17 @@ void DevicePrint::loadTableData()
     m_TableData.append(m_Vendor);
     m_TableData.append(m_Model);
 }
+
+void DevicePrint::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_SerialNumber << m_InterfaceType << m_URI << m_Status << m_Shared
+        << m_MakeAndModel;
+}
+
+void DevicePrint::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_SerialNumber >> m_InterfaceType >> m_URI >> m_Status >> m_Shared
+       >> m_MakeAndModel;
+}
@@ -838,3 +838,19 @@ void DeviceStorage::getInfoFromsmartctl(const QMap<QString, QString> &mapInfo)
         m_Vendor = "Longsys";
     }
 }
+
+void DeviceStorage::saveSnapshot(QDataStream &out) const
+{
+    DeviceBaseInfo::saveSnapshot(out);
+    out << m_Model << m_MediaType << m_Size << m_SizeBytes << m_RotationRate << m_Interface
+        << m_SerialNumber << m_Capabilities << m_FirmwareVersion << m_Speed << m_DeviceFile
+        << m_KeyToLshw << m_KeyFromStorage << m_NvmeKey;
+}
+
+void DeviceStorage::loadSnapshot(QDataStream &in)
+{
+    DeviceBaseInfo::loadSnapshot(in);
+    in >> m_Model >> m_MediaType >> m_Size >> m_SizeBytes >> m_RotationRate >> m_Interface
+       >> m_SerialNumber >> m_Capabilities >> m_FirmwareVersion >> m_Speed >> m_DeviceFile
+       >> m_KeyToLshw >> m_KeyFromStorage >> m_NvmeKey;
+}
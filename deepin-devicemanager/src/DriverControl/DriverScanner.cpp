@@ -8,11 +8,19 @@
 #include "commonfunction.h"
 #include "DDLog.h"
 
-#include <QRegularExpression>
 #include <QLoggingCategory>
-#include <QProcess>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QEventLoop>
+#include <QTimer>
 
-#include <unistd.h>
+#include <functional>
+
+// 同一服务器同时进行的请求数，与 QNetworkAccessManager 每个主机的连接数一致
+#define MAX_PARALLEL_REQUESTS 6
+// 单个请求的超时时间
+#define REQUEST_TIMEOUT 10000
 
 using namespace DDLog;
 
@@ -27,63 +35,44 @@ void DriverScanner::run()
 {
     qCDebug(appLog) << "DriverScanner thread started";
     HttpDriverInterface *hdi  = HttpDriverInterface::getInstance();
-    connect(hdi, &HttpDriverInterface::sigRequestFinished, this, [ = ]() {
-        m_IsStop = true;
-    });
 
     qCDebug(appLog) << "Start scanning" << m_ListDriverInfo.size() << "drivers";
-    foreach (DriverInfo *info, m_ListDriverInfo) {
-        if (!m_IsStop) {
-            qCDebug(appLog) << "Processing driver:" << info->name();
-            hdi->getRequest(info);
-
-            // 检测本地安装版本
-            if (!info->packages().isEmpty()) {
-                // qCDebug(appLog) << "Checking local version for package:" << info->packages();
-                QString outInfo = Common::executeClientCmd("apt", QStringList() << "policy" << info->packages(), QString(), -1, false);
-                if (!outInfo.isEmpty()) {
-                    // qCDebug(appLog) << "apt policy output:" << outInfo;
-                    QStringList infoList = outInfo.split("\n");
-                    int index = 0;
-                    for (int i = 0; i < infoList.size(); i++)
-                    {
-                        if (infoList[i].startsWith(info->packages())) {
-                            index = i;
-                            // qCDebug(appLog) << "Found package info at index:" << index;
-                            break;
-                        }
-                    }
-                    if (infoList.size() > (2 + index) && !infoList[1 + index].contains("（") && !infoList[1 + index].contains("(")) {
-                        QRegularExpression rxlen("(\\d+\\S*)");
-                        QRegularExpressionMatch match = rxlen.match(infoList[1 + index]);
-                        QString curVersion;
-                        if (match.hasMatch()) {
-                            curVersion = match.captured(1);
-                            // qCDebug(appLog) << "Found current version:" << curVersion;
-                        }
-                        info->m_Version = curVersion.trimmed();
-                    }
-                }
-            }
+    QMap<DriverInfo *, QString> mapJson;
+    m_IsStop = !requestDriverInfo(mapJson);
+    if (m_IsStop) {
+        qCWarning(appLog) << "Driver scan interrupted by network error";
+        emit scanFinished(SR_NETWORD_ERR);
+        return;
+    }
 
-            // qCDebug(appLog) << "Driver scan progress:" << info->name() << "progress:" << 100 / m_ListDriverInfo.size();
-            emit scanInfo(info->name(), 100 / m_ListDriverInfo.size());
-            sleep(1);
-        } else {
-            qCWarning(appLog) << "Scan interrupted for driver:" << info->name();
-            emit scanFinished(SR_NETWORD_ERR);
-        }
+    // 所有候选包的本地安装信息只查询一次
+    QMap<DriverInfo *, QList<RepoDriverInfo>> mapRepoInfo;
+    QStringList packages;
+    for (auto iter = mapJson.begin(); iter != mapJson.end(); ++iter) {
+        QList<RepoDriverInfo> lstRepoInfo;
+        if (!hdi->convertJsonToDeviceList(iter.value(), lstRepoInfo))
+            continue;
+        foreach (const RepoDriverInfo &repoInfo, lstRepoInfo)
+            packages.append(repoInfo.strPackages);
+        mapRepoInfo.insert(iter.key(), lstRepoInfo);
     }
+    QMap<QString, QString> mapPolicy = HttpDriverInterface::aptPolicy(packages);
 
-    if (!m_IsStop) {
-        // 扫描结束
-        qCDebug(appLog) << "Driver scan completed successfully";
-        usleep(10000);
-        emit scanFinished(SR_SUCESS);
-    } else {
-        qCWarning(appLog) << "Driver scan interrupted by network error";
-        emit scanFinished(SR_NETWORD_ERR);
+    foreach (DriverInfo *info, m_ListDriverInfo) {
+        if (!mapRepoInfo.contains(info))
+            continue;
+        hdi->checkDriverInfo(mapRepoInfo[info], info, mapPolicy);
+
+        // 检测本地安装版本
+        QString curVersion;
+        if (!info->packages().isEmpty() && HttpDriverInterface::installedVersion(mapPolicy.value(info->packages()), curVersion))
+            info->m_Version = curVersion;
+        qCInfo(appLog) << "device name :" << info->name() << "m_Packages:" << info->m_Packages << "m_Status:" << info->m_Status;
     }
+
+    // 扫描结束
+    qCDebug(appLog) << "Driver scan completed successfully";
+    emit scanFinished(SR_SUCESS);
 }
 
 void DriverScanner::setDriverList(const QList<DriverInfo *> &lstInfo)
@@ -93,3 +82,57 @@ void DriverScanner::setDriverList(const QList<DriverInfo *> &lstInfo)
     m_IsStop = false;
 }
 
+bool DriverScanner::requestDriverInfo(QMap<DriverInfo *, QString> &mapJson)
+{
+    HttpDriverInterface *hdi  = HttpDriverInterface::getInstance();
+    QNetworkAccessManager *manager = HttpDriverInterface::networkManager();
+    int progress = m_ListDriverInfo.isEmpty() ? 0 : 100 / m_ListDriverInfo.size();
+
+    QEventLoop loop;
+    QList<DriverInfo *> lstPending = m_ListDriverInfo;
+    QList<QNetworkReply *> lstReply;
+    bool networkError = false;
+
+    std::function<void()> startRequests = [&]() {
+        while (!networkError && lstReply.size() < MAX_PARALLEL_REQUESTS && !lstPending.isEmpty()) {
+            DriverInfo *info = lstPending.takeFirst();
+            QString strUrl = hdi->requestUrl(info);
+            if (strUrl.isEmpty()) {
+                emit scanInfo(info->name(), progress);
+                continue;
+            }
+
+            QNetworkReply *reply = manager->get(QNetworkRequest(QUrl::fromUserInput(strUrl)));
+            QTimer::singleShot(REQUEST_TIMEOUT, reply, &QNetworkReply::abort);
+            lstReply.append(reply);
+            connect(reply, &QNetworkReply::finished, &loop, [&, info, reply]() {
+                lstReply.removeOne(reply);
+                reply->deleteLater();
+                if (reply->error() != QNetworkReply::NoError) {
+                    qCWarning(appLog) << "Network error when getting driver info for:" << info->name() << reply->errorString();
+                    networkError = true;
+                    loop.quit();
+                    return;
+                }
+
+                mapJson.insert(info, QString(reply->readAll()));
+                emit scanInfo(info->name(), progress);
+                startRequests();
+                if (lstReply.isEmpty())
+                    loop.quit();
+            });
+        }
+    };
+
+    startRequests();
+    if (!lstReply.isEmpty())
+        loop.exec();
+
+    // 网络异常时中止其余请求
+    foreach (QNetworkReply *reply, lstReply) {
+        reply->disconnect(&loop);
+        reply->abort();
+        reply->deleteLater();
+    }
+    return !networkError;
+}
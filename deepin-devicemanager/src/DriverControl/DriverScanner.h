@@ -9,6 +9,7 @@
 #include "MacroDefinition.h"
 
 #include <QThread>
+#include <QMap>
 
 class DriverScanner : public QThread
 {
@@ -32,6 +33,13 @@ signals:
     void scanFinished(ScanResult sr);
 
 private:
+    /**
+     * @brief requestDriverInfo:并发查询所有设备的仓库驱动，同时进行的请求数不超过 MAX_PARALLEL_REQUESTS
+     * @param mapJson:设备与查询结果的对应关系
+     * @return 网络异常时返回false
+     */
+    bool requestDriverInfo(QMap<DriverInfo *, QString> &mapJson);
+
     QList<DriverInfo *>     m_ListDriverInfo;
     bool m_IsStop;
 };
@@ -11,6 +11,7 @@
 #include <QtNetwork>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QThreadStorage>
 
 #include <DSysInfo>
 
@@ -30,6 +31,15 @@ HttpDriverInterface::~HttpDriverInterface()
     qCDebug(appLog) << "HttpDriverInterface destructor";
 }
 
+QNetworkAccessManager *HttpDriverInterface::networkManager()
+{
+    // QNetworkAccessManager 只能在创建它的线程中使用，线程结束时释放
+    static QThreadStorage<QNetworkAccessManager *> s_NetworkManager;
+    if (!s_NetworkManager.hasLocalData())
+        s_NetworkManager.setLocalData(new QNetworkAccessManager);
+    return s_NetworkManager.localData();
+}
+
 QString HttpDriverInterface::getRequestJson(QString strUrl)
 {
     qCDebug(appLog) << "Get request from URL:" << strUrl;
@@ -37,22 +47,19 @@ QString HttpDriverInterface::getRequestJson(QString strUrl)
     const QUrl newUrl = QUrl::fromUserInput(strUrl);
 
     QNetworkRequest request(newUrl);
-    QNetworkAccessManager qnam;
-    QNetworkReply *reply = qnam.get(request);
+    QNetworkReply *reply = networkManager()->get(request);
 
-    QTimer timer;
-    timer.setSingleShot(true);
+    // 超时后中止请求，按网络错误处理
+    QTimer::singleShot(10000, reply, &QNetworkReply::abort);
     QEventLoop loop;
-    QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
     QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    timer.start(10000);
-    loop.exec();
+    if (!reply->isFinished())
+        loop.exec();
 
     strJsonDriverInfo = reply->readAll();
     //! [networkreply-error-handling-1]
     QNetworkReply::NetworkError error = reply->error();
 
-    reply->reset();
     reply->deleteLater();
     if (error != QNetworkReply::NoError) {
         qCInfo(appLog) << "strUrl : " << strUrl << "network error";
@@ -65,44 +72,48 @@ QString HttpDriverInterface::getRequestJson(QString strUrl)
 void HttpDriverInterface::getRequest(DriverInfo *driverInfo)
 {
     qCDebug(appLog) << "Get request for driver:" << driverInfo->m_Name << "Type:" << driverInfo->type();
-    QString strJson;
+    QString strUrl = requestUrl(driverInfo);
+    QString strJson = strUrl.isEmpty() ? QString() : getRequestJson(strUrl);
+    qCInfo(appLog) << "device name :" << driverInfo->m_Name  << "VendorId:" << driverInfo->m_VendorId << "ModelId:" << driverInfo->m_ModelId;
+    if (strJson.contains("network error")) {
+        qCWarning(appLog) << "Network error when getting driver info for:" << driverInfo->m_Name;
+        emit sigRequestFinished(false, "network error");
+    } else {
+        checkDriverInfo(strJson, driverInfo);
+        qCInfo(appLog) << "m_Packages:" << driverInfo->m_Packages;
+        qCInfo(appLog) << "m_DebVersion:" << driverInfo->m_DebVersion;
+        qCInfo(appLog) << "m_Status:" << driverInfo->m_Status;
+    }
+}
+
+QString HttpDriverInterface::requestUrl(DriverInfo *driverInfo)
+{
     switch (driverInfo->type()) {
     case DR_Printer:
-        strJson = getRequestPrinter(driverInfo->vendorName(), driverInfo->modelName()); break;
+        return getPrinterUrl(driverInfo->vendorName(), driverInfo->modelName());
     //case DR_Camera:
     case DR_Scaner:
-//        strJson = getRequestCamera(driverInfo->modelName());
-//        break;
+//        return getCameraUrl(driverInfo->modelName());
     case DR_Sound:
     case DR_Gpu:
     case DR_Network:
     case DR_OtherDevice:
     case DR_WiFi:
-        strJson = getRequestBoard(driverInfo->vendorId(), driverInfo->modelId());
-        break;
+        return getBoardUrl(driverInfo->vendorId(), driverInfo->modelId());
     default:
-        qCDebug(appLog) << "Unsupported driver type for getRequest:" << driverInfo->type();
+        qCDebug(appLog) << "Unsupported driver type for requestUrl:" << driverInfo->type();
         break;
     }
-    qCInfo(appLog) << "device name :" << driverInfo->m_Name  << "VendorId:" << driverInfo->m_VendorId << "ModelId:" << driverInfo->m_ModelId;
-    if (strJson.contains("network error")) {
-        qCWarning(appLog) << "Network error when getting driver info for:" << driverInfo->m_Name;
-        emit sigRequestFinished(false, "network error");
-    } else {
-        checkDriverInfo(strJson, driverInfo);
-        qCInfo(appLog) << "m_Packages:" << driverInfo->m_Packages;
-        qCInfo(appLog) << "m_DebVersion:" << driverInfo->m_DebVersion;
-        qCInfo(appLog) << "m_Status:" << driverInfo->m_Status;
-    }
+    return QString();
 }
 
-QString HttpDriverInterface::getRequestBoard(QString strManufacturer, QString strModels, int iClassP, int iClass)
+QString HttpDriverInterface::getBoardUrl(QString strManufacturer, QString strModels, int iClassP, int iClass)
 {
     if(strManufacturer.isEmpty() || strModels.isEmpty()) {
         qCWarning(appLog) << "Empty manufacturer or model when getting board info";
         return QString();
     }
-    qCDebug(appLog) << "getRequestBoard with manufacturer:" << strManufacturer << "models:" << strModels;
+    qCDebug(appLog) << "getBoardUrl with manufacturer:" << strManufacturer << "models:" << strModels;
     QString arch = Common::getArchStore();
     QString build = getOsBuild();
     QString major, minor, strUrl;
@@ -147,13 +158,13 @@ QString HttpDriverInterface::getRequestBoard(QString strManufacturer, QString st
         }
     }
 
-    qCDebug(appLog) << "Constructed URL for getRequestBoard:" << strUrl;
-    return getRequestJson(strUrl);
+    qCDebug(appLog) << "Constructed URL for getBoardUrl:" << strUrl;
+    return strUrl;
 }
 
-QString HttpDriverInterface::getRequestPrinter(QString strDebManufacturer, QString strDesc)
+QString HttpDriverInterface::getPrinterUrl(QString strDebManufacturer, QString strDesc)
 {
-    qCDebug(appLog) << "getRequestPrinter with manufacturer:" << strDebManufacturer << "desc:" << strDesc;
+    qCDebug(appLog) << "getPrinterUrl with manufacturer:" << strDebManufacturer << "desc:" << strDesc;
     QString arch = Common::getArchStore();
     QString strUrl = CommonTools::getUrl() + "?arch=" + arch;
     int iType = DTK_CORE_NAMESPACE::DSysInfo::uosType();
@@ -170,13 +181,13 @@ QString HttpDriverInterface::getRequestPrinter(QString strDebManufacturer, QStri
     if (!strDesc.isEmpty()) {
         strUrl += "&desc=" + strDesc;
     }
-    qCDebug(appLog) << "Constructed URL for getRequestPrinter:" << strUrl;
-    return getRequestJson(strUrl);
+    qCDebug(appLog) << "Constructed URL for getPrinterUrl:" << strUrl;
+    return strUrl;
 }
 
-QString HttpDriverInterface::getRequestCamera(QString strDesc)
+QString HttpDriverInterface::getCameraUrl(QString strDesc)
 {
-    qCDebug(appLog) << "getRequestCamera with desc:" << strDesc;
+    qCDebug(appLog) << "getCameraUrl with desc:" << strDesc;
     QString arch = Common::getArchStore();
     QString strUrl = CommonTools::getUrl() + "?arch=" + arch;
     int iType = DTK_CORE_NAMESPACE::DSysInfo::uosType();
@@ -186,8 +197,8 @@ QString HttpDriverInterface::getRequestCamera(QString strDesc)
     if (!strDesc.isEmpty()) {
         strUrl += "&desc=" + strDesc;
     }
-    qCDebug(appLog) << "Constructed URL for getRequestCamera:" << strUrl;
-    return getRequestJson(strUrl);
+    qCDebug(appLog) << "Constructed URL for getCameraUrl:" << strUrl;
+    return strUrl;
 }
 
 void HttpDriverInterface::checkDriverInfo(QString strJson, DriverInfo *driverInfo)
@@ -204,6 +215,14 @@ void HttpDriverInterface::checkDriverInfo(QString strJson, DriverInfo *driverInf
         return;
     }
 
+    QStringList packages;
+    foreach (const RepoDriverInfo &info, lstDriverInfo)
+        packages.append(info.strPackages);
+    checkDriverInfo(lstDriverInfo, driverInfo, aptPolicy(packages));
+}
+
+void HttpDriverInterface::checkDriverInfo(const QList<RepoDriverInfo> &lstDriverInfo, DriverInfo *driverInfo, const QMap<QString, QString> &mapPolicy)
+{
     if (lstDriverInfo.size() == 0) {
         qCDebug(appLog) << "No driver info found in JSON.";
         return;
@@ -223,14 +242,14 @@ void HttpDriverInterface::checkDriverInfo(QString strJson, DriverInfo *driverInf
     for (int i = 0; i < lstDriverInfo.size(); i++) {
         if (max == lstDriverInfo[i].iLevel) {
             // 选中第一个最优等级的index
-            int res = packageInstall(lstDriverInfo[i].strPackages, lstDriverInfo[i].strDebVersion);
+            int res = packageInstall(lstDriverInfo[i].strPackages, lstDriverInfo[i].strDebVersion, mapPolicy);
             if (res > 0) {
                 res_out = res;
                 index = i;
             }
         }
         if (index == 0) {
-            int res = packageInstall(lstDriverInfo[index].strPackages, lstDriverInfo[index].strDebVersion);
+            int res = packageInstall(lstDriverInfo[index].strPackages, lstDriverInfo[index].strDebVersion, mapPolicy);
             if (res > 0) {
                 res_out = res;
             }
@@ -261,40 +280,24 @@ void HttpDriverInterface::checkDriverInfo(QString strJson, DriverInfo *driverInf
 }
 
 int HttpDriverInterface::packageInstall(const QString &package_name, const QString &version)
+{
+    return packageInstall(package_name, version, aptPolicy(QStringList() << package_name));
+}
+
+int HttpDriverInterface::packageInstall(const QString &package_name, const QString &version, const QMap<QString, QString> &mapPolicy)
 {
     qCDebug(appLog) << "Checking package installation status for:" << package_name << "version:" << version;
     // 0:没有包 1:版本不一致 2:版本一致
-    QString outInfo = Common::executeClientCmd("apt", QStringList() << "policy" << package_name, QString(), -1, false);
-    if (outInfo.isEmpty()) {
-        qCDebug(appLog) << "No info from apt policy for package:" << package_name;
-        return 0;
-    }
-    qCDebug(appLog) << "apt policy output:" << outInfo;
-    QStringList infoList = outInfo.split("\n");
-    int index = 0;
-    for (int i = 0; i < infoList.size(); i++)
-    {
-        if (infoList[i].startsWith(package_name)) {
-            index = i;
-            qCDebug(appLog) << "Found package info at index:" << index;
-            break;
-        }
-    }
-    if (infoList.size() <= (2 + index) || infoList[1 + index].contains("（") || infoList[1 + index].contains("(")) {
+    QString curVersion;
+    if (!installedVersion(mapPolicy.value(package_name), curVersion)) {
         qCDebug(appLog) << "Installed version not found or in unexpected format.";
         return 0;
     }
-    if (infoList[1 + index].contains(version)) {
+    if (mapPolicy.value(package_name).contains(version)) {
         qCDebug(appLog) << "Installed version matches required version.";
         return 2;
     }
 
-    QRegularExpression rxlen("(\\d+\\S*)");
-    QRegularExpressionMatch match = rxlen.match(infoList[1 + index]);
-    QString curVersion;
-    if (match.hasMatch()) {
-        curVersion = match.captured(1);
-    }
     qCDebug(appLog) << "Current installed version:" << curVersion;
     // 若当前已安装版本高于推荐版本，不再更新
     if (curVersion >= version) {
@@ -306,6 +309,46 @@ int HttpDriverInterface::packageInstall(const QString &package_name, const QStri
     }
 }
 
+QMap<QString, QString> HttpDriverInterface::aptPolicy(const QStringList &packages)
+{
+    QMap<QString, QString> mapPolicy;
+    QStringList lstPackage = packages;
+    lstPackage.removeAll(QString());
+    lstPackage.removeDuplicates();
+    if (lstPackage.isEmpty())
+        return mapPolicy;
+
+    QString outInfo = Common::executeClientCmd("apt", QStringList() << "policy" << lstPackage, QString(), -1, false);
+    if (outInfo.isEmpty()) {
+        qCDebug(appLog) << "No info from apt policy for packages:" << lstPackage;
+        return mapPolicy;
+    }
+
+    // 每个包以 "包名:" 开头，下一行为已安装版本
+    QStringList infoList = outInfo.split("\n");
+    for (int i = 0; i + 1 < infoList.size(); i++) {
+        const QString &line = infoList[i];
+        if (line.isEmpty() || line[0].isSpace() || !line.endsWith(":"))
+            continue;
+        QString name = line.left(line.size() - 1);
+        if (lstPackage.contains(name) && !mapPolicy.contains(name))
+            mapPolicy.insert(name, infoList[i + 1]);
+    }
+    return mapPolicy;
+}
+
+bool HttpDriverInterface::installedVersion(const QString &policyLine, QString &version)
+{
+    // 未安装时显示为 (none) 或 （无）
+    if (policyLine.isEmpty() || policyLine.contains("（") || policyLine.contains("("))
+        return false;
+
+    QRegularExpression rxlen("(\\d+\\S*)");
+    QRegularExpressionMatch match = rxlen.match(policyLine);
+    version = match.hasMatch() ? match.captured(1).trimmed() : QString();
+    return true;
+}
+
 QString HttpDriverInterface::getOsBuild()
 {
     qCDebug(appLog) << "Get OS build info";
@@ -12,6 +12,7 @@
 #include <QLoggingCategory>
 #include <QNetworkAccessManager>
 #include <QUrl>
+#include <QMap>
 
 #include <mutex>
 
@@ -40,18 +41,55 @@ public:
     void getRequest(DriverInfo *driverInfo);
 
     bool convertJsonToDeviceList(QString strJson, QList<RepoDriverInfo> &lstDriverInfo);
+
+    /**
+     * @brief requestUrl:获取设备驱动的仓库查询地址
+     * @param driverInfo:驱动信息
+     * @return 不需要查询的设备返回空
+     */
+    QString requestUrl(DriverInfo *driverInfo);
+
+    /**
+     * @brief checkDriverInfo:根据仓库查询结果设置驱动的包名、版本和状态
+     * @param lstDriverInfo:仓库中的驱动
+     * @param driverInfo:驱动信息
+     * @param mapPolicy:aptPolicy 获取的包安装信息
+     */
+    void checkDriverInfo(const QList<RepoDriverInfo> &lstDriverInfo, DriverInfo *driverInfo, const QMap<QString, QString> &mapPolicy);
+
+    /**
+     * @brief networkManager:当前线程共用的 QNetworkAccessManager，复用到仓库服务器的连接
+     * @return
+     */
+    static QNetworkAccessManager *networkManager();
+
+    /**
+     * @brief aptPolicy:执行一次 apt policy 获取所有包的安装信息
+     * @param packages:包名列表
+     * @return 包名与其 Installed 行的对应关系
+     */
+    static QMap<QString, QString> aptPolicy(const QStringList &packages);
+
+    /**
+     * @brief installedVersion:从 Installed 行中获取已安装的版本
+     * @param policyLine:aptPolicy 获取的 Installed 行
+     * @param version:已安装的版本
+     * @return 没有安装时返回false
+     */
+    static bool installedVersion(const QString &policyLine, QString &version);
 protected:
     explicit HttpDriverInterface(QObject* parent = nullptr);
     virtual ~HttpDriverInterface();
     QString getRequestJson(QString strUrl);//从仓库接口查询获取json字符串
 
-    QString getRequestBoard(QString strManufacturer = "", QString strModels = "", int iClassP = 0, int iClass = 0);//板卡设备用
-    QString getRequestPrinter(QString strDebManufacturer = "", QString strDesc = "");//打印机用
-    QString getRequestCamera(QString strDesc = "");//图像设备
+    QString getBoardUrl(QString strManufacturer = "", QString strModels = "", int iClassP = 0, int iClass = 0);//板卡设备用
+    QString getPrinterUrl(QString strDebManufacturer = "", QString strDesc = "");//打印机用
+    QString getCameraUrl(QString strDesc = "");//图像设备
     void checkDriverInfo(QString strJson, DriverInfo *driverInfo);
 
 private:
     int packageInstall(const QString& package_name, const QString& version);
+    int packageInstall(const QString& package_name, const QString& version, const QMap<QString, QString> &mapPolicy);
     QString getOsBuild();
     bool getVersion(QString &major, QString &minor);
 public:
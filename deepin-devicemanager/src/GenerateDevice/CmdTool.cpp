@@ -15,12 +15,14 @@
 #include<QMutex>
 #include <QCryptographicHash>
 #include <QRegularExpression>
+#include <QHash>
 
 // 其它头文件
 #include "../commondefine.h"
 #include "EDIDParser.h"
 #include "DeviceManager.h"
 #include "DBusInterface.h"
+#include "DBusBluezInterface.h"
 #include "DBusEnableInterface.h"
 #include "MacroDefinition.h"
 using namespace DDLog;
@@ -138,37 +140,41 @@ void CmdTool::getMapInfo(QMap<QString, QString> &mapInfo, cups_dest_t *src)
 void CmdTool::loadCmdInfo(const QString &key, const QString &debugFile)
 {
     qCInfo(appLog) << "CmdTool::loadCmdInfo start, key:" << key << "debugFile:" << debugFile;
+    // 命令关键字与解析函数的对照表，只在第一次使用时构造
+    typedef void (*CmdLoader)(CmdTool &tool, const QString &key, const QString &debugFile);
+    static const QMap<QString, CmdLoader> s_Loaders = {
+        { "lshw",        [](CmdTool &tool, const QString &, const QString &file) { tool.loadLshwInfo(file); } },
+        { "lsblk_d",     [](CmdTool &tool, const QString &, const QString &file) { tool.loadLsblkInfo(file); } },
+        { "ls_sg",       [](CmdTool &tool, const QString &, const QString &file) { tool.loadLssgInfo(file); } },
+        { "dmesg",       [](CmdTool &tool, const QString &, const QString &file) { tool.loadDmesgInfo(file); } },
+        { "hciconfig",   [](CmdTool &tool, const QString &, const QString &file) { tool.loadHciconfigInfo(file); } },
+        { "printer",     [](CmdTool &tool, const QString &, const QString &) { tool.loadPrinterInfo(); } },
+        { "upower",      [](CmdTool &tool, const QString &k, const QString &file) { tool.loadUpowerInfo(k, file); } },
+        { "cat_devices", [](CmdTool &tool, const QString &k, const QString &file) { tool.loadCatInputDeviceInfo(k, file); } },
+        { "cat_audio",   [](CmdTool &tool, const QString &k, const QString &file) { tool.loadCatAudioInfo(k, file); } },
+        { "bootdevice",  [](CmdTool &tool, const QString &k, const QString &file) { tool.loadBootDeviceManfid(k, file); } },
+        { "lscpu",       [](CmdTool &tool, const QString &k, const QString &file) { tool.loadLscpuInfo(k, file); } },
+        { "dr_config",   [](CmdTool &tool, const QString &k, const QString &file) { tool.loadCatConfigInfo(k, file); } },
+        { "nvidia",      [](CmdTool &tool, const QString &k, const QString &file) { tool.loadNvidiaSettingInfo(k, file); } },
+    };
+    // 以下前缀的关键字共用同一个解析函数
+    static const QList<QPair<QString, CmdLoader>> s_PrefixLoaders = {
+        { "hwinfo",      [](CmdTool &tool, const QString &k, const QString &file) { tool.loadHwinfoInfo(k, file); } },
+        { "dmidecode",   [](CmdTool &tool, const QString &k, const QString &file) { tool.loadDmidecodeInfo(k, file); } },
+    };
+
     // 根据命令获取设备文件信息
-    if ("lshw" == key)
-        loadLshwInfo(debugFile);
-    else if ("lsblk_d" == key)
-        loadLsblkInfo(debugFile);
-    else if ("ls_sg" == key)
-        loadLssgInfo(debugFile);
-    else if ("dmesg" == key)
-        loadDmesgInfo(debugFile);
-    else if ("hciconfig" == key)
-        loadHciconfigInfo(debugFile);
-    else if ("printer" == key)
-        loadPrinterInfo();
-    else if ("upower" == key)
-        loadUpowerInfo(key, debugFile);
-    else if (key.startsWith("hwinfo"))
-        loadHwinfoInfo(key, debugFile);
-    else if (key.startsWith("dmidecode"))
-        loadDmidecodeInfo(key, debugFile);
-    else if ("cat_devices" == key)
-        loadCatInputDeviceInfo(key, debugFile);
-    else if ("cat_audio" == key)
-        loadCatAudioInfo(key, debugFile);
-    else if ("bootdevice" == key)
-        loadBootDeviceManfid(key, debugFile);    // 加载蓝牙设备配对信息
-    else if ("lscpu" == key)
-        loadLscpuInfo(key, debugFile);
-    else if ("dr_config" == key)
-        loadCatConfigInfo(key, debugFile);
-    else if ("nvidia" == key)
-        loadNvidiaSettingInfo(key, debugFile);
+    CmdLoader loader = s_Loaders.value(key, nullptr);
+    if (!loader) {
+        for (const QPair<QString, CmdLoader> &prefix : s_PrefixLoaders) {
+            if (key.startsWith(prefix.first)) {
+                loader = prefix.second;
+                break;
+            }
+        }
+    }
+    if (loader)
+        loader(*this, key, debugFile);
     else
         loadCatInfo(key, debugFile);
     qCInfo(appLog) << "CmdTool::loadCmdInfo end, key:" << key;
@@ -419,21 +425,33 @@ void CmdTool::loadLsblkInfo(const QString &debugfile)
         return;
     }
 
-    QStringList lines = deviceInfo.split("\n");
     QMap<QString, QString> mapInfo;
 
-    // 获取存储设备逻辑名称以及ROTA信息
-    foreach (QString line, lines) {
-        QStringList words = line.replace(QRegularExpression("[\\s]+"), " ").split(" ");
-        if (words.size() != 2 || "NAME" == words[0]) {
+    // 获取存储设备逻辑名称以及ROTA信息，每行只有以空白分隔的两列
+    int pos = 0;
+    while (pos < deviceInfo.size()) {
+        QStringView line = nextLine(deviceInfo, pos);
+        int nameEnd = 0;
+        while (nameEnd < line.size() && !line[nameEnd].isSpace())
+            ++nameEnd;
+        int rotaStart = nameEnd;
+        while (rotaStart < line.size() && line[rotaStart].isSpace())
+            ++rotaStart;
+        int rotaEnd = rotaStart;
+        while (rotaEnd < line.size() && !line[rotaEnd].isSpace())
+            ++rotaEnd;
+
+        QStringView name = line.left(nameEnd);
+        if (name.isEmpty() || rotaStart == rotaEnd || rotaEnd != line.size() || name == QLatin1String("NAME")) {
             qCDebug(appLog) << "Skipping invalid lsblk line:" << line;
             continue;
         }
 
-        mapInfo.insert(words[0].trimmed(), words[1].trimmed());
+        const QString logicalName = name.toString();
+        mapInfo.insert(logicalName, line.mid(rotaStart).toString());
 
         //sudo smartctl --all /dev/%1   文件信息
-        loadSmartCtlInfo(words[0].trimmed(), "smartctl_" + words[0].trimmed() + ".txt");
+        loadSmartCtlInfo(logicalName, "smartctl_" + logicalName + ".txt");
     }
     addMapInfo("lsblk_d", mapInfo);
 }
@@ -498,29 +516,10 @@ void CmdTool::loadDmesgInfo(const QString &debugfile)
 
     // 获取显存大小信息
     QMap<QString, QString> mapInfo;
-    QStringList lines = deviceInfo.split("\n");
-    foreach (const QString &line, lines) {
-        // DeviceCdrom m_HwinfoToLshw 值为0000:01:00.0 此处同步修改,否则显存大小无法显示
-        QRegularExpression reg(".*([0-9a-z]{4}:[0-9a-z]{2}:[0-9a-z]{2}.[0-9]{1}):.*VRAM([=:]{1}) ([0-9]*)[\\s]{0,1}M.*");
-        if (reg.match(line).hasMatch()) {
-            qCDebug(appLog) << "Found VRAM info in dmesg:" << line;
-            double size = reg.match(line).captured(3).toDouble();
-            QString sizeS = QString("%1GB").arg(size / 1024);
-            mapInfo["Size"] = reg.match(line).captured(1) + "=" + sizeS;
-        }
-
-        // Bug-85049 JJW 显存特殊处理
-        QRegularExpression regJJW(".*VRAM Size ([0-9]*)M.*");
-        if (regJJW.match(line).hasMatch()) {
-            qCDebug(appLog) << "Found JJW VRAM info in dmesg:" << line;
-            double size = regJJW.match(line).captured(1).toDouble();
-            QString sizeS = QString("%1GB").arg(size / 1024);
-            mapInfo["Size"] = "null=" + sizeS;
-        }
-    }
-    addMapInfo("dmesg", mapInfo);
-
-    mapInfo.clear();
+    // DeviceCdrom m_HwinfoToLshw 值为0000:01:00.0 此处同步修改,否则显存大小无法显示
+    static const QRegularExpression reg(".*([0-9a-z]{4}:[0-9a-z]{2}:[0-9a-z]{2}.[0-9]{1}):.*VRAM([=:]{1}) ([0-9]*)[\\s]{0,1}M.*");
+    // Bug-85049 JJW 显存特殊处理
+    static const QRegularExpression regJJW(".*VRAM Size ([0-9]*)M.*");
 
     // 声卡芯片型号
     /* 正则表达式匹配的字符串实例：
@@ -528,14 +527,40 @@ void CmdTool::loadDmesgInfo(const QString &debugfile)
      * ALC887-VD:
      * ALC887:
     */
-    foreach (const QString &line, lines) {
-        QRegularExpression reg(".*autoconfig for ([A-Za-z0-9]{6}( [A-Za-z0-9]+|-[A-Za-z0-9]+|)):.*");
-        if (reg.match(line).hasMatch()) {
-            QString chip = reg.match(line).captured(1);
-            mapInfo["chip"] = chip;
+    QMap<QString, QString> chipInfo;
+    static const QRegularExpression regChip(".*autoconfig for ([A-Za-z0-9]{6}( [A-Za-z0-9]+|-[A-Za-z0-9]+|)):.*");
+
+    int pos = 0;
+    while (pos < deviceInfo.size()) {
+        QStringView lineView = nextLine(deviceInfo, pos);
+        // 大部分行不包含显存和声卡信息，先做简单判断，命中时才拷贝给正则匹配
+        if (lineView.contains(QLatin1String("VRAM"))) {
+            const QString line = lineView.toString();
+            QRegularExpressionMatch match = reg.match(line);
+            if (match.hasMatch()) {
+                qCDebug(appLog) << "Found VRAM info in dmesg:" << line;
+                double size = match.captured(3).toDouble();
+                QString sizeS = QString("%1GB").arg(size / 1024);
+                mapInfo["Size"] = match.captured(1) + "=" + sizeS;
+            }
+
+            match = regJJW.match(line);
+            if (match.hasMatch()) {
+                qCDebug(appLog) << "Found JJW VRAM info in dmesg:" << line;
+                double size = match.captured(1).toDouble();
+                QString sizeS = QString("%1GB").arg(size / 1024);
+                mapInfo["Size"] = "null=" + sizeS;
+            }
+        }
+
+        if (lineView.contains(QLatin1String("autoconfig for"))) {
+            QRegularExpressionMatch match = regChip.match(lineView.toString());
+            if (match.hasMatch())
+                chipInfo["chip"] = match.captured(1);
         }
     }
-    addMapInfo("audiochip", mapInfo);
+    addMapInfo("dmesg", mapInfo);
+    addMapInfo("audiochip", chipInfo);
 }
 
 void CmdTool::loadHciconfigInfo(const QString &debugfile)
@@ -592,6 +617,13 @@ void CmdTool::loadBluetoothCtlInfo(QMap<QString, QString> &mapInfo)
         addMapInfo("hciconfig", mapInfo);
         return;
     }
+
+    // 优先从 BlueZ 缓存的对象中获取，bluetoothd 不可用时才执行 bluetoothctl
+    if (DBusBluezInterface::getInstance()->adapterInfo(mapInfo["BD Address"], mapInfo)) {
+        addMapInfo("hciconfig", mapInfo);
+        return;
+    }
+
     QProcess process;
     process.start("bluetoothctl show " + mapInfo["BD Address"]);
     process.waitForFinished(2000);
@@ -743,10 +775,11 @@ void CmdTool::addWidthToMap(QMap<QString, QString> &mapInfo)
     process.waitForFinished(-1);
     sInfo = process.readAllStandardOutput();
     QStringList lines = sInfo.split("\n");
+    static const QRegularExpression reg("\\s\\sAttribute\\s'GPUMemoryInterface' \\(.*\\):\\s([0-9]{2}).*");
     foreach (const QString &line, lines) {
-        QRegularExpression reg("\\s\\sAttribute\\s'GPUMemoryInterface' \\(.*\\):\\s([0-9]{2}).*");
-        if (reg.match(line).hasMatch()) {
-            mapInfo.insert("Width", reg.match(line).captured(1) + " bits");
+        QRegularExpressionMatch match = reg.match(line);
+        if (match.hasMatch()) {
+            mapInfo.insert("Width", match.captured(1) + " bits");
             // qCDebug(appLog) << "Found width:" << mapInfo["Width"];
         }
     }
@@ -947,6 +980,9 @@ void CmdTool::loadCatInputDeviceInfo(const QString &key, const QString &debugfil
         return;
     }
 
+    // 获取与正则表达式匹配的输入设备
+    static const QRegularExpression rem(".*(event[0-9]{1,2}).*");
+    static const QRegularExpression re(".*(mouse[0-9]{1,2}).*");
     QStringList items = deviceInfo.split("\n\n");
     foreach (const QString &item, items) {
         if (item.isEmpty())
@@ -955,16 +991,15 @@ void CmdTool::loadCatInputDeviceInfo(const QString &key, const QString &debugfil
         QMap<QString, QString> mapInfo;
         getMapInfoFromInput(item, mapInfo, "=");
 
-        // 获取与正则表达式匹配的输入设备
-        QRegularExpression rem(".*(event[0-9]{1,2}).*");
-        if (rem.match(mapInfo["Handlers"]).hasMatch()) {
-            QString name = rem.match(mapInfo["Handlers"]).captured(1);
+        QRegularExpressionMatch eventMatch = rem.match(mapInfo["Handlers"]);
+        if (eventMatch.hasMatch()) {
+            QString name = eventMatch.captured(1);
             qCDebug(appLog) << "Found event device:" << name;
             DeviceManager::instance()->addInputInfo(name, mapInfo);
         } else {
-            QRegularExpression re(".*(mouse[0-9]{1,2}).*");
-            if (re.match(mapInfo["Handlers"]).hasMatch()) {
-                QString name = re.match(mapInfo["Handlers"]).captured(1);
+            QRegularExpressionMatch mouseMatch = re.match(mapInfo["Handlers"]);
+            if (mouseMatch.hasMatch()) {
+                QString name = mouseMatch.captured(1);
                 qCDebug(appLog) << "Found mouse device:" << name;
                 DeviceManager::instance()->addInputInfo(name, mapInfo);
             }
@@ -1036,11 +1071,12 @@ void CmdTool::getSMBIOSVersion(const QString &info, QString &version)
     qCDebug(appLog) << "Getting SMBIOS version.";
     QStringList lineList = info.split("\n");
 
+    //  SMBIOS 3.0.0 present.
+    static const QRegularExpression rx("^SMBIOS ([\\d]*.[\\d]*.[\\d])+ present.$");
     foreach (auto line, lineList) {
-        //  SMBIOS 3.0.0 present.
-        QRegularExpression rx("^SMBIOS ([\\d]*.[\\d]*.[\\d])+ present.$");
-        if (rx.match(line).hasMatch()) {
-            version = rx.match(line).captured(1);
+        QRegularExpressionMatch match = rx.match(line);
+        if (match.hasMatch()) {
+            version = match.captured(1);
             qCDebug(appLog) << "Found SMBIOS version:" << version;
             break;
         }
@@ -1184,38 +1220,74 @@ void CmdTool::loadNvidiaSettingInfo(const QString &key, const QString &debugfile
 
 }
 
+QStringView CmdTool::nextLine(const QString &info, int &pos)
+{
+    int end = info.indexOf('\n', pos);
+    if (end < 0)
+        end = info.size();
+    QStringView line = QStringView(info).mid(pos, end - pos);
+    pos = end + 1;
+    return line;
+}
+
+bool CmdTool::splitKeyValue(QStringView line, const QString &ch, QString &key, QString &value)
+{
+    // 与 split(ch).size() == 2 的判断保持一致
+    int index = line.indexOf(ch);
+    if (index < 0 || line.indexOf(ch, index + ch.size()) >= 0)
+        return false;
+
+    key = line.left(index).trimmed().toString();
+    value = line.mid(index + ch.size()).trimmed().toString();
+    return true;
+}
+
 void CmdTool::getMapInfoFromCmd(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch)
 {
     qCDebug(appLog) << "Getting map info from command output with separator:" << ch;
-    QStringList infoList = info.split("\n");
-    for (QStringList::iterator it = infoList.begin(); it != infoList.end(); ++it) {
-        QStringList words = (*it).split(ch);
-        if (2 == words.size())
-            mapInfo.insert(words[0].trimmed(), words[1].trimmed());
+    QString key, value;
+    int pos = 0;
+    while (pos < info.size()) {
+        if (splitKeyValue(nextLine(info, pos), ch, key, value))
+            mapInfo.insert(key, value);
     }
 }
 
 void CmdTool::getMapInfoFromInput(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch)
 {
     qCDebug(appLog) << "Getting map info from input with separator:" << ch;
-    QStringList infoList = info.split("\n");
-    for (QStringList::iterator it = infoList.begin(); it != infoList.end(); ++it) {
-        *it = (*it).replace(QRegularExpression("^[A-Z]: "), "");
-        *it = (*it).trimmed();
-        if ((*it).count(ch) > 2) {
-            QStringList words = (*it).split(" ");
-            foreach (auto attri, words) {
-                QStringList attriList = attri.split(ch);
-
-                if (2 == attriList.size())
-                    mapInfo.insert(attriList[0].trimmed(), attriList[1].trimmed().replace("\"", ""));
+    QString key, value;
+    int pos = 0;
+    while (pos < info.size()) {
+        QStringView line = nextLine(info, pos);
+        // 去掉 "I: "、"N: " 等行首标识
+        if (line.size() >= 3 && line[0] >= 'A' && line[0] <= 'Z' && line[1] == ':' && line[2] == ' ')
+            line = line.mid(3);
+        line = line.trimmed();
+
+        // 分隔符出现的位置，最多记录三个
+        int sep[3] = {-1, -1, -1};
+        int sepCount = 0;
+        for (int index = line.indexOf(ch); index >= 0 && sepCount < 3; index = line.indexOf(ch, index + ch.size()))
+            sep[sepCount++] = index;
+
+        if (sepCount > 2) {
+            // 一行有多个属性，以空格分隔
+            int wordStart = 0;
+            while (wordStart <= line.size()) {
+                int wordEnd = line.indexOf(QLatin1Char(' '), wordStart);
+                if (wordEnd < 0)
+                    wordEnd = line.size();
+                if (splitKeyValue(line.mid(wordStart, wordEnd - wordStart), ch, key, value))
+                    mapInfo.insert(key, value.remove("\""));
+                wordStart = wordEnd + 1;
             }
-        } else {
-            QStringList attriList = (*it).split(ch);
-            if (2 == attriList.size())
-                mapInfo.insert(attriList[0].trimmed(), attriList[1].trimmed().replace("\"", ""));
-            else if (3 == attriList.size())
-                mapInfo.insert(attriList[0].trimmed(), attriList[1].trimmed() + attriList[2].trimmed());
+        } else if (2 == sepCount) {
+            mapInfo.insert(line.left(sep[0]).trimmed().toString(),
+                           line.mid(sep[0] + ch.size(), sep[1] - sep[0] - ch.size()).trimmed().toString()
+                           + line.mid(sep[1] + ch.size()).trimmed().toString());
+        } else if (splitKeyValue(line, ch, key, value)) {
+            mapInfo.insert(key, value.remove("\""));
         }
     }
 }
@@ -1223,16 +1295,14 @@ void CmdTool::getMapInfoFromInput(const QString &info, QMap<QString, QString> &m
 void CmdTool::getMapInfoFromLshw(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch)
 {
     qCDebug(appLog) << "Getting map info from lshw output.";
-    QStringList infoList = info.split("\n");
-    for (QStringList::iterator it = infoList.begin(); it != infoList.end(); ++it) {
-        QStringList words = (*it).split(ch);
-        if (words.size() != 2)
+    QString keyStr, valueStr;
+    int pos = 0;
+    while (pos < info.size()) {
+        if (!splitKeyValue(nextLine(info, pos), ch, keyStr, valueStr))
             continue;
 
         // && words[0].contains("configuration") == false && words[0].contains("resources") == false
         // 将configuration的内容进行拆分
-        QString keyStr = words[0].trimmed();
-        QString valueStr = words[1].trimmed();
         if (keyStr.contains("configuration")) {
             qCDebug(appLog) << "Parsing lshw configuration.";
             QStringList keyValues = valueStr.split(" ");
@@ -1354,42 +1424,46 @@ void CmdTool::getMapInfoFromHwinfo(const QString &info, QMap<QString, QString> &
     QString tmpvalue;
     QString tmpvid;
     tmpvid.clear();
-    QStringList infoList = info.split("\n");
-    for (QStringList::iterator it = infoList.begin(); it != infoList.end(); ++it) {
-        QStringList words = (*it).split(ch);
-        if ((*it).contains("PS/2 Mouse")) {
+    static const QRegularExpression regQuote(".*\"(.*)\".*");
+    QString wordKey, wordValue;
+    int pos = 0;
+    while (pos < info.size()) {
+        QStringView line = nextLine(info, pos);
+        bool valid = splitKeyValue(line, ch, wordKey, wordValue);
+        if (line.contains(QLatin1String("PS/2 Mouse"))) {
             qCDebug(appLog) << "Found PS/2 Mouse, setting Hotplug to PS/2.";
-            words.clear();
-            words << "Hotplug" << "PS/2";
+            wordKey = "Hotplug";
+            wordValue = "PS/2";
+            valid = true;
         }
-        if ((*it).contains("SubDevice:")) {
+        if (line.contains(QLatin1String("SubDevice:"))) {
             tmpkey = "PsubID";
         }
-        if (words.size() != 2)
+        if (!valid)
             continue;
 
-        if (mapInfo.find(words[0].trimmed()) != mapInfo.end())
-            mapInfo[words[0].trimmed()] += QString(" ");
+        if (mapInfo.find(wordKey) != mapInfo.end())
+            mapInfo[wordKey] += QString(" ");
 
         /*pick PID VID*/
         if (
-            ("SubDevice" ==  words[0].trimmed() || "SubVendor" == words[0].trimmed() ||
-             "Vendor" ==  words[0].trimmed() || "Device" == words[0].trimmed())
-            && !(words[1].trimmed().isEmpty() ||  words[1].trimmed().contains("unknown"))
-            && words[1].trimmed().contains("0x")
+            ("SubDevice" ==  wordKey || "SubVendor" == wordKey ||
+             "Vendor" ==  wordKey || "Device" == wordKey)
+            && !(wordValue.isEmpty() ||  wordValue.contains("unknown"))
+            && wordValue.contains("0x")
         ) {
-            if ("SubDevice" ==  words[0].trimmed()) {
+            if ("SubDevice" ==  wordKey) {
                 tmpkey = "PsubID";
-                tmpvalue = words[1].trimmed(); //re.cap(0);
-            } else if ("SubVendor" ==  words[0].trimmed()) {
+                tmpvalue = wordValue; //re.cap(0);
+            } else if ("SubVendor" ==  wordKey) {
                 tmpkey = "VsubID";
-                tmpvalue = words[1].trimmed();
-            } else if ("Vendor" ==  words[0].trimmed()) {
+                tmpvalue = wordValue;
+            } else if ("Vendor" ==  wordKey) {
                 tmpkey = "VID";
-                tmpvalue = words[1].trimmed();
-            } else if ("Device" ==  words[0].trimmed()) {
+                tmpvalue = wordValue;
+            } else if ("Device" ==  wordKey) {
                 tmpkey = "PID";
-                tmpvalue = words[1].trimmed();
+                tmpvalue = wordValue;
             }
 
             QStringList tmpword = tmpvalue.split(" ");
@@ -1410,10 +1484,10 @@ void CmdTool::getMapInfoFromHwinfo(const QString &info, QMap<QString, QString> &
             }
         }
 
-        QRegularExpression re(".*\"(.*)\".*");
-        if (re.match(words[1].trimmed()).hasMatch()) {
-            QString key = words[0].trimmed();
-            QString value = re.match(words[1].trimmed()).captured(1);
+        QRegularExpressionMatch quoteMatch = regQuote.match(wordValue);
+        if (quoteMatch.hasMatch()) {
+            QString key = wordKey;
+            QString value = quoteMatch.captured(1);
 
             //这里是为了防止  "usb-storage", "sr"  -》 usb-storage", "sr
             // bug112311 驱动模块显示异常
@@ -1426,22 +1500,22 @@ void CmdTool::getMapInfoFromHwinfo(const QString &info, QMap<QString, QString> &
 
         } else {
             // 此处如果subDevice,subVendor,Device没有值，则过滤
-//            if ("SubDevice" ==  words[0].trimmed() ||
-//                    "SubVendor" == words[0].trimmed() ||
-//                    "Device" == words[0].trimmed()) {
+//            if ("SubDevice" ==  wordKey ||
+//                    "SubVendor" == wordKey ||
+//                    "Device" == wordKey) {
 //                continue;
 //            }
-            if ("Resolution" == words[0].trimmed()) {
-                mapInfo[words[0].trimmed()] += words[1].trimmed();
+            if ("Resolution" == wordKey) {
+                mapInfo[wordKey] += wordValue;
             } else {
                 // 如果信息中有unknown 则过滤
-                if (!words[1].trimmed().contains("unknown"))
-                    mapInfo[words[0].trimmed()] = words[1].trimmed();
+                if (!wordValue.contains("unknown"))
+                    mapInfo[wordKey] = wordValue;
             }
         }
-        if ((*it).contains("Config Status")) {
-            //qCInfo(appLog) << "  Config Status"<< words[0]<<words[1];
-            if(words[1].contains("avail=yes"))
+        if (line.contains(QLatin1String("Config Status"))) {
+            //qCInfo(appLog) << "  Config Status"<< wordKey<<wordValue;
+            if(wordValue.contains("avail=yes"))
                 mapInfo["cfg_avail"] = "yes";
         }
     }
@@ -1471,191 +1545,254 @@ void CmdTool::getMapInfoFromHwinfo(const QString &info, QMap<QString, QString> &
         mapInfo["Unique ID"] = QString::fromStdString(Hash.result().toBase64().toStdString());
     }
 
+    static const QRegularExpression regAlias("[0-9a-zA-Z]{10}$");
     if (mapInfo.find("Module Alias") != mapInfo.end())
-        mapInfo["Module Alias"].replace(QRegularExpression("[0-9a-zA-Z]{10}$"), "");
+        mapInfo["Module Alias"].replace(regAlias, "");
 
 }
 
 void CmdTool::getMapInfoFromDmidecode(const QString &info, QMap<QString, QString> &mapInfo, const QString &ch)
 {
     qCDebug(appLog) << "Getting map info from dmidecode.";
-    QStringList lines = info.split("\n");
-    QString lasKey;
-    foreach (const QString &line, lines) {
+    QString lasKey, key, value;
+    int pos = 0;
+    while (pos < info.size()) {
+        QStringView line = nextLine(info, pos);
         if (line.isEmpty())
             continue;
 
-        QStringList words = line.split(ch);
-        if (1 ==  words.size() && words[0].endsWith(":")) {
-            lasKey = words[0].replace(QRegularExpression(":$"), "");
-            mapInfo.insert(lasKey.trimmed(), " ");
-        } else if (1 ==  words.size() && !lasKey.isEmpty()) {
-            qCDebug(appLog) << "Appending to last key:" << lasKey;
-            mapInfo[lasKey.trimmed()] += words[0];
-            mapInfo[lasKey.trimmed()] += "  /  ";
-        } else if (2 ==  words.size()) {
+        // 不包含分隔符的行为多行属性的名称或者值
+        if (line.indexOf(ch) < 0) {
+            if (line.endsWith(QLatin1Char(':'))) {
+                lasKey = line.left(line.size() - 1).trimmed().toString();
+                mapInfo.insert(lasKey, " ");
+            } else if (!lasKey.isEmpty()) {
+                qCDebug(appLog) << "Appending to last key:" << lasKey;
+                mapInfo[lasKey] += line.toString();
+                mapInfo[lasKey] += "  /  ";
+            }
+        } else if (splitKeyValue(line, ch, key, value)) {
             lasKey = "";
-            mapInfo.insert(words[0].trimmed(), words[1].trimmed());
+            mapInfo.insert(key, value);
         }
     }
 }
 
+static bool isAsciiDigit(QChar c)
+{
+    return c >= QLatin1Char('0') && c <= QLatin1Char('9');
+}
+
+// 与正则中的 \w 一致，只包含ASCII字母、数字和下划线
+static bool isWordChar(QChar c)
+{
+    return c.unicode() < 128 && (c.isLetterOrNumber() || c == QLatin1Char('_'));
+}
+
+static bool isWordOrDash(QChar c)
+{
+    return isWordChar(c) || c == QLatin1Char('-');
+}
+
+static bool isHexOrDash(QChar c)
+{
+    return isAsciiDigit(c) || (c >= QLatin1Char('a') && c <= QLatin1Char('f'))
+           || (c >= QLatin1Char('A') && c <= QLatin1Char('F')) || c == QLatin1Char('-');
+}
+
+static bool isRawChar(QChar c)
+{
+    return isWordOrDash(c) || c == QLatin1Char('/');
+}
+
+static bool isRawTailChar(QChar c)
+{
+    return isRawChar(c) || c == QLatin1Char('(') || c == QLatin1Char(')');
+}
+
+// 与正则 ^[\s\S]*[\d]:[\d][\s\S]*$ 等价，如时间 08:00
+static bool containsTime(QStringView line)
+{
+    for (int i = line.indexOf(QLatin1Char(':'), 1); i > 0 && i + 1 < line.size(); i = line.indexOf(QLatin1Char(':'), i + 1)) {
+        if (isAsciiDigit(line[i - 1]) && isAsciiDigit(line[i + 1]))
+            return true;
+    }
+    return false;
+}
+
+// 列数不符合属性表格式时(如 smartctl -x 的简写标志、原始值后的括号说明)仍需保留的常用属性
+// 先按名称查找，名称带有厂商后缀时(如 Power_On_Hours_and_Msec)按 ID 查找
+static QString smartctlAttributeKey(QStringView line)
+{
+    static const QHash<int, QString> ids = {
+        {1, "Raw_Read_Error_Rate"}, {3, "Spin_Up_Time"}, {4, "Start_Stop_Count"},
+        {5, "Reallocated_Sector_Ct"}, {7, "Seek_Error_Rate"}, {9, "Power_On_Hours"},
+        {10, "Spin_Retry_Count"}, {11, "Calibration_Retry_Count"}, {12, "Power_Cycle_Count"},
+        {191, "G-Sense_Error_Rate"}, {192, "Power-Off_Retract_Count"}, {193, "Load_Cycle_Count"},
+        {194, "Temperature_Celsius"}, {196, "Reallocated_Event_Count"}, {197, "Current_Pending_Sector"},
+        {198, "Offline_Uncorrectable"}, {199, "UDMA_CRC_Error_Count"}, {200, "Multi_Zone_Error_Rate"}
+    };
+    static const QHash<QString, int> names = [] {
+        QHash<QString, int> hash;
+        for (auto it = ids.begin(); it != ids.end(); ++it)
+            hash.insert(it.value(), it.key());
+        return hash;
+    }();
+
+    // 取前两列: ID 和属性名
+    QStringView columns[2];
+    int count = 0;
+    int pos = 0;
+    while (count < 2 && pos < line.size()) {
+        while (pos < line.size() && line[pos].isSpace())
+            ++pos;
+        int start = pos;
+        while (pos < line.size() && !line[pos].isSpace())
+            ++pos;
+        if (pos > start)
+            columns[count++] = line.mid(start, pos - start);
+    }
+    if (count < 2)
+        return QString();
+
+    QString name = columns[1].toString();
+    if (names.contains(name))
+        return name;
+
+    bool ok = false;
+    QString key = ids.value(columns[0].toString().toInt(&ok));
+    if (ok && !key.isEmpty() && name.startsWith(key))
+        return key;
+    return QString();
+}
+
+bool CmdTool::parseSmartctlAttribute(QStringView line, QStringView &name, QStringView &rawValue)
+{
+    // 与正则 ^[ ]*[0-9]+[ ]+([\w_-]+)[ ]+0x[0-9a-fA-F-]+([ ]+[0-9]+){3}([ ]+[\w-]+){3}[ ]+([0-9\w\/-]+[ ]*[0-9\w\/\-\(\)]*)$ 等价
+    // 每行只扫描一次: ID NAME FLAG VALUE WORST THRESH TYPE UPDATED WHEN_FAILED RAW_VALUE
+    const int size = line.size();
+    int pos = 0;
+    auto skipSpaces = [&line, &pos, size]() {
+        int start = pos;
+        while (pos < size && line[pos] == QLatin1Char(' '))
+            ++pos;
+        return pos > start;
+    };
+    auto column = [&line, &pos, size](bool (*accept)(QChar)) {
+        int start = pos;
+        while (pos < size && accept(line[pos]))
+            ++pos;
+        return line.mid(start, pos - start);
+    };
+
+    skipSpaces();
+    if (column(isAsciiDigit).isEmpty() || !skipSpaces())
+        return false;
+
+    name = column(isWordOrDash);
+    if (name.isEmpty() || !skipSpaces())
+        return false;
+
+    if (!line.mid(pos).startsWith(QLatin1String("0x")))
+        return false;
+    pos += 2;
+    if (column(isHexOrDash).isEmpty() || !skipSpaces())
+        return false;
+
+    for (int i = 0; i < 3; ++i) {
+        if (column(isAsciiDigit).isEmpty() || !skipSpaces())
+            return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        if (column(isWordOrDash).isEmpty() || !skipSpaces())
+            return false;
+    }
+
+    // 原始值最多两段，第二段可以包含括号，如 36 (Min/Max 15/45)
+    int rawStart = pos;
+    if (column(isRawChar).isEmpty())
+        return false;
+    skipSpaces();
+    column(isRawTailChar);
+    if (pos != size)
+        return false;
+
+    rawValue = line.mid(rawStart);
+    return true;
+}
+
 void CmdTool::getMapInfoFromSmartctl(QMap<QString, QString> &mapInfo, const QString &info, const QString &ch)
 {
     qCDebug(appLog) << "Getting map info from smartctl.";
     QString indexName;
-    int startIndex = 0;
-
-    QRegularExpression reg("^[\\s\\S]*[\\d]:[\\d][\\s\\S]*$");//time 08:00
+    QStringView name;
+    QStringView rawValue;
+    int pos = 0;
 
     qCDebug(appLog) << "Parsing smartctl info line by line.";
-    for (int i = 0; i < info.size(); ++i) {
-        if (info[i] != '\n' && i != info.size() - 1)
-            continue;
-
-        QString line = info.mid(startIndex, i - startIndex);
-        startIndex = i + 1;
-
+    while (pos < info.size()) {
+        QStringView line = nextLine(info, pos);
 
+        // "key: value" 形式的信息，包括 ATA 的设备信息和 NVMe 的 SMART/Health 信息
         int index = line.indexOf(ch);
-        if (index > 0 && false == reg.match(line).hasMatch() && false == line.contains("Error") && false == line.contains("hh:mm:SS")) {
-            if (line.indexOf("(") < index && line.indexOf(")") > index) {
+        if (index > 0 && !containsTime(line) && !line.contains(QLatin1String("Error")) && !line.contains(QLatin1String("hh:mm:SS"))) {
+            if (line.indexOf(QLatin1Char('(')) < index && line.indexOf(QLatin1Char(')')) > index) {
                 // qCDebug(appLog) << "Skipping line with separator inside parentheses:" << line;
                 continue;
             }
 
-            if (line.indexOf("[") < index && line.indexOf("]") > index) {
+            if (line.indexOf(QLatin1Char('[')) < index && line.indexOf(QLatin1Char(']')) > index) {
                 // qCDebug(appLog) << "Skipping line with separator inside brackets:" << line;
                 continue;
             }
 
-            indexName = line.mid(0, index).trimmed().remove(" is");
-            if (mapInfo.contains(indexName)) {
-                mapInfo[indexName] += ", ";
-                mapInfo[indexName] += line.mid(index + 1).trimmed();
-            } else {
-                mapInfo[indexName] = line.mid(index + 1).trimmed();
-            }
-            // qCDebug(appLog) << "Parsed smartctl attribute:" << indexName << "=" << mapInfo[indexName];
+            indexName = line.left(index).trimmed().toString().remove(" is");
+            QString value = line.mid(index + 1).trimmed().toString();
+            auto it = mapInfo.find(indexName);
+            if (it != mapInfo.end())
+                *it += ", " + value;
+            else
+                mapInfo.insert(indexName, value);
             continue;
         }
 
-        if (false == indexName.isEmpty() && (line.startsWith("\t\t") || line.startsWith("    ")) && false == line.contains(":")) {
-            if (mapInfo.contains(indexName)) {
-                mapInfo[indexName] += ", ";
-                mapInfo[indexName] += line.trimmed();
-            } else {
-                mapInfo[indexName] = line.trimmed();
-            }
-            // qCDebug(appLog) << "Appended to smartctl attribute:" << indexName << "=" << mapInfo[indexName];
+        // 上一个键的续行
+        if (false == indexName.isEmpty() && (line.startsWith(QLatin1String("\t\t")) || line.startsWith(QLatin1String("    "))) && false == line.contains(QLatin1Char(':'))) {
+            QString value = line.trimmed().toString();
+            auto it = mapInfo.find(indexName);
+            if (it != mapInfo.end())
+                *it += ", " + value;
+            else
+                mapInfo.insert(indexName, value);
             continue;
         }
 
-        indexName = "";
+        indexName.clear();
 
-        QRegularExpression rx("^[ ]*[0-9]+[ ]+([\\w_-]+)[ ]+0x[0-9a-fA-F-]+[ ]+[0-9]+[ ]+[0-9]+[ ]+[0-9]+[ ]+[\\w-]+[ ]+[\\w-]+[ ]+[\\w-]+[ ]+([0-9\\w\\/-]+[ ]*[0-9\\w\\/\\-\\(\\)]*)$");
-        if (rx.match(line).hasMatch()) {
-            // qCDebug(appLog) << "Matched smartctl attribute regex:" << line;
-            mapInfo[rx.match(line).captured(1)] = rx.match(line).captured(2);
+        // 属性表中的一行
+        if (parseSmartctlAttribute(line, name, rawValue)) {
+            mapInfo[name.toString()] = rawValue.toString();
             continue;
         }
 
-        QStringList strList;
+        QString key = smartctlAttributeKey(line);
+        if (key.isEmpty())
+            continue;
 
-        if (line.endsWith(")")) {
-            int leftBracket = line.indexOf("(");
+        QStringList strList;
+        if (line.endsWith(QLatin1Char(')'))) {
+            int leftBracket = line.indexOf(QLatin1Char('('));
             if (leftBracket > 0) {
-                QString str = line.left(leftBracket).trimmed();
-                strList = str.trimmed().split(" ");
+                strList = line.left(leftBracket).trimmed().toString().split(" ");
                 if (strList.size() > 2)
-                    strList.last() += line.mid(leftBracket);
+                    strList.last() += line.mid(leftBracket).toString();
             }
-        } else if (0 == strList.size()) {
-            strList = line.trimmed().split(" ");
-        }
-
-        if (strList.size() < 5)
-            continue;
-
-        if (line.contains("Power_On_Hours")) {
-            mapInfo["Power_On_Hours"] = strList.last();
-            continue;
-        }
-
-        if (line.contains("Power_Cycle_Count")) {
-            mapInfo["Power_Cycle_Count"] = strList.last();
-            continue;
-        }
-
-        if (line.contains("Raw_Read_Error_Rate")) {
-            mapInfo["Raw_Read_Error_Rate"] = strList.last();
-            continue;
-        }
-
-        if (line.contains("Spin_Up_Time")) {
-            mapInfo["Spin_Up_Time"] = strList.last();
-            continue;
-        }
-
-        if (line.contains("Start_Stop_Count")) {
-            mapInfo["Start_Stop_Count"] = strList.last();
-            continue;
-        }
-
-        if (line.contains("Reallocated_Sector_Ct")) {
-            mapInfo["Reallocated_Sector_Ct"] = strList.last();
-            continue;
-        }
-
-        if (line.contains("Seek_Error_Rate")) {
-            mapInfo["Seek_Error_Rate"] = strList.last();
-            continue;
+        } else {
+            strList = line.trimmed().toString().split(" ");
         }
 
-        if (line.contains("Spin_Retry_Count")) {
-            mapInfo["Spin_Retry_Count"] = strList.last();
-            continue;
-        }
-        if (line.contains("Calibration_Retry_Count")) {
-            mapInfo["Calibration_Retry_Count"] = strList.last();
-            continue;
-        }
-        if (line.contains("G-Sense_Error_Rate")) {
-            mapInfo["G-Sense_Error_Rate"] = strList.last();
-            continue;
-        }
-        if (line.contains("Power-Off_Retract_Count")) {
-            mapInfo["Power-Off_Retract_Count"] = strList.last();
-            continue;
-        }
-        if (line.contains("Load_Cycle_Count")) {
-            mapInfo["Load_Cycle_Count"] = strList.last();
-            continue;
-        }
-        if (line.contains("Temperature_Celsius")) {
-            mapInfo["Temperature_Celsius"] = strList.last();
-            continue;
-        }
-        if (line.contains("Reallocated_Event_Count")) {
-            mapInfo["Reallocated_Event_Count"] = strList.last();
-            continue;
-        }
-        if (line.contains("Current_Pending_Sector")) {
-            mapInfo["Current_Pending_Sector"] = strList.last();
-            continue;
-        }
-        if (line.contains("Offline_Uncorrectable")) {
-            mapInfo["Offline_Uncorrectable"] = strList.last();
-            continue;
-        }
-        if (line.contains("UDMA_CRC_Error_Count")) {
-            mapInfo["UDMA_CRC_Error_Count"] = strList.last();
-            continue;
-        }
-        if (line.contains("Multi_Zone_Error_Rate")) {
-            mapInfo["Multi_Zone_Error_Rate"] = strList.last();
-            continue;
-        }
+        if (strList.size() >= 5)
+            mapInfo[key] = strList.last();
     }
 }
 
@@ -1713,6 +1850,11 @@ bool CmdTool::getDeviceInfo(QString &deviceInfo, const QString &debugFile)
     qCDebug(appLog) << "Getting device info for" << debugFile;
     QString key = debugFile;
     key.replace(".txt", "");
+    // 优先使用 getInfos 批量获取的信息，没有时再单独请求
+    if (DBusInterface::getInstance()->takeInfo(key, deviceInfo)) {
+        qCDebug(appLog) << "Got device info from DBus batch.";
+        return true;
+    }
     if (DBusInterface::getInstance()->getInfo(key, deviceInfo)) {
         qCDebug(appLog) << "Got device info from DBus.";
         return true;
@@ -10,6 +10,7 @@
 #include <QMap>
 #include <QProcess>
 #include <QFile>
+#include <QStringView>
 #include <cups.h>
 
 #include <DWidget>
@@ -241,6 +242,33 @@ private:
          */
     void loadNvidiaSettingInfo(const QString &key, const QString &debugfile);
 
+    /**
+     * @brief nextLine:从pos开始获取下一行，不拷贝字符串
+     * @param info:命令获取的信息字符串
+     * @param pos:当前位置，返回时指向下一行的开头
+     * @return 当前行
+     */
+    static QStringView nextLine(const QString &info, int &pos);
+
+    /**
+     * @brief splitKeyValue:按分隔符将一行拆分为键值，分隔符只出现一次时有效
+     * @param line:一行信息
+     * @param ch:分隔符
+     * @param key:键
+     * @param value:值
+     * @return 是否拆分成功
+     */
+    static bool splitKeyValue(QStringView line, const QString &ch, QString &key, QString &value);
+
+    /**
+     * @brief parseSmartctlAttribute:解析smartctl属性表中的一行
+     * @param line:一行信息
+     * @param name:属性名
+     * @param rawValue:原始值
+     * @return 是否为属性表中的一行
+     */
+    static bool parseSmartctlAttribute(QStringView line, QStringView &name, QStringView &rawValue);
+
     /**
      * @brief getMapInfoFromCmd:将通过命令获取的信息字符串，转化为map形式
      * @param info:命令获取的信息字符串
@@ -0,0 +1,362 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DBusBluezInterface.h"
+#include "DDLog.h"
+
+#include <QCoreApplication>
+#include <QDBusMessage>
+#include <QDBusReply>
+#include <QDBusMetaType>
+#include <QDBusServiceWatcher>
+#include <QLoggingCategory>
+
+using namespace DDLog;
+
+std::atomic<DBusBluezInterface *> DBusBluezInterface::s_Instance;
+std::mutex DBusBluezInterface::m_mutex;
+
+const QString BLUEZ_OBJECT_MANAGER = "org.freedesktop.DBus.ObjectManager";
+const QString BLUEZ_PROPERTIES = "org.freedesktop.DBus.Properties";
+const QString BLUEZ_ADAPTER = "org.bluez.Adapter1";
+const QString BLUEZ_DEVICE = "org.bluez.Device1";
+const int BLUEZ_TIMEOUT = 500;      // ms，与原来 bluetoothctl 的等待时间相同
+
+// bluetoothctl 显示的标准 UUID 名称，包括服务类和 GATT 服务
+static const QMap<quint32, QString> s_UuidNames = {
+    {0x1000, "Service Discovery Server Service Class"},
+    {0x1001, "Browse Group Descriptor Service Class"},
+    {0x1002, "Public Browse Root"},
+    {0x1101, "Serial Port"},
+    {0x1102, "LAN Access Using PPP"},
+    {0x1103, "Dialup Networking"},
+    {0x1104, "IrMC Sync"},
+    {0x1105, "OBEX Object Push"},
+    {0x1106, "OBEX File Transfer"},
+    {0x1107, "IrMC Sync Command"},
+    {0x1108, "Headset"},
+    {0x1109, "Cordless Telephony"},
+    {0x110a, "Audio Source"},
+    {0x110b, "Audio Sink"},
+    {0x110c, "A/V Remote Control Target"},
+    {0x110d, "Advanced Audio Distribution"},
+    {0x110e, "A/V Remote Control"},
+    {0x110f, "A/V Remote Control Controller"},
+    {0x1110, "Intercom"},
+    {0x1111, "Fax"},
+    {0x1112, "Headset AG"},
+    {0x1113, "WAP"},
+    {0x1114, "WAP Client"},
+    {0x1115, "PANU"},
+    {0x1116, "NAP"},
+    {0x1117, "GN"},
+    {0x1118, "Direct Printing"},
+    {0x1119, "Reference Printing"},
+    {0x111a, "Basic Imaging Profile"},
+    {0x111b, "Imaging Responder"},
+    {0x111c, "Imaging Automatic Archive"},
+    {0x111d, "Imaging Referenced Objects"},
+    {0x111e, "Handsfree"},
+    {0x111f, "Handsfree Audio Gateway"},
+    {0x1120, "Direct Printing Refrence Objects Service"},
+    {0x1121, "Reflected UI"},
+    {0x1122, "Basic Printing"},
+    {0x1123, "Printing Status"},
+    {0x1124, "Human Interface Device Service"},
+    {0x1125, "Hardcopy Cable Replacement"},
+    {0x1126, "HCR Print"},
+    {0x1127, "HCR Scan"},
+    {0x1128, "Common ISDN Access"},
+    {0x112d, "SIM Access"},
+    {0x112e, "Phonebook Access Client"},
+    {0x112f, "Phonebook Access Server"},
+    {0x1130, "Phonebook Access"},
+    {0x1131, "Headset HS"},
+    {0x1132, "Message Access Server"},
+    {0x1133, "Message Notification Server"},
+    {0x1134, "Message Access Profile"},
+    {0x1135, "GNSS"},
+    {0x1136, "GNSS Server"},
+    {0x1137, "3D Display"},
+    {0x1138, "3D Glasses"},
+    {0x1139, "3D Synchronization"},
+    {0x113a, "MPS Profile"},
+    {0x113b, "MPS Service"},
+    {0x113c, "CTN Access Service"},
+    {0x113d, "CTN Notification Service"},
+    {0x113e, "CTN Profile"},
+    {0x1200, "PnP Information"},
+    {0x1201, "Generic Networking"},
+    {0x1202, "Generic File Transfer"},
+    {0x1203, "Generic Audio"},
+    {0x1204, "Generic Telephony"},
+    {0x1205, "UPNP Service"},
+    {0x1206, "UPNP IP Service"},
+    {0x1300, "UPNP IP PAN"},
+    {0x1301, "UPNP IP LAP"},
+    {0x1302, "UPNP IP L2CAP"},
+    {0x1303, "Video Source"},
+    {0x1304, "Video Sink"},
+    {0x1305, "Video Distribution"},
+    {0x1400, "HDP"},
+    {0x1401, "HDP Source"},
+    {0x1402, "HDP Sink"},
+    {0x1800, "Generic Access Profile"},
+    {0x1801, "Generic Attribute Profile"},
+    {0x1802, "Immediate Alert"},
+    {0x1803, "Link Loss"},
+    {0x1804, "Tx Power"},
+    {0x1805, "Current Time Service"},
+    {0x1806, "Reference Time Update Service"},
+    {0x1807, "Next DST Change Service"},
+    {0x1808, "Glucose"},
+    {0x1809, "Health Thermometer"},
+    {0x180a, "Device Information"},
+    {0x180d, "Heart Rate"},
+    {0x180e, "Phone Alert Status Service"},
+    {0x180f, "Battery Service"},
+    {0x1810, "Blood Pressure"},
+    {0x1811, "Alert Notification Service"},
+    {0x1812, "Human Interface Device"},
+    {0x1813, "Scan Parameters"},
+    {0x1814, "Running Speed and Cadence"},
+    {0x1815, "Automation IO"},
+    {0x1816, "Cycling Speed and Cadence"},
+    {0x1818, "Cycling Power"},
+    {0x1819, "Location and Navigation"},
+    {0x181a, "Environmental Sensing"},
+    {0x181b, "Body Composition"},
+    {0x181c, "User Data"},
+    {0x181d, "Weight Scale"},
+    {0x181e, "Bond Management"},
+    {0x181f, "Continuous Glucose Monitoring"},
+    {0x1820, "Internet Protocol Support"},
+    {0x1821, "Indoor Positioning"},
+    {0x1822, "Pulse Oximeter"},
+    {0x1823, "HTTP Proxy"},
+    {0x1824, "Transport Discovery"},
+    {0x1825, "Object Transfer"},
+    {0x1826, "Fitness Machine"},
+    {0x1827, "Mesh Provisioning"},
+    {0x1828, "Mesh Proxy"},
+    {0x1843, "Audio Input Control"},
+    {0x1844, "Volume Control"},
+    {0x1845, "Volume Offset Control"},
+    {0x1846, "Coordinated Set Identification"},
+    {0x1848, "Media Control"},
+    {0x1849, "Generic Media Control"},
+    {0x184e, "Audio Stream Control"},
+    {0x184f, "Broadcast Audio Scan"},
+    {0x1850, "Published Audio Capabilities"},
+    {0x1853, "Common Audio"},
+};
+
+static QString yesNo(const QVariant &value)
+{
+    return value.toBool() ? "yes" : "no";
+}
+
+DBusBluezInterface::DBusBluezInterface(const QDBusConnection &connection, const QString &service)
+    : m_Connection(connection)
+    , m_Service(service)
+    , mp_Watcher(nullptr)
+    , m_Valid(false)
+{
+    qCDebug(appLog) << "DBusBluezInterface constructor, service:" << service;
+    init();
+
+    // 信号在主线程处理，调用者可以在任意线程查询
+    if (QCoreApplication::instance())
+        moveToThread(QCoreApplication::instance()->thread());
+}
+
+bool DBusBluezInterface::isValid()
+{
+    QMutexLocker locker(&m_ObjectsMutex);
+    return m_Valid;
+}
+
+bool DBusBluezInterface::adapterInfo(const QString &address, QMap<QString, QString> &mapInfo)
+{
+    QVariantMap properties;
+    if (!findProperties(BLUEZ_ADAPTER, address, properties))
+        return false;
+
+    adapterMapInfo(properties, mapInfo);
+    qCDebug(appLog) << "Bluez adapter info:" << mapInfo;
+    return true;
+}
+
+bool DBusBluezInterface::isPaired(const QString &address)
+{
+    QVariantMap properties;
+    return findProperties(BLUEZ_DEVICE, address, properties) && properties.value("Paired").toBool();
+}
+
+bool DBusBluezInterface::isConnected(const QString &address)
+{
+    QVariantMap properties;
+    return findProperties(BLUEZ_DEVICE, address, properties) && properties.value("Connected").toBool();
+}
+
+void DBusBluezInterface::adapterMapInfo(const QVariantMap &properties, QMap<QString, QString> &mapInfo)
+{
+    // 字段名称和取值格式与 bluetoothctl show 相同
+    if (properties.contains("Name"))
+        mapInfo["Name"] = properties.value("Name").toString();
+    if (properties.contains("Alias"))
+        mapInfo["Alias"] = properties.value("Alias").toString();
+    if (properties.contains("Class"))
+        mapInfo["Class"] = QString("0x%1").arg(properties.value("Class").toUInt(), 8, 16, QChar('0'));
+    if (properties.contains("Powered"))
+        mapInfo["Powered"] = yesNo(properties.value("Powered"));
+    if (properties.contains("Discoverable"))
+        mapInfo["Discoverable"] = yesNo(properties.value("Discoverable"));
+    if (properties.contains("DiscoverableTimeout"))
+        mapInfo["DiscoverableTimeout"] = QString("0x%1").arg(properties.value("DiscoverableTimeout").toUInt(), 8, 16, QChar('0'));
+    if (properties.contains("Pairable"))
+        mapInfo["Pairable"] = yesNo(properties.value("Pairable"));
+    if (properties.contains("Modalias"))
+        mapInfo["Modalias"] = properties.value("Modalias").toString();
+    if (properties.contains("Discovering"))
+        mapInfo["Discovering"] = yesNo(properties.value("Discovering"));
+
+    // bluetoothctl 每个角色输出一行，解析后保留最后一个
+    QStringList roles = properties.value("Roles").toStringList();
+    if (!roles.isEmpty())
+        mapInfo["Roles"] = roles.last();
+
+    // 与 getMapInfoFromBluetoothCtl 整理后的 UUID 格式相同
+    QString uuid;
+    foreach (const QString &item, properties.value("UUIDs").toStringList()) {
+        QString name = uuidName(item);
+        if (name != item && name.length() > 25)
+            name = name.left(22) + "...";
+        uuid.append(name + ":(" + item + ")");
+        uuid.append("\n");
+    }
+    if (!uuid.isEmpty())
+        mapInfo["UUID"] = uuid;
+}
+
+QString DBusBluezInterface::uuidName(const QString &uuid)
+{
+    // 基于 Bluetooth Base UUID 的为标准 UUID
+    if (uuid.length() == 36 && uuid.endsWith("-0000-1000-8000-00805f9b34fb", Qt::CaseInsensitive)) {
+        bool ok = false;
+        quint32 value = uuid.left(8).toUInt(&ok, 16);
+        if (ok)
+            return s_UuidNames.value(value, uuid);
+    }
+    return "Vendor specific";
+}
+
+void DBusBluezInterface::onServiceRegistered()
+{
+    qCInfo(appLog) << "Bluez service registered:" << m_Service;
+    loadManagedObjects();
+}
+
+void DBusBluezInterface::onServiceUnregistered()
+{
+    qCInfo(appLog) << "Bluez service unregistered:" << m_Service;
+    QMutexLocker locker(&m_ObjectsMutex);
+    m_Objects.clear();
+    m_Valid = false;
+}
+
+void DBusBluezInterface::onInterfacesAdded(const QDBusObjectPath &path, const BluezInterfaceMap &interfaces)
+{
+    QMutexLocker locker(&m_ObjectsMutex);
+    BluezInterfaceMap &object = m_Objects[path.path()];
+    for (auto it = interfaces.begin(); it != interfaces.end(); ++it)
+        object[it.key()] = it.value();
+}
+
+void DBusBluezInterface::onInterfacesRemoved(const QDBusObjectPath &path, const QStringList &interfaces)
+{
+    QMutexLocker locker(&m_ObjectsMutex);
+    auto it = m_Objects.find(path.path());
+    if (it == m_Objects.end())
+        return;
+
+    foreach (const QString &interface, interfaces)
+        it->remove(interface);
+    if (it->isEmpty())
+        m_Objects.erase(it);
+}
+
+void DBusBluezInterface::onPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated, const QDBusMessage &message)
+{
+    QMutexLocker locker(&m_ObjectsMutex);
+    auto it = m_Objects.find(message.path());
+    if (it == m_Objects.end() || !it->contains(interface))
+        return;
+
+    QVariantMap &properties = (*it)[interface];
+    for (auto prop = changed.begin(); prop != changed.end(); ++prop)
+        properties[prop.key()] = prop.value();
+    foreach (const QString &name, invalidated)
+        properties.remove(name);
+}
+
+void DBusBluezInterface::init()
+{
+    qDBusRegisterMetaType<BluezInterfaceMap>();
+    qDBusRegisterMetaType<BluezObjectMap>();
+
+    if (!m_Connection.isConnected()) {
+        qCWarning(appLog) << "Cannot connect to the D-Bus bus for bluez.";
+        return;
+    }
+
+    // 先连接信号再获取对象列表，避免遗漏中间的变化
+    mp_Watcher = new QDBusServiceWatcher(m_Service, m_Connection, QDBusServiceWatcher::WatchForRegistration | QDBusServiceWatcher::WatchForUnregistration, this);
+    connect(mp_Watcher, &QDBusServiceWatcher::serviceRegistered, this, &DBusBluezInterface::onServiceRegistered);
+    connect(mp_Watcher, &QDBusServiceWatcher::serviceUnregistered, this, &DBusBluezInterface::onServiceUnregistered);
+
+    m_Connection.connect(m_Service, "/", BLUEZ_OBJECT_MANAGER, "InterfacesAdded",
+                         this, SLOT(onInterfacesAdded(QDBusObjectPath, BluezInterfaceMap)));
+    m_Connection.connect(m_Service, "/", BLUEZ_OBJECT_MANAGER, "InterfacesRemoved",
+                         this, SLOT(onInterfacesRemoved(QDBusObjectPath, QStringList)));
+    // 路径为空时接收所有对象的属性变化
+    m_Connection.connect(m_Service, QString(), BLUEZ_PROPERTIES, "PropertiesChanged",
+                         this, SLOT(onPropertiesChanged(QString, QVariantMap, QStringList, QDBusMessage)));
+
+    loadManagedObjects();
+}
+
+bool DBusBluezInterface::loadManagedObjects()
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(m_Service, "/", BLUEZ_OBJECT_MANAGER, "GetManagedObjects");
+    QDBusReply<BluezObjectMap> reply = m_Connection.call(message, QDBus::Block, BLUEZ_TIMEOUT);
+    if (!reply.isValid()) {
+        qCInfo(appLog) << "Failed to get bluez managed objects:" << reply.error().message();
+        return false;
+    }
+
+    const BluezObjectMap &objects = reply.value();
+    QMutexLocker locker(&m_ObjectsMutex);
+    m_Objects.clear();
+    for (auto it = objects.begin(); it != objects.end(); ++it)
+        m_Objects.insert(it.key().path(), it.value());
+    m_Valid = true;
+    qCDebug(appLog) << "Bluez managed objects:" << m_Objects.size();
+    return true;
+}
+
+bool DBusBluezInterface::findProperties(const QString &interface, const QString &address, QVariantMap &properties)
+{
+    QMutexLocker locker(&m_ObjectsMutex);
+    for (auto it = m_Objects.begin(); it != m_Objects.end(); ++it) {
+        auto iface = it->find(interface);
+        if (iface == it->end())
+            continue;
+        if (iface->value("Address").toString().compare(address.trimmed(), Qt::CaseInsensitive) == 0) {
+            properties = *iface;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DBUSBLUEZINTERFACE_H
+#define DBUSBLUEZINTERFACE_H
+
+#include <QObject>
+#include <QMap>
+#include <QMutex>
+#include <QVariantMap>
+#include <QStringList>
+#include <QDBusConnection>
+#include <QDBusObjectPath>
+
+#include <atomic>
+#include <mutex>
+
+class QDBusServiceWatcher;
+class QDBusMessage;
+
+typedef QMap<QString, QVariantMap> BluezInterfaceMap;               // a{sa{sv}}，接口名到属性
+typedef QMap<QDBusObjectPath, BluezInterfaceMap> BluezObjectMap;     // a{oa{sa{sv}}}，GetManagedObjects 的返回值
+Q_DECLARE_METATYPE(BluezInterfaceMap)
+Q_DECLARE_METATYPE(BluezObjectMap)
+
+/**
+ * @brief The DBusBluezInterface class
+ * BlueZ ObjectManager 的客户端，一次 GetManagedObjects 获取所有蓝牙适配器和设备，
+ * 之后通过 InterfacesAdded、InterfacesRemoved、PropertiesChanged 信号跟踪变化，
+ * 代替 bluetoothctl show、bluetoothctl paired-devices 和 hcitool con
+ */
+class DBusBluezInterface : public QObject
+{
+    Q_OBJECT
+public:
+    inline static DBusBluezInterface *getInstance()
+    {
+        // 利用原子变量解决，单例模式造成的内存泄露
+        DBusBluezInterface *sin = s_Instance.load();
+
+        if (!sin) {
+            // std::lock_guard 自动加锁解锁
+            std::lock_guard<std::mutex> lock(m_mutex);
+            sin = s_Instance.load();
+
+            if (!sin) {
+                sin = new DBusBluezInterface();
+                s_Instance.store(sin);
+            }
+        }
+
+        return sin;
+    }
+
+    /**
+     * @brief isValid：bluetoothd 是否在运行且已获取到对象列表
+     * @return 无效时调用者应回退到命令行工具
+     */
+    bool isValid();
+
+    /**
+     * @brief adapterInfo：获取适配器信息，字段与 bluetoothctl show 的解析结果一致
+     * @param address：适配器地址，即 hciconfig 中的 BD Address
+     * @param mapInfo：适配器信息，已有的同名字段会被覆盖
+     * @return 没有找到该适配器返回false
+     */
+    bool adapterInfo(const QString &address, QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief isPaired：设备是否已配对
+     * @param address：设备地址
+     * @return
+     */
+    bool isPaired(const QString &address);
+
+    /**
+     * @brief isConnected：设备是否已连接
+     * @param address：设备地址
+     * @return
+     */
+    bool isConnected(const QString &address);
+
+    /**
+     * @brief adapterMapInfo：将 org.bluez.Adapter1 的属性转换为 bluetoothctl show 的字段
+     * @param properties：适配器属性
+     * @param mapInfo：输出的字段
+     */
+    static void adapterMapInfo(const QVariantMap &properties, QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief uuidName：与 bluetoothctl 相同的 UUID 名称
+     * @param uuid：128位 UUID 字符串
+     * @return 未收录的标准 UUID 返回 UUID 本身，厂商自定义的返回 Vendor specific
+     */
+    static QString uuidName(const QString &uuid);
+
+protected:
+    explicit DBusBluezInterface(const QDBusConnection &connection = QDBusConnection::systemBus(), const QString &service = "org.bluez");
+
+private slots:
+    /**
+     * @brief onServiceRegistered：bluetoothd 启动后重新获取对象列表
+     */
+    void onServiceRegistered();
+
+    /**
+     * @brief onServiceUnregistered：bluetoothd 退出后清空对象列表
+     */
+    void onServiceUnregistered();
+
+    void onInterfacesAdded(const QDBusObjectPath &path, const BluezInterfaceMap &interfaces);
+    void onInterfacesRemoved(const QDBusObjectPath &path, const QStringList &interfaces);
+    void onPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated, const QDBusMessage &message);
+
+private:
+    /**
+     * @brief init：连接信号，获取对象列表
+     */
+    void init();
+
+    /**
+     * @brief loadManagedObjects：调用 GetManagedObjects
+     * @return
+     */
+    bool loadManagedObjects();
+
+    /**
+     * @brief findProperties：根据地址查找对象的属性
+     * @param interface：org.bluez.Adapter1 或 org.bluez.Device1
+     * @param address：地址，不区分大小写
+     * @param properties：找到的属性
+     * @return
+     */
+    bool findProperties(const QString &interface, const QString &address, QVariantMap &properties);
+
+private:
+    static std::atomic<DBusBluezInterface *> s_Instance;
+    static std::mutex m_mutex;
+
+    QDBusConnection              m_Connection;          //<! 系统总线，单元测试中为会话总线
+    QString                      m_Service;             //<! org.bluez
+    QDBusServiceWatcher          *mp_Watcher;           //<! 监听 bluetoothd 的启动和退出
+    QMap<QString, BluezInterfaceMap> m_Objects;         //<! 对象路径到接口属性
+    bool                         m_Valid;               //<! 是否已获取对象列表
+    QMutex                       m_ObjectsMutex;
+};
+
+#endif // DBUSBLUEZINTERFACE_H
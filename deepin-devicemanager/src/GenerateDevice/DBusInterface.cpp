@@ -52,6 +52,40 @@ bool DBusInterface::getInfo(const QString &key, QString &info)
     }
 }
 
+bool DBusInterface::getInfos(const QStringList &keys)
+{
+    qCDebug(appLog) << "DBusInterface::getInfos start, keys:" << keys.size();
+    // 一次dbus调用获取所有信息
+    QDBusReply<QVariantMap> reply = mp_Iface->call("getInfos", keys);
+    if (!reply.isValid()) {
+        qCInfo(appLog) << "unsucess in getting info from getInfos :" << reply.error().message();
+        // 丢弃上一次的信息，避免读取到过期数据
+        QMutexLocker locker(&m_InfosMutex);
+        m_Infos.clear();
+        return false;
+    }
+
+    const QVariantMap &infos = reply.value();
+    QMutexLocker locker(&m_InfosMutex);
+    m_Infos.clear();
+    for (auto it = infos.begin(); it != infos.end(); ++it)
+        m_Infos.insert(it.key(), it.value().toString());
+    qCDebug(appLog) << "DBusInterface::getInfos success, infos:" << m_Infos.size();
+    return true;
+}
+
+bool DBusInterface::takeInfo(const QString &key, QString &info)
+{
+    QMutexLocker locker(&m_InfosMutex);
+    auto it = m_Infos.find(key);
+    if (it == m_Infos.end())
+        return false;
+
+    info = it.value();
+    m_Infos.erase(it);
+    return true;
+}
+
 void DBusInterface::refreshInfo()
 {
     qCDebug(appLog) << "DBusInterface::refreshInfo";
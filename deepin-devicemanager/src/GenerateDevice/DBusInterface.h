@@ -7,6 +7,9 @@
 #define DBUSINTERFACE_H
 
 #include <QObject>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
 
 #include <mutex>
 
@@ -42,6 +45,21 @@ public:
      */
     bool getInfo(const QString &key, QString &info);
 
+    /**
+     * @brief getInfos：一次调用获取多个关键字的信息，结果缓存后由 takeInfo 取出
+     * @param keys：命令关键字
+     * @return 调用是否成功
+     */
+    bool getInfos(const QStringList &keys);
+
+    /**
+     * @brief takeInfo：取出 getInfos 缓存的信息，每个关键字只能取一次
+     * @param key：命令关键字
+     * @param info：获取的设备信息
+     * @return 是否有缓存的信息
+     */
+    bool takeInfo(const QString &key, QString &info);
+
     /**
      * @brief refreshInfo 用来通知后台刷新信息
      */
@@ -61,6 +79,8 @@ private:
     static std::mutex m_mutex;
 
     QDBusInterface       *mp_Iface;
+    QMap<QString, QString> m_Infos;            //<! getInfos 获取的信息
+    QMutex               m_InfosMutex;
 };
 
 #endif // DBUSINTERFACE_H
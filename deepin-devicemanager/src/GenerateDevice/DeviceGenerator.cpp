@@ -1038,6 +1038,7 @@ void DeviceGenerator::getBlueToothInfoFromHwinfo()
                 // qCDebug(appLog) << "Updating existing bluetooth device:" << unique_id;
                 device->setEnableValue(false);
                 device->setInfoFromHwinfo(*it);
+                DeviceManager::instance()->updateDeviceIndex(DT_Bluetoorh, device);
                 continue;
             }
 
@@ -1056,6 +1057,7 @@ void DeviceGenerator::getBlueToothInfoFromHwinfo()
                     // qCDebug(appLog) << "Updating existing bluetooth device:" << unique_id;
                     device->setEnableValue(false);
                     device->setInfoFromHwinfo(*it);
+                    DeviceManager::instance()->updateDeviceIndex(DT_Bluetoorh, device);
                     continue;
                 }
 
@@ -1273,6 +1275,7 @@ void DeviceGenerator::getImageInfoFromHwinfo()
             // qCDebug(appLog) << "Updating existing image device:" << unique_id;
             device->setEnableValue(false);
             device->setInfoFromHwinfo(*it);
+            DeviceManager::instance()->updateDeviceIndex(DT_Image, device);
             continue;
         } else {
             if ((*it).find("path") != (*it).end()) {
@@ -33,6 +33,7 @@ void GenerateTask::run()
 
     if (!generator) {
         qCWarning(appLog) << "GenerateTask::run get generator failed";
+        emit finished(m_Type, QStringList());
         return;
     }
 
@@ -127,7 +128,7 @@ void GenerateTask::run()
         break;
     }
 
-    emit finished(generator->getBusIDFromHwinfo());
+    emit finished(m_Type, generator->getBusIDFromHwinfo());
     delete generator;
     generator = nullptr;
 }
@@ -135,44 +136,123 @@ void GenerateTask::run()
 
 GenerateDevicePool::GenerateDevicePool()
     : QThreadPool()
+    , m_FinishedGenerator(0)
+    , m_Canceled(false)
 {
     qCDebug(appLog) << "GenerateDevicePool constructor";
     initType();
+    initDependency();
 }
 
 void GenerateDevicePool::generateDevice()
 {
     qCDebug(appLog) << "GenerateDevicePool::generateDevice start";
+    beginGenerate();
+    finishGenerate();
+}
+
+void GenerateDevicePool::beginGenerate()
+{
+    qCDebug(appLog) << "GenerateDevicePool::beginGenerate";
+    QMutexLocker locker(&m_FinishedMutex);
     m_FinishedGenerator = 0;
+    m_Canceled = false;
+    m_ReadyCmds.clear();
+    m_StartedTypes.clear();
+    m_PendingTypes = m_TypeList;
+}
+
+void GenerateDevicePool::cmdReady(const QString &key)
+{
+    QMutexLocker locker(&m_FinishedMutex);
+    if (m_Canceled)
+        return;
+
+    m_ReadyCmds.insert(key);
+    startReadyTasks(false);
+}
+
+void GenerateDevicePool::finishGenerate()
+{
+    qCDebug(appLog) << "GenerateDevicePool::finishGenerate start";
+    {
+        // 所有命令都已结束，依赖未满足的任务使用已有信息生成
+        QMutexLocker locker(&m_FinishedMutex);
+        if (m_Canceled)
+            return;
+        startReadyTasks(true);
+    }
+
+    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
+    // 这里是为了确保其它设备在最后一个生成
+    if (!waitForGenerators(4000)) {
+        QMutexLocker locker(&m_FinishedMutex);
+        if (m_Canceled)
+            return;
+        qCWarning(appLog) << "GenerateDevicePool::finishGenerate timeout, finished:" << m_FinishedGenerator
+                          << "/" << m_TypeList.size() << "pending types:" << m_PendingTypes;
+    }
+
+    DeviceGenerator *generator = DeviceFactory::getDeviceGenerator();
+    generator->generatorOthersDevice();
+    generator->generatorInfoFromToml(DT_Others);
+
+    // 指针使用结束释放
+    delete generator;
+    generator = nullptr;
+}
+
+void GenerateDevicePool::cancel()
+{
+    qCDebug(appLog) << "GenerateDevicePool::cancel";
+    QMutexLocker locker(&m_FinishedMutex);
+    m_Canceled = true;
+    // 移除队列中尚未开始的任务，并唤醒等待者
+    clear();
+    m_AllFinished.wakeAll();
+}
 
+void GenerateDevicePool::startReadyTasks(bool all)
+{
     QList<DeviceType>::iterator it = m_TypeList.begin();
     for (; it != m_TypeList.end(); ++it) {
-        // qCDebug(appLog) << "GenerateDevicePool::generateDevice start task for type:" << (*it);
+        if (m_StartedTypes.contains(*it))
+            continue;
+
+        bool ready = true;
+        if (!all) {
+            foreach (const QString &key, m_Dependencies.value(*it)) {
+                if (!m_ReadyCmds.contains(key)) {
+                    ready = false;
+                    break;
+                }
+            }
+        }
+        if (!ready)
+            continue;
+
+        qCDebug(appLog) << "GenerateDevicePool::startReadyTasks start task for type:" << (*it);
+        m_StartedTypes.append(*it);
         GenerateTask *task = new GenerateTask((*it));
-        connect(task, &GenerateTask::finished, this, &GenerateDevicePool::slotFinished);
-        QThreadPool::globalInstance()->start(task);
-//        task->setAutoDelete(true);
+        // 直接在任务线程中计数，不依赖接收者线程的事件循环
+        connect(task, &GenerateTask::finished, this, &GenerateDevicePool::slotFinished, Qt::DirectConnection);
+        start(task);
     }
+}
 
-    // 当所有设备执行完毕之后，开始执行生成其它设备的任务
-    // 这里是为了确保其它设备在最后一个生成
+bool GenerateDevicePool::waitForGenerators(unsigned long msecs)
+{
+    QMutexLocker locker(&m_FinishedMutex);
     qint64 beginMSecond = QDateTime::currentMSecsSinceEpoch();
-    while (true) {
-        // qCDebug(appLog) << "GenerateDevicePool::generateDevice wait for tasks finished, finished count:" << m_FinishedGenerator;
-        qint64 curMSecond = QDateTime::currentMSecsSinceEpoch();
-        if (m_FinishedGenerator == m_TypeList.size()  || curMSecond - beginMSecond > 4000) {
-            // qCDebug(appLog) << "GenerateDevicePool::generateDevice all tasks finished or timeout, generate others device";
-            DeviceGenerator *generator = DeviceFactory::getDeviceGenerator();
-            generator->generatorOthersDevice();
-            generator->generatorInfoFromToml(DT_Others);
-
-            // 指针使用结束释放
-            delete generator;
-            generator = nullptr;
-
-            break;
-        }
+    while (m_FinishedGenerator < m_TypeList.size() && !m_Canceled) {
+        qint64 elapsed = QDateTime::currentMSecsSinceEpoch() - beginMSecond;
+        if (elapsed >= static_cast<qint64>(msecs))
+            return false;
+
+        // 被最后一个任务唤醒，或者超时返回
+        m_AllFinished.wait(&m_FinishedMutex, msecs - static_cast<unsigned long>(elapsed));
     }
+    return m_FinishedGenerator >= m_TypeList.size();
 }
 
 void GenerateDevicePool::initType()
@@ -198,9 +278,35 @@ void GenerateDevicePool::initType()
     qCDebug(appLog) << "GenerateDevicePool::initType end, initialized" << m_TypeList.size() << "device types";
 }
 
-void GenerateDevicePool::slotFinished(const QStringList &lst)
+void GenerateDevicePool::initDependency()
+{
+    qCDebug(appLog) << "GenerateDevicePool::initDependency start";
+    // 厂商适配信息(toml)在加载dmidecode1时解析，所有设备都依赖它
+    m_Dependencies.insert(DT_Computer,  { "dmidecode1", "lshw", "cat_os_release", "cat_version" });
+    m_Dependencies.insert(DT_Cpu,       { "dmidecode1", "dmidecode4", "lshw", "lscpu" });
+    m_Dependencies.insert(DT_Bios,      { "dmidecode1", "dmidecode0", "dmidecode2", "dmidecode3", "dmidecode13", "dmidecode16" });
+    m_Dependencies.insert(DT_Memory,    { "dmidecode1", "dmidecode17", "lshw" });
+    m_Dependencies.insert(DT_Storage,   { "dmidecode1", "lshw", "hwinfo", "lsblk_d", "ls_sg" });
+    m_Dependencies.insert(DT_Gpu,       { "dmidecode1", "lshw", "hwinfo", "xrandr", "dmesg", "nvidia" });
+    m_Dependencies.insert(DT_Monitor,   { "dmidecode1", "hwinfo_monitor", "xrandr_verbose" });
+    m_Dependencies.insert(DT_Network,   { "dmidecode1", "lshw", "hwinfo" });
+    m_Dependencies.insert(DT_Audio,     { "dmidecode1", "lshw", "hwinfo", "dmesg", "cat_devices", "cat_audio" });
+    m_Dependencies.insert(DT_Bluetoorh, { "dmidecode1", "lshw", "hwinfo", "hciconfig", "bt_device" });
+    m_Dependencies.insert(DT_Keyboard,  { "dmidecode1", "lshw", "hwinfo", "cat_devices" });
+    m_Dependencies.insert(DT_Mouse,     { "dmidecode1", "lshw", "hwinfo", "cat_devices" });
+    m_Dependencies.insert(DT_Print,     { "dmidecode1", "printer" });
+    m_Dependencies.insert(DT_Image,     { "dmidecode1", "lshw", "hwinfo" });
+    m_Dependencies.insert(DT_Cdrom,     { "dmidecode1", "lshw", "hwinfo" });
+    m_Dependencies.insert(DT_Power,     { "dmidecode1", "upower" });
+}
+
+void GenerateDevicePool::slotFinished(DeviceType type, const QStringList &lst)
 {
-    qCDebug(appLog) << "GenerateDevicePool::slotFinished, busIDs:" << lst << "finished:" << m_FinishedGenerator+1 << "/" << m_TypeList.size();
+    QMutexLocker locker(&m_FinishedMutex);
+    qCDebug(appLog) << "GenerateDevicePool::slotFinished, type:" << type << "busIDs:" << lst << "finished:" << m_FinishedGenerator+1 << "/" << m_TypeList.size();
     DeviceManager::instance()->addBusId(lst);
+    m_PendingTypes.removeOne(type);
     m_FinishedGenerator++;
+    if (m_FinishedGenerator >= m_TypeList.size())
+        m_AllFinished.wakeAll();
 }
@@ -9,6 +9,9 @@
 #include <QObject>
 #include <QThreadPool>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QMap>
+#include <QSet>
 
 /**
  * @brief The DeviceType enum
@@ -48,7 +51,7 @@ public:
     GenerateTask(DeviceType deviceType);
     ~GenerateTask();
 signals:
-    void finished(const QStringList &lst);
+    void finished(DeviceType type, const QStringList &lst);
 protected:
     void run();
 private:
@@ -64,26 +67,73 @@ public:
     GenerateDevicePool();
 
     /**
-     * @brief generateDevice
+     * @brief generateDevice : 所有命令信息已就绪时，一次性生成全部设备
      */
     void generateDevice();
 
+    /**
+     * @brief beginGenerate : 开始一轮生成，生成任务在其依赖的命令就绪后启动
+     */
+    void beginGenerate();
+
+    /**
+     * @brief cmdReady : 命令信息已就绪，启动依赖全部就绪的生成任务
+     * @param key : GetInfoPool中的命令关键字
+     */
+    void cmdReady(const QString &key);
+
+    /**
+     * @brief finishGenerate : 启动剩余的生成任务，等待全部结束后生成其它设备
+     */
+    void finishGenerate();
+
+    /**
+     * @brief cancel : 取消尚未开始的生成任务
+     */
+    void cancel();
+
+    /**
+     * @brief waitForGenerators : 阻塞等待所有生成任务结束，由最后一个任务唤醒
+     * @param msecs : 超时时间(ms)
+     * @return 超时前所有任务均已结束返回true，否则返回false
+     */
+    bool waitForGenerators(unsigned long msecs);
+
 private:
     /**
      * @brief initType
      */
     void initType();
 
+    /**
+     * @brief initDependency : 声明每种设备生成所依赖的GetInfoPool命令
+     */
+    void initDependency();
+
+    /**
+     * @brief startReadyTasks : 启动依赖已满足的生成任务，调用者需持有m_FinishedMutex
+     * @param all : 忽略依赖，启动所有未启动的任务
+     */
+    void startReadyTasks(bool all);
+
 private slots:
     /**
-     * @brief slotFinished : end operation
-     * @param lst
+     * @brief slotFinished : end operation，在任务线程中直接调用
+     * @param type : 已完成的设备类型
+     * @param lst : 总线ID
      */
-    void slotFinished(const QStringList &lst);
+    void slotFinished(DeviceType type, const QStringList &lst);
 
 private:
     QList<DeviceType>            m_TypeList;
+    QMap<DeviceType, QStringList> m_Dependencies;         //<! 设备类型依赖的命令
+    QSet<QString>                m_ReadyCmds;             //<! 已就绪的命令
+    QList<DeviceType>            m_StartedTypes;          //<! 已启动的设备类型
+    QList<DeviceType>            m_PendingTypes;          //<! 尚未完成的设备类型
     int                          m_FinishedGenerator;
+    bool                         m_Canceled;
+    QMutex                       m_FinishedMutex;         //<! 保护完成计数
+    QWaitCondition               m_AllFinished;           //<! 所有任务结束的通知
 };
 
 #endif // GENERATEDEVICEPOOL_H
@@ -8,13 +8,12 @@
 #include <QLoggingCategory>
 
 #include "CmdTool.h"
+#include "DBusInterface.h"
 #include "DeviceManager.h"
 #include "DDLog.h"
 
 using namespace DDLog;
 
-static QMutex mutex;
-
 CmdTask::CmdTask(const QString &key, const QString &file, const QString &info, GetInfoPool *parent)
     : m_Key(key)
     , m_File(file)
@@ -34,15 +33,20 @@ void CmdTask::run()
 {
     qCDebug(appLog) << "CmdTask::run start";
 
+    if (mp_Parent->isCanceled()) {
+        qCDebug(appLog) << "CmdTask::run canceled, key:" << m_Key;
+        return;
+    }
+
     CmdTool tool;
     tool.loadCmdInfo(m_Key, m_File);
     const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo = tool.cmdInfo();
-    mp_Parent->finishedCmd(m_Info, cmdInfo);
+    mp_Parent->finishedCmd(m_Key, m_Info, cmdInfo);
 }
 
 GetInfoPool::GetInfoPool()
     : m_Arch("")
-    , m_FinishedNum(0)
+    , m_Canceled(false)
 {
     qCDebug(appLog) << "GetInfoPool constructor";
     initCmd();
@@ -52,29 +56,95 @@ void GetInfoPool::getAllInfo()
 {
     qCDebug(appLog) << "GetInfoPool::getAllInfo start";
     DeviceManager::instance()->clear();
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_FinishedKeys.clear();
+        m_Canceled = false;
+    }
+
+    // 一次dbus调用获取所有命令的信息，避免每个命令单独请求和认证
+    // cat_* 直接读取本地文件，不经过dbus
+    QStringList keys;
+    foreach (const QStringList &cmd, m_CmdList) {
+        if (cmd[1].endsWith(".txt"))
+            keys.append(QString(cmd[1]).remove(".txt"));
+    }
+    DBusInterface::getInstance()->getInfos(keys);
 
     QList<QStringList>::iterator it = m_CmdList.begin();
     for (; it != m_CmdList.end(); ++it) {
         qCDebug(appLog) << "GetInfoPool::getAllInfo start task for key:" << (*it)[0];
+        // 任务由线程池在执行结束后自动释放
+        CmdTask *task = new CmdTask((*it)[0], (*it)[1], (*it)[2], this);
+        start(task);
+    }
+}
+
+void GetInfoPool::getInfo(const QString &key)
+{
+    qCDebug(appLog) << "GetInfoPool::getInfo start, key:" << key;
+    QList<QStringList>::iterator it = m_CmdList.begin();
+    for (; it != m_CmdList.end(); ++it) {
+        if ((*it)[0] != key)
+            continue;
+
         CmdTask *task = new CmdTask((*it)[0], (*it)[1], (*it)[2], this);
         start(task);
-        task->deleteLater();
+        return;
     }
+    qCWarning(appLog) << "GetInfoPool::getInfo unknown key:" << key;
 }
 
-void GetInfoPool::finishedCmd(const QString &info, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo)
+void GetInfoPool::finishedCmd(const QString &key, const QString &info, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo)
 {
-    qCDebug(appLog) << "GetInfoPool::finishedCmd, info:" << info << "cmdInfo size:" << cmdInfo.size();
+    qCDebug(appLog) << "GetInfoPool::finishedCmd, key:" << key << "info:" << info << "cmdInfo size:" << cmdInfo.size();
     DeviceManager::instance()->addCmdInfo(cmdInfo);
-    QMutexLocker m_lock(&mutex);
-    m_FinishedNum++;
-    if (m_FinishedNum == m_CmdList.size()) {
+
+    bool finishedAllCmd = false;
+    {
+        QMutexLocker locker(&m_Mutex);
+        if (m_Canceled)
+            return;
+
+        // 重新加载的命令不重复计数
+        if (!m_FinishedKeys.contains(key)) {
+            m_FinishedKeys.insert(key);
+            finishedAllCmd = m_FinishedKeys.size() == m_CmdList.size();
+        }
+    }
+
+    emit finishedCmdKey(key);
+    if (finishedAllCmd) {
         qCDebug(appLog) << "GetInfoPool::finishedCmd all tasks finished";
         emit finishedAll(info);
-        m_FinishedNum = 0;
     }
 }
 
+void GetInfoPool::cancel()
+{
+    qCDebug(appLog) << "GetInfoPool::cancel";
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Canceled = true;
+    }
+    // 移除队列中尚未开始的任务
+    clear();
+}
+
+bool GetInfoPool::isCanceled()
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Canceled;
+}
+
+QStringList GetInfoPool::cmdKeys() const
+{
+    QStringList keys;
+    foreach (const QStringList &cmd, m_CmdList)
+        keys.append(cmd[0]);
+    return keys;
+}
+
 void GetInfoPool::setFramework(const QString &arch)
 {
     qCDebug(appLog) << "GetInfoPool::setFramework, arch:" << arch;
@@ -8,6 +8,8 @@
 
 #include <QObject>
 #include <QThreadPool>
+#include <QMutex>
+#include <QSet>
 
 class GetInfoPool;
 
@@ -43,12 +45,36 @@ public:
      */
     void getAllInfo();
 
+    /**
+     * @brief getInfo : 重新加载单个命令的信息
+     * @param key : 命令关键字
+     */
+    void getInfo(const QString &key);
+
     /**
      * @brief finishedCmd
+     * @param key : 命令关键字
      * @param info
      * @param cmdInfo
      */
-    void finishedCmd(const QString &info, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo);
+    void finishedCmd(const QString &key, const QString &info, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo);
+
+    /**
+     * @brief cancel : 取消尚未开始执行的命令，正在执行的命令结束后不再通知
+     */
+    void cancel();
+
+    /**
+     * @brief isCanceled : 是否已取消
+     * @return
+     */
+    bool isCanceled();
+
+    /**
+     * @brief cmdKeys : 所有命令关键字
+     * @return
+     */
+    QStringList cmdKeys() const;
     /**
      * @brief setFramework：设置架构
      * @param arch:架构
@@ -56,6 +82,11 @@ public:
     void setFramework(const QString &arch);
 
 signals:
+    /**
+     * @brief finishedCmdKey : 单个命令信息已加入DeviceManager，在任务线程中发出
+     * @param key : 命令关键字
+     */
+    void finishedCmdKey(const QString &key);
     void finishedAll(const QString &info);
 
 private:
@@ -67,7 +98,9 @@ private:
 private:
     QString                      m_Arch;
     QList<QStringList>           m_CmdList;
-    int                          m_FinishedNum;
+    QSet<QString>                m_FinishedKeys;        //<! 已完成的命令
+    QMutex                       m_Mutex;
+    bool                         m_Canceled;
 };
 
 #endif // READFILEPOOL_H
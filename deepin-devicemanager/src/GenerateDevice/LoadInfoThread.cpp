@@ -12,43 +12,39 @@
 #include <DApplication>
 
 #include <QLoggingCategory>
-#include <QDateTime>
 #include <QTimer>
 
 #include<malloc.h>
-#include <unistd.h>
 
 using namespace DDLog;
 DWIDGET_USE_NAMESPACE
 static bool firstLoadFlag = true;
 
+// 后台信息未就绪时dmidecode4为空，此时重新获取该命令的次数上限
+#define MAX_RETRY_NUM 3
+// 第一次重试前的等待时间，之后每次翻倍，总计不超过原来最多等待的4秒
+#define RETRY_INTERVAL_MS 500
+
 LoadInfoThread::LoadInfoThread()
     : mp_ReadFilePool()
     , mp_GenerateDevicePool()
     , m_Running(false)
     , m_FinishedReadFilePool(false)
     , m_Start(true)
+    , m_Canceled(false)
+    , m_RetryNum(0)
 {
     qCDebug(appLog) << "LoadInfoThread constructor";
     connect(&mp_ReadFilePool, &GetInfoPool::finishedAll, this, &LoadInfoThread::slotFinishedReadFilePool);
+    connect(&mp_ReadFilePool, &GetInfoPool::finishedCmdKey, this, &LoadInfoThread::slotFinishedCmd, Qt::DirectConnection);
 }
 
 LoadInfoThread::~LoadInfoThread()
 {
     qCDebug(appLog) << "LoadInfoThread destructor start";
-    long long begin = QDateTime::currentMSecsSinceEpoch();
-    while (m_Running)
-    {
-        // qCDebug(appLog) << "LoadInfoThread destructor waiting for thread to finish";
-        long long end = QDateTime::currentMSecsSinceEpoch();
-        if (end - begin > 1000) {
-            qCWarning(appLog) << "LoadInfoThread destructor timeout, force exit";
-            _exit(0);
-        }
-        usleep(100);
-    }
-    mp_ReadFilePool.deleteLater();
-    mp_GenerateDevicePool.deleteLater();
+    // 取消未开始的任务，等待正在执行的任务结束
+    cancel();
+    wait();
     qCDebug(appLog) << "LoadInfoThread destructor end";
 }
 
@@ -65,70 +61,73 @@ void LoadInfoThread::run()
     if (!info.toInt()) {
         qCDebug(appLog) << "LoadInfoThread::run server is not running, start to get info";
         m_Start = false;
+        m_RetryNum = 0;
+        m_RetryFinished.tryAcquire(m_RetryFinished.available());
+
+        // 每个生成任务在其依赖的命令结束后立即启动，见 slotFinishedCmd
+        mp_GenerateDevicePool.beginGenerate();
         mp_ReadFilePool.getAllInfo();
         mp_ReadFilePool.waitForDone(-1);
+        // 重试的命令在定时器到期后才加入线程池，需要单独等待
+        if (m_RetryNum > 0)
+            m_RetryFinished.acquire();
 
-        bool readDataFlag = false;
-        int readNum = 0;
-        while (!readDataFlag) {
-            // qCDebug(appLog) << "LoadInfoThread::run waiting for read data, readNum:" << readNum;
-            if (m_FinishedReadFilePool) {
-                // qCDebug(appLog) << "LoadInfoThread::run finished read file pool, get all info again";
-                mp_ReadFilePool.getAllInfo();
-                mp_ReadFilePool.waitForDone(-1);
-            }
-            // 为了保证上面那个线程池完全结束
-            long long begin = QDateTime::currentMSecsSinceEpoch();
-            while (true) {
-                readDataFlag = !DeviceManager::instance()->cmdInfo("dmidecode4").isEmpty();
-                if (readDataFlag && m_FinishedReadFilePool) {
-                    // qCDebug(appLog) << "LoadInfoThread::run read data finished";
-                    break;
-                }
-                long long end = QDateTime::currentMSecsSinceEpoch();
-                if (end - begin > 4000) {
-                    // qCWarning(appLog) << "LoadInfoThread::run read data timeout";
-                    break;
-                }
-                usleep(100);
-            }
-            if ((++readNum) > 3) {
-                // qCWarning(appLog) << "LoadInfoThread::run read data retry timeout";
-                if (m_FinishedReadFilePool && !readDataFlag) {
-                    // qCDebug(appLog) << "LoadInfoThread::run finished read file pool, but read data failed, get all info again";
-                    mp_ReadFilePool.getAllInfo();
-                    mp_ReadFilePool.waitForDone(-1);
-                    begin = QDateTime::currentMSecsSinceEpoch();
-                    while (true) {
-                        // qCDebug(appLog) << "LoadInfoThread::run waiting for read file pool finished";
-                        if (m_FinishedReadFilePool) {
-                            // qCDebug(appLog) << "LoadInfoThread::run read file pool finished";
-                            break;
-                        }
-                        long long end = QDateTime::currentMSecsSinceEpoch();
-                        if (end - begin > 4000) {
-                            // qCWarning(appLog) << "LoadInfoThread::run wait for read file pool finished timeout";
-                            break;
-                        }
-                        usleep(100);
-                    }
-                }
-                break;
-            }
+        if (!m_Canceled) {
+            m_FinishedReadFilePool = false;
+            mp_GenerateDevicePool.finishGenerate();
+            mp_GenerateDevicePool.waitForDone(-1);
         }
-
-        m_FinishedReadFilePool = false;
-        mp_GenerateDevicePool.generateDevice();
-        mp_GenerateDevicePool.waitForDone(-1);
     } else {
         qCDebug(appLog) << "LoadInfoThread::run server is running, do nothing";
     }
 
-    emit finished("finish");
     m_Running = false;
+    if (!m_Canceled)
+        emit finished("finish");
     qCDebug(appLog) << "LoadInfoThread::run end";
 }
 
+void LoadInfoThread::cancel()
+{
+    qCDebug(appLog) << "LoadInfoThread::cancel";
+    m_Canceled = true;
+    mp_ReadFilePool.cancel();
+    mp_GenerateDevicePool.cancel();
+    // 不再等待尚未执行的重试
+    m_RetryFinished.release();
+}
+
+void LoadInfoThread::slotFinishedCmd(const QString &key)
+{
+    if ("dmidecode4" != key) {
+        mp_GenerateDevicePool.cmdReady(key);
+        return;
+    }
+
+    // 后台信息未就绪时dmidecode4为空，只重新获取该命令，依赖它的生成任务继续等待
+    if (DeviceManager::instance()->cmdInfo("dmidecode4").isEmpty()
+            && m_RetryNum < MAX_RETRY_NUM && !m_Canceled) {
+        int interval = RETRY_INTERVAL_MS << m_RetryNum;
+        ++m_RetryNum;
+        qCWarning(appLog) << "LoadInfoThread::slotFinishedCmd dmidecode4 is empty, retry:" << m_RetryNum << "after" << interval << "ms";
+        // 命令线程没有事件循环，定时器在对象所在的界面线程中触发
+        QTimer::singleShot(interval, this, [this, key]() { retryCmd(key); });
+        return;
+    }
+
+    mp_GenerateDevicePool.cmdReady(key);
+    if (m_RetryNum > 0)
+        m_RetryFinished.release();
+}
+
+void LoadInfoThread::retryCmd(const QString &key)
+{
+    if (m_Canceled)
+        return;
+    qCDebug(appLog) << "LoadInfoThread::retryCmd key:" << key;
+    mp_ReadFilePool.getInfo(key);
+}
+
 void LoadInfoThread::slotFinishedReadFilePool(const QString &)
 {
     qCDebug(appLog) << "LoadInfoThread::slotFinishedReadFilePool";
@@ -8,9 +8,12 @@
 
 #include <QObject>
 #include <QThread>
+#include <QSemaphore>
 #include "GetInfoPool.h"
 #include "GenerateDevicePool.h"
 
+#include <atomic>
+
 class LoadInfoThread : public QThread
 {
     Q_OBJECT
@@ -24,6 +27,11 @@ public:
      */
     void setFramework(const QString &arch);
 
+    /**
+     * @brief cancel : 取消加载，尚未开始的命令和生成任务不再执行
+     */
+    void cancel();
+
 signals:
     void finished(const QString &message);
     void finishedReadFilePool();
@@ -38,12 +46,28 @@ private slots:
      */
     void slotFinishedReadFilePool(const QString &info);
 
+    /**
+     * @brief slotFinishedCmd : 单个命令结束，在命令线程中直接调用
+     * @param key : 命令关键字
+     */
+    void slotFinishedCmd(const QString &key);
+
+private:
+    /**
+     * @brief retryCmd : 重试等待结束后重新获取命令信息
+     * @param key : 命令关键字
+     */
+    void retryCmd(const QString &key);
+
 private:
     GetInfoPool mp_ReadFilePool;
     GenerateDevicePool mp_GenerateDevicePool;
     bool            m_Running;                      //<!  标识是否正在运行
     bool            m_FinishedReadFilePool;         //<!  标识生成读文件的线程池是否结束
     bool            m_Start;                        //<!  是否为启动
+    std::atomic<bool> m_Canceled;                   //<!  是否已取消，在命令线程和界面线程中访问
+    std::atomic<int> m_RetryNum;                    //<!  dmidecode4为空时的重试次数
+    QSemaphore      m_RetryFinished;                //<!  dmidecode4重试结束，重试等待期间线程池是空闲的
 
 };
 
@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INPUTDEVICEPARSER_H
+#define INPUTDEVICEPARSER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QList>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+
+#include <string.h>
+
+/**
+ * @brief The InputDeviceRecord struct
+ * /proc/bus/input/devices 中一个设备块的内容
+ */
+struct InputDeviceRecord {
+    quint16     bus;        // I: Bus=
+    quint16     vendor;     // I: Vendor=
+    quint16     product;    // I: Product=
+    quint16     version;    // I: Version=
+    QString     name;       // N: Name=，不含引号
+    QString     phys;       // P: Phys=
+    QString     sysfs;      // S: Sysfs=
+    QString     uniq;       // U: Uniq=
+    QStringList handlers;   // H: Handlers=
+    quint32     evBits;     // B: EV=
+
+    InputDeviceRecord() : bus(0), vendor(0), product(0), version(0), evBits(0) {}
+
+    /**
+     * @brief busId 与文件中相同的四位十六进制总线号，如 0003
+     */
+    QString busId() const
+    {
+        return QString("%1").arg(bus, 4, 16, QChar('0'));
+    }
+
+    /**
+     * @brief eventHandler 设备对应的 eventN，没有时返回空
+     */
+    QString eventHandler() const
+    {
+        foreach (const QString &handler, handlers) {
+            if (handler.startsWith("event"))
+                return handler;
+        }
+        return QString();
+    }
+};
+
+/**
+ * @brief The InputDeviceParser class
+ * 直接读取并解析 /proc/bus/input/devices，客户端和 deepin-devicecontrol 共用
+ * 解析结果缓存到 /dev/input 下的设备节点发生变化为止
+ */
+class InputDeviceParser
+{
+public:
+    /**
+     * @brief parse 解析 /proc/bus/input/devices 格式的内容，只为需要的字段创建字符串
+     * @param content 文件内容
+     * @return 设备列表
+     */
+    static QList<InputDeviceRecord> parse(const QByteArray &content)
+    {
+        QList<InputDeviceRecord> records;
+        InputDeviceRecord record;
+        bool hasRecord = false;
+
+        const char *data = content.constData();
+        const char *end = data + content.size();
+        while (data < end) {
+            const char *eol = static_cast<const char *>(memchr(data, '\n', static_cast<size_t>(end - data)));
+            if (!eol)
+                eol = end;
+
+            // 空行分隔设备块
+            if (eol == data) {
+                if (hasRecord)
+                    records.append(record);
+                record = InputDeviceRecord();
+                hasRecord = false;
+                data = eol + 1;
+                continue;
+            }
+
+            // 每行格式为 "X: Key=Value"
+            if (eol - data > 3 && data[1] == ':' && data[2] == ' ') {
+                hasRecord = true;
+                const char *key = data + 3;
+                const char *value = key;
+                while (value < eol && *value != '=')
+                    ++value;
+                int keyLength = static_cast<int>(value - key);
+                if (value < eol)
+                    ++value;
+
+                switch (data[0]) {
+                case 'I':
+                    parseIds(data + 3, eol, record);
+                    break;
+                case 'N':
+                    record.name = unquote(value, eol);
+                    break;
+                case 'P':
+                    record.phys = QString::fromUtf8(value, static_cast<int>(eol - value));
+                    break;
+                case 'S':
+                    record.sysfs = QString::fromUtf8(value, static_cast<int>(eol - value));
+                    break;
+                case 'U':
+                    record.uniq = QString::fromUtf8(value, static_cast<int>(eol - value));
+                    break;
+                case 'H':
+                    record.handlers = QString::fromLatin1(value, static_cast<int>(eol - value)).simplified().split(" ");
+                    record.handlers.removeAll(QString());
+                    break;
+                case 'B':
+                    if (keyLength == 2 && strncmp(key, "EV", 2) == 0)
+                        record.evBits = static_cast<quint32>(hex(value, eol));
+                    break;
+                default:
+                    break;
+                }
+            }
+            data = eol + 1;
+        }
+
+        if (hasRecord)
+            records.append(record);
+        return records;
+    }
+
+    /**
+     * @brief devices 当前系统的输入设备
+     * @return 读取失败时返回空列表
+     */
+    static QList<InputDeviceRecord> devices()
+    {
+        static QMutex mutex;
+        static QList<InputDeviceRecord> cache;
+        static qint64 cacheStamp = -1;
+
+        QMutexLocker locker(&mutex);
+        // 设备节点的增删会更新 /dev/input 的修改时间
+        QFileInfo dir("/dev/input");
+        qint64 stamp = dir.exists() ? dir.lastModified().toMSecsSinceEpoch() : -1;
+        if (stamp >= 0 && stamp == cacheStamp)
+            return cache;
+
+        QFile file("/proc/bus/input/devices");
+        if (!file.open(QIODevice::ReadOnly))
+            return QList<InputDeviceRecord>();
+
+        cache = parse(file.readAll());
+        cacheStamp = stamp;
+        return cache;
+    }
+
+    /**
+     * @brief findByEvent 根据 eventN 查找设备
+     * @param event 如 event3
+     * @param record 找到的设备
+     * @return 没有找到返回false
+     */
+    static bool findByEvent(const QList<InputDeviceRecord> &records, const QString &event, InputDeviceRecord &record)
+    {
+        foreach (const InputDeviceRecord &item, records) {
+            if (item.handlers.contains(event)) {
+                record = item;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief ps2SysPath 去掉 Sysfs 末尾的 inputN，得到 PS/2 等设备在 /sys 下的路径
+     * @param sysfs S: Sysfs= 的值
+     * @return
+     */
+    static QString ps2SysPath(const QString &sysfs)
+    {
+        static const QRegularExpression regI2c("^(.*)/input/input[0-9]{1,2}");
+        static const QRegularExpression regInput("^(.*)/input[0-9]{1,2}");
+        QRegularExpressionMatch match = (sysfs.contains("i2c_designware") ? regI2c : regInput).match(sysfs);
+        return match.hasMatch() ? match.captured(1) : QString();
+    }
+
+private:
+    static quint64 hex(const char *begin, const char *end)
+    {
+        quint64 value = 0;
+        for (; begin < end; ++begin) {
+            char c = *begin;
+            if (c >= '0' && c <= '9')
+                value = value << 4 | static_cast<quint64>(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                value = value << 4 | static_cast<quint64>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                value = value << 4 | static_cast<quint64>(c - 'A' + 10);
+            else
+                break;
+        }
+        return value;
+    }
+
+    static QString unquote(const char *begin, const char *end)
+    {
+        if (end - begin >= 2 && *begin == '"' && *(end - 1) == '"')
+            return QString::fromUtf8(begin + 1, static_cast<int>(end - begin - 2));
+        return QString::fromUtf8(begin, static_cast<int>(end - begin));
+    }
+
+    // I: Bus=0003 Vendor=046d Product=c077 Version=0111
+    static void parseIds(const char *begin, const char *end, InputDeviceRecord &record)
+    {
+        while (begin < end) {
+            const char *word = begin;
+            while (begin < end && *begin != ' ')
+                ++begin;
+            const char *equal = static_cast<const char *>(memchr(word, '=', static_cast<size_t>(begin - word)));
+            if (equal) {
+                int length = static_cast<int>(equal - word);
+                quint16 value = static_cast<quint16>(hex(equal + 1, begin));
+                if (length == 3 && strncmp(word, "Bus", 3) == 0)
+                    record.bus = value;
+                else if (length == 6 && strncmp(word, "Vendor", 6) == 0)
+                    record.vendor = value;
+                else if (length == 7 && strncmp(word, "Product", 7) == 0)
+                    record.product = value;
+                else if (length == 7 && strncmp(word, "Version", 7) == 0)
+                    record.version = value;
+            }
+            while (begin < end && *begin == ' ')
+                ++begin;
+        }
+    }
+};
+
+#endif // INPUTDEVICEPARSER_H
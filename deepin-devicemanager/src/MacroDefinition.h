@@ -61,7 +61,7 @@
 /**
  * @brief EXPORT_TO_XLSX:导出设备信息到xlsx
  * @param boldFont:字体格式
- * @param htmlFile:xlsx文件
+ * @param xlsx:按行写入的xlsx文件
  * @param deviceLst:设备列表
  * @param type:设备类型
  * @param msg:没有设备时的提示信息
@@ -69,11 +69,11 @@
 #define EXPORT_TO_XLSX(xlsx, boldFont, deviceLst, type, msg)                        \
     /**添加设备类型**/                                                                \
     boldFont.setFontBold(true);                                                     \
-    xlsx.write(m_CurrentXlsRow++, 1, "[" + type + "]", boldFont);                   \
+    xlsx.appendRow(QStringList() << "[" + type + "]", boldFont);                   \
     \
     /**无设备添加提示信息**/                                                           \
     if (deviceLst.size() < 1) {                                                     \
-        xlsx.write(m_CurrentXlsRow++, 1, msg, boldFont);                            \
+        xlsx.appendRow(QStringList() << msg, boldFont);                             \
     }                                                                               \
     \
     /**添加Table信息**/                                                              \
@@ -94,12 +94,12 @@
             boldFont.setFontSize(10);                                               \
             boldFont.setFontBold(true);                                             \
             \
-            xlsx.write(m_CurrentXlsRow++, 1, device->subTitle(), boldFont);         \
+            xlsx.appendRow(QStringList() << device->subTitle(), boldFont);          \
         }                                                                           \
         \
         /**添加设备的详细信息**/                                                       \
         device->toXlsxString(xlsx, boldFont);                                       \
-        m_CurrentXlsRow++;\
+        xlsx.skipRows();                                                            \
     }                                                                               \
     \
 
@@ -122,12 +122,11 @@
     \
     /**添加表格信息**/\
     if (deviceLst.size() > 1) {\
-        Docx::Table *tab = doc.addTable(1,0);\
-        deviceLst[0]->tableHeaderToDoc(tab);\
-        for (int row = 1; row <= deviceLst.size(); ++row) {\
-            tab->addRow();\
-            deviceLst[row - 1]->tableInfoToDoc(tab, row);\
+        deviceLst[0]->tableHeaderToDoc(doc);\
+        foreach (auto device, deviceLst) {\
+            device->tableInfoToDoc(doc);\
         }\
+        doc.endTable();\
     }\
     /**添加每个设备的信息**/                                                           \
     foreach (auto device, deviceLst) {                                              \
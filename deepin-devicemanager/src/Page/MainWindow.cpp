@@ -87,6 +87,10 @@ MainWindow::MainWindow(QWidget *parent)
     initWindow();
     qCDebug(appLog) << "MainWindow constructor end";
 
+    // 先显示上一次保存的设备快照，后台刷新完成后只更新有变化的设备
+    if (DeviceManager::instance()->loadSnapshot(DeviceManager::snapshotPath()))
+        updateDeviceWidget();
+
     // 加载设备信息
     refreshDataBase();
 
@@ -161,10 +165,10 @@ MainWindow::~MainWindow()
     qCDebug(appLog) << "MainWindow destructor start";
     // 释放指针
     if (mp_WorkingThread && mp_WorkingThread->isRunning()) {
-        qCWarning(appLog) << "Terminating running working thread";
-        mp_WorkingThread->terminate();
+        qCWarning(appLog) << "Canceling running working thread";
+        mp_WorkingThread->cancel();
+        mp_WorkingThread->wait();
     }
-    while (mp_WorkingThread && mp_WorkingThread->isRunning()) {}
     if (mp_WaitingWidget) {
         qCDebug(appLog) << "MainWindow destructor delete waiting widget";
         delete mp_WaitingWidget;
@@ -213,6 +217,7 @@ void MainWindow::refresh()
     mp_MainStackWidget->setCurrentIndex(0);
     mp_ButtonBox->buttonList().at(0)->click();
     mp_DeviceWidget->clear();
+    m_DeviceWidgetShown = false;
 
     // 加载设备信息
     refreshDataBase();
@@ -263,6 +268,12 @@ void MainWindow::refreshBatteryStatus()
 bool MainWindow::exportTo()
 {
     qCDebug(appLog) << "MainWindow::exportTo start";
+    // 后台加载时设备列表正在重建
+    if (DeviceManager::instance()->isLoading()) {
+        qCDebug(appLog) << "MainWindow::exportTo device info is loading, return";
+        return false;
+    }
+
     QString selectFilter;
 
     // 导出信息文件保存路径
@@ -514,10 +525,57 @@ void MainWindow::refreshDataBase()
             DApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
             m_statusCursorIsWait = true;
         }
+        // 加载期间设备列表会被清空重建，导出和刷新要等加载完成
+        DeviceManager::instance()->setLoading(true);
         mp_WorkingThread->start();
     }
 }
 
+void MainWindow::updateDeviceWidget(bool updateView)
+{
+    qCDebug(appLog) << "Updating device widget, updateView:" << updateView;
+    // 信息显示界面
+    // 获取设备类型列表
+    DeviceManager::instance()->setDeviceListClass();
+    const QList<QPair<QString, QString>> types = DeviceManager::instance()->getDeviceTypes();
+
+    // 获取设备驱动列表
+    DeviceManager::instance()->getDeviceDriverPool();
+
+    // 更新左侧ListView
+    if (updateView)
+        mp_DeviceWidget->updateListView(types);
+
+    // 设置当前页面设备信息页
+    if (mp_ButtonBox->checkedId() != 1)
+        mp_MainStackWidget->setCurrentWidget(mp_DeviceWidget);
+
+    if (!updateView)
+        return;
+
+    QList<DeviceBaseInfo *> lst;
+    bool ret = DeviceManager::instance()->getDeviceList(mp_DeviceWidget->currentIndex(), lst);
+
+    if (ret && lst.size() > 0) {//当设备大小为0时，显示概况信息
+        mp_DeviceWidget->updateDevice(mp_DeviceWidget->currentIndex(), lst);
+
+        // bug-325731
+        if (Common::specialComType <= 0) {
+            if (mp_DeviceWidget->currentIndex() == QObject::tr("Monitor")) {
+                QtConcurrent::run([=](){
+                    QThread::msleep(700);
+                    emit mp_DeviceWidget->itemClicked(mp_DeviceWidget->currentIndex());
+                    qWarning() << mp_DeviceWidget->currentIndex();
+                });
+            }
+        }
+    } else {
+        QMap<QString, QString> overviewMap = DeviceManager::instance()->getDeviceOverview();
+        mp_DeviceWidget->updateOverview(overviewMap);
+    }
+    m_DeviceWidgetShown = true;
+}
+
 void MainWindow::slotSetPage(const QString &page)
 {
     qCDebug(appLog) << "MainWindow::slotSetPage page:" << page;
@@ -553,41 +611,16 @@ void MainWindow::slotLoadingFinish(const QString &message)
             DApplication::restoreOverrideCursor();
         }
 
-        // 信息显示界面
-        // 获取设备类型列表
-        DeviceManager::instance()->setDeviceListClass();
-        const QList<QPair<QString, QString>> types = DeviceManager::instance()->getDeviceTypes();
+        DeviceManager::instance()->setLoading(false);
 
-        // 获取设备驱动列表
-        DeviceManager::instance()->getDeviceDriverPool();
+        // 属性没有变化的设备继续使用界面正在显示的设备
+        bool changed = DeviceManager::instance()->restoreUnchangedDevices();
+        updateDeviceWidget(changed || !m_DeviceWidgetShown);
 
-        // 更新左侧ListView
-        mp_DeviceWidget->updateListView(types);
-
-        // 设置当前页面设备信息页
-        if (mp_ButtonBox->checkedId() != 1)
-            mp_MainStackWidget->setCurrentWidget(mp_DeviceWidget);
-
-        QList<DeviceBaseInfo *> lst;
-        bool ret = DeviceManager::instance()->getDeviceList(mp_DeviceWidget->currentIndex(), lst);
-
-        if (ret && lst.size() > 0) {//当设备大小为0时，显示概况信息
-            mp_DeviceWidget->updateDevice(mp_DeviceWidget->currentIndex(), lst);
-
-            // bug-325731
-            if (Common::specialComType <= 0) {
-                if (mp_DeviceWidget->currentIndex() == QObject::tr("Monitor")) {
-                    QtConcurrent::run([=](){
-                        QThread::msleep(700);
-                        emit mp_DeviceWidget->itemClicked(mp_DeviceWidget->currentIndex());
-                        qWarning() << mp_DeviceWidget->currentIndex();
-                    });
-                }
-            }
-        } else {
-            QMap<QString, QString> overviewMap = DeviceManager::instance()->getDeviceOverview();
-            mp_DeviceWidget->updateOverview(overviewMap);
-        }
+        // 界面已不再显示旧设备
+        DeviceManager::instance()->releaseRetiredDevices();
+        if (changed)
+            DeviceManager::instance()->saveSnapshot(DeviceManager::snapshotPath());
 
         if (!startScanningFlag) {
             mp_ButtonBox->setEnabled(true);
@@ -616,6 +649,12 @@ void MainWindow::slotLoadingFinish(const QString &message)
 void MainWindow::slotListItemClicked(const QString &itemStr)
 {
     qCDebug(appLog) << "MainWindow::slotListItemClicked itemStr:" << itemStr;
+    // 数据刷新时不处理界面刷新，下面的信息修正也会和生成设备的线程竞争
+    if (m_refreshing || mp_WorkingThread->isRunning() || DeviceManager::instance()->isLoading()) {
+        qCDebug(appLog) << "MainWindow::slotListItemClicked refreshing or working thread running";
+        return;
+    }
+
     // xrandr would be execed later
     if (tr("Monitor") == itemStr || tr("Overview") == itemStr) { //点击显示设备，执行线程加载信息
         ThreadExecXrandr tx(false, !checkWaylandMode());
@@ -655,12 +694,6 @@ void MainWindow::slotListItemClicked(const QString &itemStr)
             monitorNumber = txgpu.getMonitorNumber();
         }
 
-    // 数据刷新时不处理界面刷新
-    if (m_refreshing || mp_WorkingThread->isRunning()) {
-        qCDebug(appLog) << "MainWindow::slotListItemClicked refreshing or working thread running";
-        return;
-    }
-
     QList<DeviceBaseInfo *> lst;
     bool ret = DeviceManager::instance()->getDeviceList(itemStr, lst);
 
@@ -675,6 +708,10 @@ void MainWindow::slotListItemClicked(const QString &itemStr)
 void MainWindow::slotRefreshInfo()
 {
     qCDebug(appLog) << "MainWindow::slotRefreshInfo";
+    if (DeviceManager::instance()->isLoading()) {
+        qCDebug(appLog) << "MainWindow::slotRefreshInfo device info is loading, return";
+        return;
+    }
     refreshDataBaseLater();
     // 界面刷新
     refresh();
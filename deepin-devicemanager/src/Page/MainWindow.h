@@ -129,6 +129,12 @@ private:
      * @brief refreshDataBaseLater:刷新设备信息
      */
     void refreshDataBaseLater();
+
+    /**
+     * @brief updateDeviceWidget:根据当前设备信息更新设备显示界面
+     * @param updateView:是否更新左侧列表和当前设备页，设备没有变化时保持界面不变
+     */
+    void updateDeviceWidget(bool updateView = true);
 private slots:
     /**
      * @brief slotSetPage
@@ -182,6 +188,7 @@ private:
     bool                  m_IsFirstRefresh = true;
     bool                  m_ShowDriverPage = false;
     bool                  m_statusCursorIsWait = false;
+    bool                  m_DeviceWidgetShown = false;   // 设备显示界面是否正在显示设备信息
 };
 
 #endif // MAINWINDOW_H
@@ -5,6 +5,7 @@
 // 项目自身文件
 #include "PageListView.h"
 #include "DeviceListView.h"
+#include "DeviceManager.h"
 #include "MacroDefinition.h"
 #include "DDLog.h"
 
@@ -137,6 +138,10 @@ void PageListView::slotShowMenu(const QPoint &point)
     // 导出/刷新
     if (mp_ListView->indexAt(point).isValid()) {
         qCDebug(appLog) << "Show context menu";
+        // 后台加载设备信息时：刷新导出置灰
+        bool loading = DeviceManager::instance()->isLoading();
+        mp_Export->setEnabled(!loading);
+        mp_Refresh->setEnabled(!loading);
         mp_Menu->addAction(mp_Export);
         mp_Menu->addAction(mp_Refresh);
 
@@ -203,6 +203,10 @@ void PageOverview::slotShowMenu(const QPoint &)
     qCDebug(appLog) << "Showing context menu";
     // 右键菜单
     mp_Menu->clear();
+    // 后台加载设备信息时：刷新导出置灰
+    bool loading = DeviceManager::instance()->isLoading();
+    mp_Refresh->setEnabled(!loading);
+    mp_Export->setEnabled(!loading);
     mp_Menu->addAction(mp_Copy);
     mp_Menu->addAction(mp_Refresh);
     mp_Menu->addAction(mp_Export);
@@ -9,6 +9,7 @@
 #include "PageTableWidget.h"
 #include "PageDriverControl.h"
 #include "DevicePrint.h"
+#include "DeviceManager.h"
 #include "DeviceInput.h"
 #include "DeviceNetwork.h"
 #include "DBusWakeupInterface.h"
@@ -114,13 +115,12 @@ void PageSingleInfo::updateInfo(const QList<DeviceBaseInfo *> &lst)
     // 清空内容
     clearContent();
 
-    //获取设备信息
-    QList<QPair<QString, QString>> baseInfoMap = lst[0]->getBaseTranslationAttribs();
-    QList<QPair<QString, QString>> otherInfoMap = lst[0]->getOtherTranslationAttribs();
-    baseInfoMap = baseInfoMap + otherInfoMap;
+    //获取设备信息，使用设备缓存的翻译结果
+    const QList<QPair<QString, QString>> &baseInfoMap = lst[0]->getBaseTranslationAttribs();
+    const QList<QPair<QString, QString>> &otherInfoMap = lst[0]->getOtherTranslationAttribs();
 
     // 加载设备信息
-    loadDeviceInfo(baseInfoMap);
+    loadDeviceInfo(baseInfoMap + otherInfoMap);
 
     // 设置设备状态
     if (mp_Content) {
@@ -211,6 +211,11 @@ void PageSingleInfo::slotShowMenu(const QPoint &)
     mp_Refresh->setEnabled(true);
     mp_Export->setEnabled(true);
     mp_Copy->setEnabled(true);
+    // 后台加载设备信息时：刷新导出置灰
+    if (DeviceManager::instance()->isLoading()) {
+        mp_Refresh->setEnabled(false);
+        mp_Export->setEnabled(false);
+    }
     mp_Enable->setEnabled(true);
     mp_updateDriver->setEnabled(true);
     mp_removeDriver->setEnabled(true);
@@ -7,7 +7,7 @@
 #define EDIDPARSER_H
 #include<QString>
 #include<QStringList>
-#include<QMap>
+#include<QByteArray>
 #include <QVector>
 
 /**
@@ -42,6 +42,15 @@ public:
      */
     bool setEdid(const QString &edid, QString &errorMsg, const QString &ch = "\n", bool littleEndianMode = true);
 
+    /**
+     * @brief setRawEdid:设置从 sysfs 读取的 edid 二进制数据
+     * @param edid:edid原始字节
+     * @param errorMsg：错误提示信息
+     * @param littleEndianMode：false 时型号按大端模式的字节顺序显示，与 setEdid 保持一致
+     * @return 布尔值：true-设置成功；false-设置失败
+     */
+    bool setRawEdid(const QByteArray &edid, QString &errorMsg, bool littleEndianMode = true);
+
     /**
      * @brief vendor：获取厂商信息
      * @return 厂商信息
@@ -86,6 +95,12 @@ public:
 
 private:
 
+    /**
+     * @brief parseEdid:保存edid数据并解析各项信息
+     * @param edid:小端字节序的edid数据
+     */
+    void parseEdid(const QByteArray &edid);
+
     /**
      * @brief parseVendor:从edid中获取厂商信息
      */
@@ -107,8 +122,8 @@ private:
     void parseMonitorName();
 
     /**
-         * @brief parseDTDs:解析所有 DTD 的屏幕尺寸
-         */
+     * @brief parseDTDs:解析基础块和 CEA 扩展块中所有 DTD 的屏幕尺寸
+     */
     void parseDTDs();
 
     /**
@@ -120,57 +135,11 @@ private:
     void parseOneDTD(int startByte, int dtdIndex, bool isBaseBlock);
 
     /**
-     * @brief binToDec:将二进制转换成十进制
-     * @param strBin：二进制字符串
-     * @return 十进制字符串
-     */
-    QString binToDec(QString strBin);
-
-    /**
-     * @brief decTobin:将十进制转换成二进制
-     * @param strDec::十进制字符串
-     * @return 二进制字符串
-     */
-    QString decTobin(QString strDec);
-
-    /**
-     * @brief decToHex:将十进制转换成十六进制
-     * @param strDec:十进制字符串
-     * @return 十六进制字符串
+     * @brief byteAt:获取edid第index个字节的值
+     * @param index:字节位置
+     * @return 字节值，超出范围时返回0
      */
-    QString decToHex(QString strDec);
-
-    /**
-     * @brief hex2:符号转换
-     * @param ch:字符
-     * @return 整数
-     */
-    int hex2(unsigned char ch);
-
-    /**
-     * @brief hexToDec:将十六进制转换成十进制
-     * @param strHex:十六进制字符串
-     * @return 十进制字符串
-     */
-    QString hexToDec(QString strHex);
-
-    /**
-     * @brief hexToBin:十六进制转换成二进制
-     * @param strHex：十六进制字符串
-     * @return 二进制字符串
-     */
-    QString hexToBin(QString strHex);
-
-    /**@brief:获取第几个字节的值*/
-
-    /**
-     * @brief getBytes:获取第几个字节的值
-     * @param l:行数
-     * @param n：字节数
-     * @return l行第n个字节字符串
-     */
-    QString getBytes(int l, int n);
-
+    quint8 byteAt(int index) const;
 
 private:
     /**@brief:机器的存储模式不同，会导致计算结果不同，所以在解析的时候需要考虑大小端模式*/
@@ -182,8 +151,7 @@ private:
     bool                   m_LittleEndianMode;                 // 小端模式
     int                    m_Width;                            // width
     int                    m_Height;                           // height
-    QStringList            m_ListEdid;                         // edid数据
-    QMap<QString, QString> m_MapCh;                            // 二进制字符串映射到字母A-Z
+    QByteArray             m_Edid;                             // edid数据，大端模式下已转换为小端字节序
     QVector<DTDSizeInfo>   m_DTDSizeInfoList;                  // 所有 DTD 的尺寸信息列表
 
 
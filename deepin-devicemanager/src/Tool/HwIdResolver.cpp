@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "HwIdResolver.h"
+#include "DDLog.h"
+
+#include <QLoggingCategory>
+#include <QDir>
+#include <QMutexLocker>
+
+using namespace DDLog;
+
+// 解析 ids 文件中的4位十六进制数
+static bool parseHex4(const uchar *data, quint16 &id)
+{
+    id = 0;
+    for (int i = 0; i < 4; ++i) {
+        uchar ch = data[i];
+        int value = -1;
+        if (ch >= '0' && ch <= '9')
+            value = ch - '0';
+        else if (ch >= 'a' && ch <= 'f')
+            value = ch - 'a' + 10;
+        else if (ch >= 'A' && ch <= 'F')
+            value = ch - 'A' + 10;
+        if (value < 0)
+            return false;
+        id = static_cast<quint16>(id << 4 | value);
+    }
+    return true;
+}
+
+HwIdResolver &HwIdResolver::instance()
+{
+    static HwIdResolver resolver;
+    return resolver;
+}
+
+HwIdResolver::HwIdResolver()
+    : m_UsbSysfsPath("/sys/bus/usb/devices")
+{
+    m_Database[IT_Usb].paths << "/usr/share/hwdata/usb.ids" << "/usr/share/misc/usb.ids" << "/var/lib/usbutils/usb.ids";
+    m_Database[IT_Pci].paths << "/usr/share/hwdata/pci.ids" << "/usr/share/misc/pci.ids";
+}
+
+bool HwIdResolver::usbDeviceExists(const QString &vid, const QString &pid) const
+{
+    quint16 vendorId = 0;
+    quint16 productId = 0;
+    if (!parseId(vid, vendorId) || !parseId(pid, productId))
+        return false;
+
+    // 与 lsusb 相同，读取每个USB设备描述符中的 idVendor 和 idProduct
+    QDir dir(m_UsbSysfsPath);
+    foreach (const QString &entry, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QFile vendorFile(dir.filePath(entry + "/idVendor"));
+        if (!vendorFile.open(QIODevice::ReadOnly))
+            continue;
+
+        quint16 id = 0;
+        if (!parseId(QString(vendorFile.readAll()).trimmed(), id) || id != vendorId)
+            continue;
+
+        QFile productFile(dir.filePath(entry + "/idProduct"));
+        if (productFile.open(QIODevice::ReadOnly) && parseId(QString(productFile.readAll()).trimmed(), id) && id == productId)
+            return true;
+    }
+    return false;
+}
+
+QString HwIdResolver::vendorName(IdType type, const QString &vid)
+{
+    quint16 vendorId = 0;
+    if (!parseId(vid, vendorId))
+        return QString();
+
+    QMutexLocker locker(&m_Mutex);
+    Database &db = m_Database[type];
+    load(db);
+    auto it = db.vendors.constFind(vendorId);
+    return it == db.vendors.constEnd() ? QString() : name(db, *it);
+}
+
+QString HwIdResolver::productName(IdType type, const QString &vid, const QString &pid)
+{
+    quint16 vendorId = 0;
+    quint16 productId = 0;
+    if (!parseId(vid, vendorId) || !parseId(pid, productId))
+        return QString();
+
+    QMutexLocker locker(&m_Mutex);
+    Database &db = m_Database[type];
+    load(db);
+    auto it = db.products.constFind(quint32(vendorId) << 16 | productId);
+    return it == db.products.constEnd() ? QString() : name(db, *it);
+}
+
+void HwIdResolver::setDatabasePaths(IdType type, const QStringList &paths)
+{
+    QMutexLocker locker(&m_Mutex);
+    unload(m_Database[type]);
+    m_Database[type].paths = paths;
+}
+
+void HwIdResolver::setUsbSysfsPath(const QString &path)
+{
+    m_UsbSysfsPath = path;
+}
+
+void HwIdResolver::load(Database &db)
+{
+    if (db.loaded)
+        return;
+    db.loaded = true;
+
+    foreach (const QString &path, db.paths) {
+        db.file.setFileName(path);
+        if (db.file.open(QIODevice::ReadOnly))
+            break;
+    }
+    if (!db.file.isOpen()) {
+        qCWarning(appLog) << "No ids database found in" << db.paths;
+        return;
+    }
+
+    db.size = db.file.size();
+    db.data = db.file.map(0, db.size);
+    if (!db.data) {
+        qCWarning(appLog) << "Failed to map ids database" << db.file.fileName();
+        db.file.close();
+        return;
+    }
+
+    // 厂商行:  "1234  Vendor name"
+    // 设备行:  "\t5678  Device name"
+    // 其它行(接口、子系统、设备类等)都跳过，厂商之外的分段会结束当前厂商
+    const uchar *data = db.data;
+    qint64 pos = 0;
+    bool inVendor = false;
+    quint16 vendorId = 0;
+    while (pos < db.size) {
+        qint64 end = pos;
+        while (end < db.size && data[end] != '\n')
+            ++end;
+
+        const uchar *line = data + pos;
+        qint64 length = end - pos;
+        quint16 id = 0;
+        if (length > 6 && line[0] != '#' && line[0] != '\t') {
+            inVendor = parseHex4(line, vendorId) && line[4] == ' ';
+            if (inVendor) {
+                Name n;
+                n.offset = static_cast<int>(pos + 6);
+                n.length = static_cast<int>(length - 6);
+                db.vendors.insert(vendorId, n);
+            }
+        } else if (inVendor && length > 7 && line[0] == '\t' && line[1] != '\t' && parseHex4(line + 1, id) && line[5] == ' ') {
+            Name n;
+            n.offset = static_cast<int>(pos + 7);
+            n.length = static_cast<int>(length - 7);
+            db.products.insert(quint32(vendorId) << 16 | id, n);
+        }
+        pos = end + 1;
+    }
+    qCDebug(appLog) << "Loaded ids database" << db.file.fileName() << "vendors:" << db.vendors.size() << "products:" << db.products.size();
+}
+
+void HwIdResolver::unload(Database &db)
+{
+    if (db.data)
+        db.file.unmap(const_cast<uchar *>(db.data));
+    db.file.close();
+    db.data = nullptr;
+    db.size = 0;
+    db.vendors.clear();
+    db.products.clear();
+    db.loaded = false;
+}
+
+QString HwIdResolver::name(const Database &db, const Name &n) const
+{
+    if (!db.data || n.offset + n.length > db.size)
+        return QString();
+    return QString::fromUtf8(reinterpret_cast<const char *>(db.data) + n.offset, n.length).trimmed();
+}
+
+bool HwIdResolver::parseId(const QString &str, quint16 &id)
+{
+    QString value = str.trimmed().toLower();
+    if (value.startsWith("0x"))
+        value = value.mid(2);
+    if (value.isEmpty() || value.size() > 4)
+        return false;
+
+    bool ok = false;
+    id = static_cast<quint16>(value.toUInt(&ok, 16));
+    return ok;
+}
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef HWIDRESOLVER_H
+#define HWIDRESOLVER_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QFile>
+#include <QMutex>
+
+/**
+ * @brief The HwIdResolver class
+ * 进程内的 USB/PCI ID 解析，代替 lsusb 获取设备是否存在以及厂商、设备名称
+ * usb.ids/pci.ids 在第一次查询时映射到内存并建立索引，之后的查询都是哈希查找
+ */
+class HwIdResolver
+{
+public:
+    enum IdType {
+        IT_Usb = 0,
+        IT_Pci,
+        IT_Count
+    };
+
+    static HwIdResolver &instance();
+
+    /**
+     * @brief usbDeviceExists 根据 sysfs 中的 USB 描述符判断设备是否存在
+     * @param vid 厂商ID，如 046d
+     * @param pid 产品ID，如 c52b
+     * @return
+     */
+    bool usbDeviceExists(const QString &vid, const QString &pid) const;
+
+    /**
+     * @brief vendorName 获取厂商名称
+     * @param type USB或PCI
+     * @param vid 厂商ID，可以带 0x 前缀
+     * @return 数据库中没有时为空
+     */
+    QString vendorName(IdType type, const QString &vid);
+
+    /**
+     * @brief productName 获取设备名称
+     * @param type USB或PCI
+     * @param vid 厂商ID，可以带 0x 前缀
+     * @param pid 设备ID，可以带 0x 前缀
+     * @return 数据库中没有时为空
+     */
+    QString productName(IdType type, const QString &vid, const QString &pid);
+
+    /**
+     * @brief setDatabasePaths 设置 ids 数据库的查找路径，已加载的数据会被清空
+     * @param type USB或PCI
+     * @param paths 按顺序查找的文件路径
+     */
+    void setDatabasePaths(IdType type, const QStringList &paths);
+
+    /**
+     * @brief setUsbSysfsPath 设置 USB 设备的 sysfs 目录
+     * @param path 默认为 /sys/bus/usb/devices
+     */
+    void setUsbSysfsPath(const QString &path);
+
+private:
+    HwIdResolver();
+    Q_DISABLE_COPY(HwIdResolver)
+
+    /**
+     * @brief Name ids 文件中一个名称的位置
+     */
+    struct Name {
+        int offset = 0;
+        int length = 0;
+    };
+
+    struct Database {
+        QStringList              paths;       //<! ids 文件查找路径
+        bool                     loaded = false;
+        QFile                    file;        //<! 映射到内存的 ids 文件
+        const uchar              *data = nullptr;
+        qint64                   size = 0;
+        QHash<quint16, Name>     vendors;     //<! 厂商ID与名称
+        QHash<quint32, Name>     products;    //<! (厂商ID << 16 | 设备ID)与名称
+    };
+
+    /**
+     * @brief load 映射 ids 文件并建立索引，只执行一次
+     * @param db 数据库
+     */
+    void load(Database &db);
+
+    /**
+     * @brief unload 释放已映射的文件和索引
+     * @param db 数据库
+     */
+    void unload(Database &db);
+
+    /**
+     * @brief name 读取名称
+     */
+    QString name(const Database &db, const Name &n) const;
+
+    /**
+     * @brief parseId 把 0x1234 或 1234 格式的字符串转为ID
+     */
+    static bool parseId(const QString &str, quint16 &id);
+
+    Database   m_Database[IT_Count];    //<! USB和PCI数据库
+    QString    m_UsbSysfsPath;          //<! USB 设备的 sysfs 目录
+    QMutex     m_Mutex;
+};
+
+#endif // HWIDRESOLVER_H
@@ -192,98 +192,51 @@ QString CommonTools::getBackupPath()
     return "/var/lib/deepin-devicemanager/";
 }
 
-void CommonTools::parseEDID(const QStringList &allEDIDS, const QString &input, bool isHW)
+QByteArray CommonTools::readEdid(const QString &path)
 {
-    for (auto edid:allEDIDS) {
-        QString edidStr;
-        if (isHW) {
-            QProcess process;
-            process.start("hexdump", QStringList() << edid);
-            if (!process.waitForFinished(3000)) {
-                qCritical() << "Failed to hexdump edid file!";
-                continue;
-            }
-
-            QString deviceInfo = QString::fromLocal8Bit(process.readAllStandardOutput());
-            if (deviceInfo.isEmpty()) {
-                qWarning() << "The edid file is empty! " << edid;
-                continue;
-            }
-
-            QStringList lines = deviceInfo.split("\n");
-            for (auto line:lines) {
-                QStringList words = line.trimmed().split(" ");
-                if (words.size() != 9)
-                    continue;
-
-                words.removeAt(0);
-                QString l = words.join("");
-                l.append("\n");
-                edidStr.append(l);
-            }
-        } else {
-            QProcess process;
-            process.start("hexdump", QStringList() << "-C" << edid);
-            if (!process.waitForFinished(3000)) {
-                qCritical() << "Failed to hexdump edid file!";
-                continue;
-            }
-            QString deviceInfo = QString::fromLocal8Bit(process.readAllStandardOutput());
-            if (deviceInfo.isEmpty()) {
-                qWarning() << "The edid file is empty! " << edid;
-                continue;
-            }
-
-            QStringList lines = deviceInfo.split("\n");
-            for (auto line: lines) {
-                if (line.trimmed().isEmpty())
-                    continue;
-                int firstSpace = line.indexOf(" ");
-                int lastPipe = line.indexOf("|");
-
-                if (firstSpace == -1 || lastPipe == -1 || firstSpace >= lastPipe)
-                    continue;
-
-                QString hexPart = line.mid(firstSpace + 2, lastPipe - firstSpace -3).trimmed();
-
-                QStringList hexBytes = hexPart.split(QRegularExpression("\\s+"));
+    // sysfs 中的edid文件大小和修改时间不随显示器变化，每次都重新读取
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(appLog) << "Failed to open edid file!" << path;
+        return QByteArray();
+    }
 
-                QString lineData;
-                for (const QString &hexByte : hexBytes) {
-                    if (hexByte.length() == 2 && hexByte != "")
-                        lineData.append(hexByte);
-                }
+    QByteArray data = file.readAll();
+    file.close();
+    return data;
+}
 
-                if (lineData.length() == 32)
-                    edidStr.append(lineData + "\n");
-            }
+void CommonTools::parseEDID(const QStringList &allEDIDS, const QString &input, bool isHW)
+{
+    for (auto edid:allEDIDS) {
+        QByteArray data = readEdid(edid);
+        if (data.isEmpty()) {
+            qWarning() << "The edid file is empty! " << edid;
+            continue;
         }
 
-        QStringList lines = edidStr.split("\n");
-        if (lines.size() > 3){
-            EDIDParser edidParser;
-            QString errorMsg;
-            if (!edidParser.setEdid(edidStr,errorMsg,"\n", isHW ? false : true)) {
-                qCWarning(appLog) << errorMsg;
-                continue;
-            }
-
-            QMap<QString, QString> mapInfo;
-            mapInfo.insert("Vendor",edidParser.vendor());
-            if (isHW)
-                mapInfo.insert("Model",edidParser.model());
-            else
-                mapInfo.insert("Model",edidParser.monitorName());
-            mapInfo.insert("Size",edidParser.screenSize());
-            mapInfo.insert("Display Input",input);
-
-            DeviceMonitor *device = new DeviceMonitor();
-            if (isHW)
-                device->setInfoFromEdid(mapInfo);
-            else
-                device->setInfoFromEdidForCustom(mapInfo);
-            DeviceManager::instance()->addMonitor(device);
+        EDIDParser edidParser;
+        QString errorMsg;
+        if (!edidParser.setRawEdid(data, errorMsg, isHW ? false : true)) {
+            qCWarning(appLog) << errorMsg;
+            continue;
         }
+
+        QMap<QString, QString> mapInfo;
+        mapInfo.insert("Vendor",edidParser.vendor());
+        if (isHW)
+            mapInfo.insert("Model",edidParser.model());
+        else
+            mapInfo.insert("Model",edidParser.monitorName());
+        mapInfo.insert("Size",edidParser.screenSize());
+        mapInfo.insert("Display Input",input);
+
+        DeviceMonitor *device = new DeviceMonitor();
+        if (isHW)
+            device->setInfoFromEdid(mapInfo);
+        else
+            device->setInfoFromEdidForCustom(mapInfo);
+        DeviceManager::instance()->addMonitor(device);
     }
 }
 
@@ -78,9 +78,22 @@ public:
      */
     static QString getBackupPath();
 
+    /**
+     * @brief parseEDID 解析 /sys/class/drm 下的edid文件并添加显示器设备
+     * @param allEDIDS edid文件路径
+     * @param input 显示器接口
+     * @param isHW 是否为HW机型
+     */
     static void parseEDID(const QStringList &allEDIDS, const QString &input, bool isHW = true);
     static QString preGenerateGpuInfo();
 
+    /**
+     * @brief readEdid 读取edid二进制数据
+     * @param path edid文件路径
+     * @return edid原始字节，读取失败时为空
+     */
+    static QByteArray readEdid(const QString &path);
+
 private:
     static bool getGpuBaseInfo(QMap<QString, QString> &mapInfo);
 
@@ -19,6 +19,7 @@
 #include <QLoggingCategory>
 #include <DFontSizeManager>
 #include <QPainterPath>
+#include <QGuiApplication>
 
 // 其它头文件
 #include "DetailTreeView.h"
@@ -29,6 +30,7 @@ using namespace DDLog;
 
 RichTextDelegate::RichTextDelegate(QObject *parent)
     : QStyledItemDelegate(parent)
+    , m_LayoutCache(512)
 {
     qCDebug(appLog) << "RichTextDelegate instance created";
 }
@@ -88,7 +90,7 @@ void RichTextDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
     // 确定绘制区域的形状，单元格
     rectpath.setWidth(rect.width() - 1);
 
-    DWidget *par = dynamic_cast<DWidget *>(this->parent());
+    QWidget *par = qobject_cast<QWidget *>(this->parent());
     if (!par) {
         // qCWarning(appLog) << "Failed to get parent widget";
         return;
@@ -97,7 +99,8 @@ void RichTextDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
 
         // 高度不超过表格高度
         if (rectpath.y() + rectpath.height() < 40 * (par->height() / 40 - 1)) {
-            path.addRect(rectpath);
+            // 中间的单元格直接填充矩形
+            painter->fillRect(rectpath, background);
         } else {
             // qCDebug(appLog) << "Cell exceeds table bottom border";
             // 单元格超过表格下边框
@@ -232,66 +235,82 @@ void RichTextDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
     }
 
 
-    painter->fillPath(path, background);
+    if (!path.isEmpty())
+        painter->fillPath(path, background);
 
-    QStringList lstStr = opt.text.split("\n");
-    if (lstStr.size() > 1) {
+    // 排版结果按文本缓存，这里只绘制
+    QTextDocument *textDoc = textLayout(opt.text, option.rect.width() - 6);//设置文本左边空6px的位置。1. 文本长度减6
+    QAbstractTextDocumentLayout::PaintContext   paintContext;
+    paintContext.palette.setCurrentColorGroup(cg);
+    QRect  textRect = style->subElementRect(QStyle::SE_ItemViewItemText,  &opt);
+    textRect.setWidth(textRect.size().width() - 6);//设置文本左边空6px的位置。2. 显示矩形减6
+    QPoint point;
+    if (opt.text.contains("\n")) {
         // qCDebug(appLog) << "Painting multi-line text";
-        QTextDocument  textDoc;
-        //设置文字居中显示
-        textDoc.setTextWidth(option.rect.width() - 6);//设置文本左边空6px的位置。1. 文本长度减6
-        //设置文本内容
-        QDomDocument doc;
-        getDocFromLst(doc, lstStr);
-        textDoc.setHtml(doc.toString());
-
         // bug111063中 社区版与专业版使用同一代码，主板界面展示效果不同
         // PageBoardInfo 中计算行高方式与html中计算行高方式不同，导致每行下方出现截断或空白
         // 此处获取html整体高度后再对PageBoardInfo设置行高，则不会再出现截断或空白
-        dynamic_cast<PageSingleInfo *>(this->parent())->setRowHeight(index.row(), textDoc.size().toSize().height() + 6);
+        PageSingleInfo *page = qobject_cast<PageSingleInfo *>(this->parent());
+        if (page)
+            page->setRowHeight(index.row(), textDoc->size().toSize().height() + 6);
 
-        QAbstractTextDocumentLayout::PaintContext   paintContext;
-        paintContext.palette.setCurrentColorGroup(cg);
-        QRect  textRect = style->subElementRect(QStyle::SE_ItemViewItemText,  &opt);
-        textRect.setWidth(textRect.size().width() - 6);//设置文本左边空6px的位置。2. 显示矩形减6
         textRect.setHeight(textRect.size().height() - 3);
-        QPoint point(QPoint(option.rect.x() + 6, option.rect.y() + 3));//设置文本左边空6px的位置。1. 文本长度减6
-        painter->save();
-        painter->translate(point);
-        painter->setClipRect(textRect.translated(-point));
-        textDoc.documentLayout()->draw(painter, paintContext);
-        painter->restore();
+        point = QPoint(option.rect.x() + 6, option.rect.y() + 3);//设置文本左边空6px的位置。1. 文本长度减6
     } else {
         // qCDebug(appLog) << "Painting single-line text";
-        QTextDocument  textDoc;
-        //设置文字居中显示
-        textDoc.setTextWidth(option.rect.width() - 6);//设置文本左边空6px的位置。1. 文本长度减6
-        //设置文本内容
-        QDomDocument doc;
+        textRect.setHeight(textRect.size().height() - 6);
+        point = QPoint(option.rect.x() + 6, option.rect.y() + 6);//设置文本左边空6px的位置。3. 显示矩形位置加6
+    }
+    painter->save();
+    painter->translate(point);
+    painter->setClipRect(textRect.translated(-point));
+    textDoc->documentLayout()->draw(painter, paintContext);
+    painter->restore();
+
+    painter->restore();
+}
+
+QTextDocument *RichTextDelegate::textLayout(const QString &text, int width) const
+{
+    int fontPixelSize = DFontSizeManager::instance()->t8().pixelSize();
+    QFont font = QGuiApplication::font();
+    TextLayout *layout = m_LayoutCache.object(text);
+    if (layout && layout->fontPixelSize == fontPixelSize && layout->font == font) {
+        // 只有宽度变化时重新排版，不需要重新解析html
+        if (layout->width != width) {
+            layout->doc.setTextWidth(width);
+            layout->width = width;
+        }
+        return &layout->doc;
+    }
+
+    layout = new TextLayout;
+    layout->width = width;
+    layout->fontPixelSize = fontPixelSize;
+    layout->font = font;
+    layout->doc.setDefaultFont(font);
+    //设置文字居中显示
+    layout->doc.setTextWidth(width);
+
+    //设置文本内容
+    QDomDocument doc;
+    QStringList lstStr = text.split("\n");
+    if (lstStr.size() > 1) {
+        getDocFromLst(doc, lstStr);
+    } else {
         QDomElement p = doc.createElement("p");
         p.setAttribute("width", "100%");
         p.setAttribute("border", "0");
         p.setAttribute("style", "text-align:left;");
         p.setAttribute("style", "font-weight:504;");
-        QDomText nameText = doc.createTextNode(opt.text);
+        QDomText nameText = doc.createTextNode(text);
         p.appendChild(nameText);
         doc.appendChild(p);
-        textDoc.setHtml(doc.toString());
-
-        QAbstractTextDocumentLayout::PaintContext   paintContext;
-        paintContext.palette.setCurrentColorGroup(cg);
-        QRect  textRect = style->subElementRect(QStyle::SE_ItemViewItemText,  &opt);
-        textRect.setWidth(textRect.size().width() - 6);//设置文本左边空6px的位置。2. 显示矩形减6
-        textRect.setHeight(textRect.size().height() - 6);
-        QPoint point(QPoint(option.rect.x() + 6, option.rect.y() + 6));//设置文本左边空6px的位置。3. 显示矩形位置加6
-        painter->save();
-        painter->translate(point);
-        painter->setClipRect(textRect.translated(-point));
-        textDoc.documentLayout()->draw(painter, paintContext);
-        painter->restore();
     }
+    layout->doc.setHtml(doc.toString());
 
-    painter->restore();
+    m_LayoutCache.insert(text, layout);
+    return &layout->doc;
 }
 
 QWidget *RichTextDelegate::createEditor(QWidget *, const QStyleOptionViewItem &, const QModelIndex &) const
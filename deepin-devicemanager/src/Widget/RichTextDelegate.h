@@ -9,6 +9,9 @@
 #include <QObject>
 #include <QStyledItemDelegate>
 #include <QDomDocument>
+#include <QTextDocument>
+#include <QCache>
+#include <QFont>
 
 /**
  * @brief The RichTextDelegate class
@@ -27,10 +30,31 @@ protected:
     void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
 
 private:
+    /**
+     * @brief The TextLayout struct
+     * 排版好的单元格文本，文本相同且宽度、字体不变时直接绘制
+     */
+    struct TextLayout {
+        QTextDocument doc;
+        int           width = 0;           //<! 排版宽度
+        int           fontPixelSize = 0;   //<! 表格字号
+        QFont         font;                //<! 默认字体
+    };
+
+    /**
+     * @brief textLayout 获取单元格文本的排版，没有缓存或宽度、字体变化时重新排版
+     * @param text 单元格文本，多行时为 key:value 表格
+     * @param width 排版宽度
+     * @return 排版好的文本
+     */
+    QTextDocument *textLayout(const QString &text, int width) const;
+
     void getDocFromLst(QDomDocument &doc, const QStringList &lst)const;
     void addRow(QDomDocument &doc, QDomElement &table, const QPair<QString, QString> &pair,const int &rowWidth)const;
     void addTd1(QDomDocument &doc, QDomElement &tr, const QString &value,const int &rowWidth)const;
     void addTd2(QDomDocument &doc, QDomElement &tr, const QString &value)const;
+
+    mutable QCache<QString, TextLayout> m_LayoutCache;   //<! 单元格文本与排版
 };
 
 #endif // RICHTEXTDELEGATE_H
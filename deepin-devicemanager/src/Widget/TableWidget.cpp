@@ -5,6 +5,7 @@
 // 项目自身文件
 #include "TableWidget.h"
 #include "PageDriverControl.h"
+#include "DeviceManager.h"
 #include "MacroDefinition.h"
 #include "logviewitemdelegate.h"
 #include "logtreeview.h"
@@ -215,6 +216,11 @@ void TableWidget::slotShowMenu(const QPoint &point)
     mp_Refresh->setEnabled(true);
     mp_Export->setEnabled(true);
     mp_Enable->setEnabled(true);
+    // 后台加载设备信息时：刷新导出置灰
+    if (DeviceManager::instance()->isLoading()) {
+        mp_Refresh->setEnabled(false);
+        mp_Export->setEnabled(false);
+    }
     mp_updateDriver->setEnabled(true);
     mp_removeDriver->setEnabled(true);
     mp_WakeupMachine->setEnabled(true);
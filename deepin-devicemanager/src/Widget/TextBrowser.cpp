@@ -7,6 +7,7 @@
 #include "DeviceNetwork.h"
 #include "DeviceInfo.h"
 #include "DeviceInput.h"
+#include "DeviceManager.h"
 #include "DBusWakeupInterface.h"
 #include "DDLog.h"
 
@@ -221,6 +222,10 @@ void TextBrowser::slotShowMenu(const QPoint &)
     m_IsMenuShowing = true;
     // 右键菜单
     mp_Menu->clear();
+    // 后台加载设备信息时：刷新导出置灰
+    bool loading = DeviceManager::instance()->isLoading();
+    mp_Refresh->setEnabled(!loading);
+    mp_Export->setEnabled(!loading);
     mp_Menu->addAction(mp_Copy);
     mp_Menu->addAction(mp_Refresh);
     mp_Menu->addAction(mp_Export);
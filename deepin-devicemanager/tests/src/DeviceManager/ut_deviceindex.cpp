@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceIndex.h"
+#include "DeviceManager.h"
+#include "DeviceImage.h"
+
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <gtest/gtest.h>
+
+class UT_DeviceIndex : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+static int s_MatchCount = 0;
+
+bool ut_index_matchToLshw()
+{
+    ++s_MatchCount;
+    return true;
+}
+
+static DeviceImage *ut_index_createImage(int i)
+{
+    DeviceImage *device = new DeviceImage;
+    device->m_UniqueID = QString("unique_%1").arg(i);
+    device->m_SysPath = QString("/devices/pci0000:00/usb1/1-%1").arg(i);
+    device->m_HwinfoToLshw = QString("usb@1:%1").arg(i);
+    return device;
+}
+
+// 添加count个设备后逐个合并lshw信息，返回matchToLshw被调用的次数
+static int ut_index_mergeImages(int count, qint64 &elapsed)
+{
+    DeviceManager *manager = DeviceManager::instance();
+    manager->m_ListDeviceImage.clear();
+    manager->clearDeviceIndex();
+    for (int i = 0; i < count; ++i)
+        manager->addImageDevice(ut_index_createImage(i));
+
+    s_MatchCount = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i) {
+        QMap<QString, QString> mapInfo;
+        mapInfo.insert("bus info", QString("usb@1:%1").arg(i));
+        manager->setCameraInfoFromLshw(mapInfo);
+        EXPECT_TRUE(manager->getImageDevice(QString("unique_%1").arg(i)) != nullptr);
+    }
+    elapsed = timer.elapsed();
+
+    foreach (DeviceBaseInfo *device, manager->m_ListDeviceImage)
+        delete device;
+    manager->m_ListDeviceImage.clear();
+    manager->clearDeviceIndex();
+    return s_MatchCount;
+}
+
+TEST_F(UT_DeviceIndex, UT_DeviceIndex_find)
+{
+    DeviceImage *first = ut_index_createImage(1);
+    DeviceImage *second = ut_index_createImage(2);
+    second->m_HwinfoToLshw = first->m_HwinfoToLshw;
+
+    DeviceIndex index;
+    index.insert(first);
+    index.insert(second);
+    EXPECT_EQ(2, index.size());
+
+    QList<DeviceBaseInfo *> lst = index.find(DeviceIndex::IK_BusInfo, QString("usb@1:1"));
+    ASSERT_EQ(2, lst.size());
+    EXPECT_EQ(first, lst[0]);
+    EXPECT_EQ(second, lst[1]);
+    EXPECT_EQ(1, index.find(DeviceIndex::IK_UniqueID, QString("unique_2")).size());
+    EXPECT_TRUE(index.find(DeviceIndex::IK_UniqueID, QString("unique_3")).isEmpty());
+
+    // 修改关键属性后更新索引，顺序保持不变
+    first->m_HwinfoToLshw = "usb@1:9";
+    index.update(first);
+    EXPECT_EQ(1, index.find(DeviceIndex::IK_BusInfo, QString("usb@1:1")).size());
+    lst = index.find(DeviceIndex::IK_BusInfo, QStringList() << "usb@1:9" << "usb@1:1");
+    ASSERT_EQ(2, lst.size());
+    EXPECT_EQ(first, lst[0]);
+
+    index.remove(second);
+    EXPECT_TRUE(index.find(DeviceIndex::IK_BusInfo, QString("usb@1:1")).isEmpty());
+    EXPECT_EQ(1, index.size());
+
+    delete first;
+    delete second;
+}
+
+static int s_KeyCount = 0;
+
+const QString &ut_index_hwinfoLshwKey(DeviceBaseInfo *device)
+{
+    ++s_KeyCount;
+    return device->m_HwinfoToLshw;
+}
+
+static int s_VendorNameCount = 0;
+
+bool ut_index_findByVendorName()
+{
+    ++s_VendorNameCount;
+    return false;
+}
+
+TEST_F(UT_DeviceIndex, UT_DeviceIndex_updateOnChange)
+{
+    DeviceManager *manager = DeviceManager::instance();
+    manager->m_ListDeviceImage.clear();
+    manager->clearDeviceIndex();
+    for (int i = 0; i < 100; ++i)
+        manager->addImageDevice(ut_index_createImage(i));
+
+    Stub stub;
+    stub.set(ADDR(DeviceBaseInfo, hwinfoLshwKey), ut_index_hwinfoLshwKey);
+
+    // 查找时不再遍历设备列表重新计算关键属性
+    s_KeyCount = 0;
+    QMap<QString, QString> mapInfo;
+    for (int i = 0; i < 100; ++i) {
+        mapInfo.insert("bus info", QString("usb@1:%1").arg(i));
+        EXPECT_EQ(1, manager->lshwCandidates(DT_Image, mapInfo).size());
+    }
+    EXPECT_EQ(0, s_KeyCount);
+
+    // 关键属性被修改后由调用者更新索引
+    DeviceImage *device = dynamic_cast<DeviceImage *>(manager->m_ListDeviceImage[5]);
+    device->m_HwinfoToLshw = "usb@2:5";
+    manager->updateDeviceIndex(DT_Image, device);
+    EXPECT_EQ(1, s_KeyCount);
+    mapInfo.insert("bus info", "usb@2:5");
+    EXPECT_EQ(device, manager->lshwCandidates(DT_Image, mapInfo).value(0));
+    mapInfo.insert("bus info", "usb@1:5");
+    EXPECT_TRUE(manager->lshwCandidates(DT_Image, mapInfo).isEmpty());
+
+    qDeleteAll(manager->m_ListDeviceImage);
+    manager->m_ListDeviceImage.clear();
+    manager->clearDeviceIndex();
+}
+
+TEST_F(UT_DeviceIndex, UT_DeviceIndex_tomlFindDevice)
+{
+    DeviceManager *manager = DeviceManager::instance();
+    manager->m_ListDeviceImage.clear();
+    manager->clearDeviceIndex();
+    for (int i = 0; i < 10; ++i) {
+        DeviceImage *device = ut_index_createImage(i);
+        device->m_Modalias = QString("usb:v1234p56%1d0100dcEFdsc02dp01").arg(i, 2, 10, QLatin1Char('0'));
+        device->m_VID_PID = QString("0x123456%1").arg(i, 2, 10, QLatin1Char('A'));
+        manager->addImageDevice(device);
+    }
+
+    Stub stub;
+    stub.set(ADDR(DeviceManager, findByVendorName), ut_index_findByVendorName);
+    s_VendorNameCount = 0;
+
+    // toml 中的硬件ID为小写，与 sysfs 中的大写 modalias 匹配
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("Modalias", "usb:v1234p5603d0100dcefdsc02dp01");
+    EXPECT_EQ(manager->m_ListDeviceImage[3], manager->tomlFindDevice(DT_Image, mapInfo));
+
+    mapInfo.clear();
+    mapInfo.insert("Vendor_ID", "0x1234");
+    mapInfo.insert("Product_ID", "56A7");
+    EXPECT_EQ(manager->m_ListDeviceImage[7], manager->tomlFindDevice(DT_Image, mapInfo));
+
+    mapInfo.insert("Product_ID", "0x9999");
+    EXPECT_EQ(nullptr, manager->tomlFindDevice(DT_Image, mapInfo));
+    // 只有硬件ID时不逐个比较厂商名称
+    EXPECT_EQ(0, s_VendorNameCount);
+
+    qDeleteAll(manager->m_ListDeviceImage);
+    manager->m_ListDeviceImage.clear();
+    manager->clearDeviceIndex();
+}
+
+TEST_F(UT_DeviceIndex, UT_DeviceIndex_lshwKeys)
+{
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("bus info", "pci@0000:01:00.0");
+    QStringList keys = DeviceIndex::lshwKeys(mapInfo);
+    EXPECT_TRUE(keys.contains("0000:01:00.0"));
+    EXPECT_TRUE(keys.contains("pci@0000:01:00.0"));
+
+    mapInfo.clear();
+    mapInfo.insert("serial", "00:11:22:33:44:55");
+    mapInfo.insert("logical name", "enp2s0");
+    keys = DeviceIndex::lshwKeys(mapInfo);
+    EXPECT_TRUE(keys.contains("00:11:22:33:44:55enp2s0"));
+    EXPECT_TRUE(keys.contains("00:11:22:33:44:55"));
+}
+
+TEST_F(UT_DeviceIndex, UT_DeviceIndex_mergeScalesLinearly)
+{
+    Stub stub;
+    stub.set(ADDR(DeviceBaseInfo, matchToLshw), ut_index_matchToLshw);
+
+    qint64 elapsedHalf = 0;
+    qint64 elapsedFull = 0;
+    // 每条lshw信息只与一个设备比较，遍历设备列表时为 count * count 次
+    EXPECT_EQ(500, ut_index_mergeImages(500, elapsedHalf));
+    EXPECT_EQ(1000, ut_index_mergeImages(1000, elapsedFull));
+    qInfo() << "merge 500 devices:" << elapsedHalf << "ms, 1000 devices:" << elapsedFull << "ms";
+}
@@ -7,12 +7,21 @@
 #include "DeviceAudio.h"
 
 #include "xlsxdocument.h"
+#include "xlsxcell.h"
+#include "streamdocument.h"
 #include "ut_Head.h"
 #include "stub.h"
 
 #include <QCoreApplication>
 #include <QPaintEvent>
 #include <QPainter>
+#include <QTemporaryDir>
+#include <QDomDocument>
+
+#include <private/qzipreader_p.h>
+#include <private/qzipwriter_p.h>
+
+#include <libkmod.h>
 
 #include <gtest/gtest.h>
 
@@ -130,3 +139,162 @@ TEST_F(UT_DeviceInfo, UT_DeviceInfo_mapInfoToList)
 
     EXPECT_EQ(1, m_deviceBaseInfo->m_LstOtherInfo.size());
 }
+
+static int s_LookupCount = 0;
+int ut_deviceinfo_lookup(struct kmod_ctx *, const char *, struct kmod_list **list)
+{
+    ++s_LookupCount;
+    *list = nullptr;
+    return 0;
+}
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_moduleInfo)
+{
+    Stub stub;
+    stub.set(kmod_module_new_from_lookup, ut_deviceinfo_lookup);
+
+    // 同一模块只查询一次，找不到的模块属于核内驱动
+    DeviceBaseInfo::clearModuleInfo();
+    s_LookupCount = 0;
+    for (int i = 0; i < 10; ++i)
+        EXPECT_TRUE(audio->driverIsKernelIn("ut_not_exist_module"));
+    EXPECT_FALSE(DeviceBaseInfo::moduleInfo("ut_not_exist_module").found);
+    EXPECT_EQ(1, s_LookupCount);
+}
+
+static int s_LoadResourcesCount = 0;
+int ut_deviceinfo_load_resources(struct kmod_ctx *)
+{
+    ++s_LoadResourcesCount;
+    return 0;
+}
+
+int ut_deviceinfo_validate_reload(struct kmod_ctx *)
+{
+    return KMOD_RESOURCES_MUST_RELOAD;
+}
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_clearModuleInfo)
+{
+    Stub stub;
+    stub.set(kmod_module_new_from_lookup, ut_deviceinfo_lookup);
+    stub.set(kmod_load_resources, ut_deviceinfo_load_resources);
+    stub.set(kmod_validate_resources, ut_deviceinfo_validate_reload);
+
+    DeviceBaseInfo::moduleInfo("ut_not_exist_module");
+
+    // 刷新后重新查询，模块索引变化时重新加载
+    s_LookupCount = 0;
+    s_LoadResourcesCount = 0;
+    DeviceBaseInfo::clearModuleInfo();
+    DeviceBaseInfo::moduleInfo("ut_not_exist_module");
+    EXPECT_EQ(1, s_LookupCount);
+    EXPECT_EQ(1, s_LoadResourcesCount);
+}
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_toXlsxString)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/export.xlsx";
+    audio->m_LstBaseInfoTr.append(QPair<QString, QString>("Name", "  ALC897 "));
+    audio->m_LstBaseInfoTr.append(QPair<QString, QString>("Vendor", ""));
+    audio->m_LstOtherInfoTr.append(QPair<QString, QString>("Driver", "snd_hda_intel"));
+
+    QXlsx::StreamWriter writer(path);
+    QXlsx::Format boldFont;
+    boldFont.setFontBold(true);
+    writer.appendRow(QStringList() << "[Sound Adapter]", boldFont);
+    audio->toXlsxString(writer, boldFont);
+    writer.skipRows();
+    writer.appendRow(QStringList() << "end");
+    EXPECT_EQ(6, writer.currentRow());
+    EXPECT_TRUE(writer.save());
+
+    // 无效的属性不导出，行号连续
+    QXlsx::Document xlsx(path);
+    EXPECT_EQ("[Sound Adapter]", xlsx.read(1, 1).toString());
+    EXPECT_TRUE(xlsx.cellAt(1, 1)->format().fontBold());
+    EXPECT_EQ("Name", xlsx.read(2, 1).toString());
+    EXPECT_EQ("  ALC897 ", xlsx.read(2, 2).toString());
+    EXPECT_FALSE(xlsx.cellAt(2, 1)->format().fontBold());
+    EXPECT_EQ(10, xlsx.cellAt(2, 1)->format().fontSize());
+    EXPECT_EQ("snd_hda_intel", xlsx.read(3, 2).toString());
+    EXPECT_TRUE(xlsx.cellAt(4, 1) == nullptr);
+    EXPECT_EQ("end", xlsx.read(5, 1).toString());
+}
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_toDocString)
+{
+    QTemporaryDir dir;
+    QString templatePath = dir.path() + "/template.docx";
+    QString path = dir.path() + "/export.docx";
+    {
+        QZipWriter zip(templatePath);
+        zip.addFile("[Content_Types].xml", QByteArray("<Types/>"));
+        zip.addFile("word/document.xml", QByteArray("<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">"
+                                                    "<w:body><w:p/><w:sectPr><w:type w:val=\"nextPage\"/></w:sectPr></w:body></w:document>"));
+        zip.close();
+    }
+    audio->m_LstBaseInfoTr.append(QPair<QString, QString>("Name", "ALC897 & <HDA>"));
+    audio->m_LstBaseInfoTr.append(QPair<QString, QString>("Vendor", ""));
+
+    Docx::StreamDocument doc(templatePath);
+    doc.addHeading("[Sound Adapter]", 2);
+    doc.beginTable(QStringList() << "Name" << "Vendor");
+    doc.addTableRow(QStringList() << "ALC897" << "Realtek" << "ignored");
+    doc.addTableRow(QStringList() << "HDMI");
+    doc.endTable();
+    audio->toDocString(doc);
+    EXPECT_TRUE(doc.save(path));
+
+    QZipReader reader(path);
+    EXPECT_EQ(QByteArray("<Types/>"), reader.fileData("[Content_Types].xml"));
+    QDomDocument dom;
+    ASSERT_TRUE(dom.setContent(reader.fileData("word/document.xml")));
+    QDomElement body = dom.documentElement().firstChildElement("w:body");
+    QDomNodeList children = body.childNodes();
+    // 模板中的段落、标题、表格、一个有效属性，最后是 sectPr
+    ASSERT_EQ(5, children.size());
+    EXPECT_EQ("2", children.at(1).toElement().elementsByTagName("w:pStyle").at(0).toElement().attribute("w:val"));
+    EXPECT_EQ("w:tbl", children.at(2).nodeName());
+    QDomNodeList rows = children.at(2).toElement().elementsByTagName("w:tr");
+    ASSERT_EQ(3, rows.size());
+    EXPECT_EQ(2, rows.at(1).toElement().elementsByTagName("w:tc").size());
+    EXPECT_EQ("Realtek", rows.at(1).toElement().elementsByTagName("w:tc").at(1).toElement().text());
+    EXPECT_EQ("Name:  ALC897 & <HDA>", children.at(3).toElement().text());
+    EXPECT_EQ("w:sectPr", children.at(4).nodeName());
+}
+
+static int s_TranslateCount = 0;
+const QString ut_deviceinfo_translateStr(DeviceBaseInfo *, const QString &inStr)
+{
+    ++s_TranslateCount;
+    return "tr_" + inStr;
+}
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_translationCache)
+{
+    Stub stub;
+    stub.set(ADDR(DeviceBaseInfo, translateStr), ut_deviceinfo_translateStr);
+
+    s_TranslateCount = 0;
+    audio->m_Name = "ALC897";
+    audio->m_Vendor = "Realtek";
+    const QList<QPair<QString, QString>> &lst = audio->getBaseTranslationAttribs();
+    ASSERT_EQ(2, lst.size());
+    EXPECT_EQ("tr_Name", lst[0].first);
+    EXPECT_EQ(2, s_TranslateCount);
+
+    // 属性没有变化时不重新翻译
+    audio->getBaseTranslationAttribs();
+    EXPECT_EQ(2, s_TranslateCount);
+
+    audio->m_Vendor = "Intel";
+    EXPECT_EQ("Intel", audio->getBaseTranslationAttribs()[1].second);
+    EXPECT_EQ(4, s_TranslateCount);
+
+    // 语言变化后重新翻译
+    DeviceBaseInfo::clearTranslationCache();
+    audio->getBaseTranslationAttribs();
+    EXPECT_EQ(6, s_TranslateCount);
+}
@@ -40,6 +40,8 @@ public:
     }
     void TearDown()
     {
+        // 用例中直接修改了设备列表，清除索引避免残留已释放的设备
+        DeviceManager::instance()->clearDeviceIndex();
     }
 };
 
@@ -318,7 +320,7 @@ TEST_F(UT_DeviceManager, UT_DeviceManager_setGpuInfoFromLshw)
 
     DeviceGpu *gpu = new DeviceGpu;
     gpu->m_HwinfoToLshw = "0000:01:00.0";
-    DeviceManager::instance()->m_ListDeviceGPU.append(gpu);
+    DeviceManager::instance()->addGpuDevice(gpu);
 
     DeviceManager::instance()->setGpuInfoFromLshw(mapinfo);
     EXPECT_STREQ("GK208B [GeForce GT 730]", gpu->m_Name.toStdString().c_str());
@@ -452,7 +454,7 @@ TEST_F(UT_DeviceManager, UT_DeviceManager_setBluetoothInfoFromLshw)
 {
     DeviceBluetooth *bth = new DeviceBluetooth;
     bth->m_HwinfoToLshw = "unique";
-    DeviceManager::instance()->m_ListDeviceBluetooth.append(bth);
+    DeviceManager::instance()->addBluetoothDevice(bth);
 
     QMap<QString, QString> mapinfo;
     mapinfo.insert("bus info", "unique");
@@ -772,7 +774,7 @@ TEST_F(UT_DeviceManager, UT_DeviceManager_inputInfo)
     EXPECT_EQ(mapinfo, map);
 }
 
-QList<QMap<QString, QString>> &ut_manager_cmd_btdevice()
+QList<QMap<QString, QString>> ut_manager_cmd_btdevice()
 {
     static QList<QMap<QString, QString>> lst;
     QMap<QString, QString> map;
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceManager.h"
+#include "DeviceCpu.h"
+#include "DeviceStorage.h"
+
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+class UT_DeviceSnapshot : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Manager = DeviceManager::instance();
+        m_Manager->clear();
+        m_Manager->releaseRetiredDevices();
+        m_Manager->m_SnapshotData.clear();
+    }
+    void TearDown()
+    {
+        m_Manager->clear();
+        m_Manager->releaseRetiredDevices();
+        m_Manager->m_SnapshotData.clear();
+    }
+    DeviceManager *m_Manager = nullptr;
+};
+
+static DeviceStorage *ut_snapshot_createStorage()
+{
+    DeviceStorage *device = new DeviceStorage;
+    device->m_Name = "Samsung SSD 970";
+    device->m_UniqueID = "/dev/nvme0n1";
+    device->m_SizeBytes = 500107862016;
+    device->m_KeyToLshw = "nvme@0:0";
+    return device;
+}
+
+TEST_F(UT_DeviceSnapshot, UT_DeviceSnapshot_roundTrip)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/device-snapshot.dat";
+
+    DeviceCpu *cpu = new DeviceCpu;
+    cpu->m_Name = "Intel(R) Core(TM) i5";
+    cpu->m_LogicalCPUNum = 8;
+    cpu->m_FrequencyIsCur = true;
+    m_Manager->addCpuDevice(cpu);
+    m_Manager->addStorageDeivce(ut_snapshot_createStorage());
+    m_Manager->setCpuNum(2);
+    EXPECT_TRUE(m_Manager->saveSnapshot(path));
+
+    m_Manager->clear();
+    m_Manager->releaseRetiredDevices();
+    EXPECT_TRUE(m_Manager->loadSnapshot(path));
+
+    ASSERT_EQ(1, m_Manager->m_ListDeviceCPU.size());
+    DeviceCpu *loadedCpu = dynamic_cast<DeviceCpu *>(m_Manager->m_ListDeviceCPU[0]);
+    ASSERT_TRUE(loadedCpu != nullptr);
+    EXPECT_EQ("Intel(R) Core(TM) i5", loadedCpu->m_Name);
+    EXPECT_EQ(8, loadedCpu->m_LogicalCPUNum);
+    EXPECT_TRUE(loadedCpu->m_FrequencyIsCur);
+    EXPECT_EQ(2, m_Manager->m_CpuNum);
+
+    ASSERT_EQ(1, m_Manager->m_ListDeviceStorage.size());
+    DeviceStorage *storage = dynamic_cast<DeviceStorage *>(m_Manager->m_ListDeviceStorage[0]);
+    ASSERT_TRUE(storage != nullptr);
+    EXPECT_EQ(500107862016ULL, storage->m_SizeBytes);
+    EXPECT_EQ(1, m_Manager->m_DeviceIndex[DT_Storage].find(DeviceIndex::IK_UniqueID, QString("/dev/nvme0n1")).size());
+}
+
+TEST_F(UT_DeviceSnapshot, UT_DeviceSnapshot_damaged)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/device-snapshot.dat";
+    EXPECT_FALSE(m_Manager->loadSnapshot(path));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("not a snapshot");
+    file.close();
+    EXPECT_FALSE(m_Manager->loadSnapshot(path));
+    EXPECT_TRUE(m_Manager->m_ListDeviceStorage.isEmpty());
+}
+
+TEST_F(UT_DeviceSnapshot, UT_DeviceSnapshot_restoreUnchanged)
+{
+    QTemporaryDir dir;
+    DeviceStorage *shown = ut_snapshot_createStorage();
+    m_Manager->addStorageDeivce(shown);
+    m_Manager->saveSnapshot(dir.path() + "/device-snapshot.dat");
+
+    // 刷新生成了属性相同的设备，继续使用界面正在显示的设备
+    m_Manager->clear();
+    m_Manager->addStorageDeivce(ut_snapshot_createStorage());
+    EXPECT_FALSE(m_Manager->restoreUnchangedDevices());
+    ASSERT_EQ(1, m_Manager->m_ListDeviceStorage.size());
+    EXPECT_EQ(shown, m_Manager->m_ListDeviceStorage[0]);
+    m_Manager->releaseRetiredDevices();
+
+    // 属性变化时使用新设备
+    m_Manager->clear();
+    DeviceStorage *changed = ut_snapshot_createStorage();
+    changed->m_SizeBytes = 1000204886016;
+    m_Manager->addStorageDeivce(changed);
+    EXPECT_TRUE(m_Manager->restoreUnchangedDevices());
+    ASSERT_EQ(1, m_Manager->m_ListDeviceStorage.size());
+    EXPECT_EQ(changed, m_Manager->m_ListDeviceStorage[0]);
+}
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DriverScanner.h"
+#include "HttpDriverInterface.h"
+#include "commonfunction.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <gtest/gtest.h>
+
+// 本地仓库接口，每个请求延迟 s_Delay 毫秒后返回
+static const int s_Delay = 200;
+static QString s_ServerUrl;
+static int s_AptCount = 0;
+// 同时在处理中的请求数及其峰值
+static int s_InFlight = 0;
+static int s_PeakInFlight = 0;
+
+class UT_StubRepoServer : public QTcpServer
+{
+public:
+    UT_StubRepoServer()
+    {
+        connect(this, &QTcpServer::newConnection, this, [ = ]() {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, socket, [ = ]() {
+                    QByteArray &buffer = m_Buffer[socket];
+                    buffer += socket->readAll();
+                    int end = buffer.indexOf("\r\n\r\n");
+                    while (end >= 0) {
+                        QByteArray request = buffer.left(end);
+                        buffer.remove(0, end + 4);
+                        QString product = QString(request).section("product=", 1).section(' ', 0, 0);
+                        s_PeakInFlight = qMax(s_PeakInFlight, ++s_InFlight);
+                        QTimer::singleShot(s_Delay, socket, [ = ]() {
+                            --s_InFlight;
+                            QByteArray body = QString("{\"msg\":\"success\",\"data\":{\"list\":[{\"packages\":\"driver-%1\",\"deb_version\":\"2.0\",\"level\":1,\"size\":2048}]}}").arg(product).toUtf8();
+                            socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: "
+                                          + QByteArray::number(body.size()) + "\r\n\r\n" + body);
+                        });
+                        end = buffer.indexOf("\r\n\r\n");
+                    }
+                });
+            }
+        });
+    }
+
+private:
+    QMap<QTcpSocket *, QByteArray> m_Buffer;
+};
+
+class UT_DriverScanner : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        s_AptCount = 0;
+        s_InFlight = 0;
+        s_PeakInFlight = 0;
+        m_Scanner = new DriverScanner;
+        for (int i = 0; i < 20; ++i) {
+            DriverInfo *info = new DriverInfo;
+            info->m_Type = DR_Network;
+            info->m_Name = QString("network %1").arg(i);
+            info->m_VendorId = "8086";
+            info->m_ModelId = QString::number(i);
+            m_ListDriverInfo.append(info);
+        }
+        m_Scanner->setDriverList(m_ListDriverInfo);
+    }
+    void TearDown()
+    {
+        qDeleteAll(m_ListDriverInfo);
+        m_ListDriverInfo.clear();
+        delete m_Scanner;
+    }
+    DriverScanner *m_Scanner = nullptr;
+    QList<DriverInfo *> m_ListDriverInfo;
+};
+
+QString ut_requestUrl(HttpDriverInterface *, DriverInfo *info)
+{
+    return s_ServerUrl + "?product=" + info->modelId();
+}
+
+QByteArray ut_aptPolicy(const QString &, const QStringList &args, const QString &, int, bool)
+{
+    ++s_AptCount;
+    QByteArray out;
+    // 偶数设备的驱动已安装旧版本
+    foreach (const QString &package, args) {
+        if (package == "policy")
+            continue;
+        bool installed = package.section('-', 1).toInt() % 2 == 0;
+        out += package.toUtf8() + ":\n";
+        out += installed ? "  Installed: 1.0\n" : "  Installed: (none)\n";
+        out += "  Candidate: 2.0\n";
+    }
+    return out;
+}
+
+TEST_F(UT_DriverScanner, UT_DriverScanner_concurrentScan)
+{
+    UT_StubRepoServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+    s_ServerUrl = QString("http://127.0.0.1:%1/driver").arg(server.serverPort());
+
+    Stub stub;
+    stub.set(ADDR(HttpDriverInterface, requestUrl), ut_requestUrl);
+    stub.set(ADDR(Common, executeClientCmd), ut_aptPolicy);
+
+    QList<ScanResult> lstResult;
+    QObject::connect(m_Scanner, &DriverScanner::scanFinished, [&](ScanResult sr) { lstResult.append(sr); });
+    m_Scanner->run();
+
+    ASSERT_EQ(1, lstResult.size());
+    EXPECT_EQ(SR_SUCESS, lstResult[0]);
+    // 请求并发发出，且不超过并发上限
+    EXPECT_GT(s_PeakInFlight, 1);
+    EXPECT_LE(s_PeakInFlight, 6);
+    EXPECT_EQ(1, s_AptCount);
+
+    EXPECT_EQ("driver-0", m_ListDriverInfo[0]->packages());
+    EXPECT_EQ("2.0", m_ListDriverInfo[0]->debVersion());
+    EXPECT_EQ(ST_CAN_UPDATE, m_ListDriverInfo[0]->status());
+    EXPECT_EQ("1.0", m_ListDriverInfo[0]->version());
+    EXPECT_EQ("driver-1", m_ListDriverInfo[1]->packages());
+    EXPECT_EQ(ST_NOT_INSTALL, m_ListDriverInfo[1]->status());
+}
+
+TEST_F(UT_DriverScanner, UT_DriverScanner_networkError)
+{
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+    s_ServerUrl = QString("http://127.0.0.1:%1/driver").arg(server.serverPort());
+    server.close();
+
+    Stub stub;
+    stub.set(ADDR(HttpDriverInterface, requestUrl), ut_requestUrl);
+    stub.set(ADDR(Common, executeClientCmd), ut_aptPolicy);
+
+    QList<ScanResult> lstResult;
+    QObject::connect(m_Scanner, &DriverScanner::scanFinished, [&](ScanResult sr) { lstResult.append(sr); });
+    m_Scanner->run();
+
+    ASSERT_EQ(1, lstResult.size());
+    EXPECT_EQ(SR_NETWORD_ERR, lstResult[0]);
+    EXPECT_EQ(0, s_AptCount);
+}
+
+TEST_F(UT_DriverScanner, UT_DriverScanner_aptPolicy)
+{
+    Stub stub;
+    stub.set(ADDR(Common, executeClientCmd), ut_aptPolicy);
+
+    QMap<QString, QString> mapPolicy = HttpDriverInterface::aptPolicy(QStringList() << "driver-2" << "driver-3" << "driver-2");
+    EXPECT_EQ(1, s_AptCount);
+    EXPECT_EQ(2, mapPolicy.size());
+
+    QString version;
+    EXPECT_TRUE(HttpDriverInterface::installedVersion(mapPolicy["driver-2"], version));
+    EXPECT_EQ("1.0", version);
+    EXPECT_FALSE(HttpDriverInterface::installedVersion(mapPolicy["driver-3"], version));
+}
@@ -14,6 +14,7 @@
 #include <QCoreApplication>
 #include <QPaintEvent>
 #include <QPainter>
+#include <QRegularExpression>
 
 #include <gtest/gtest.h>
 
@@ -185,6 +186,10 @@ TEST_F(UT_CmdTool, UT_CmdTool_loadLsblkInfo)
     stub.set(ADDR(CmdTool, getDeviceInfo), ut_getDeviceInfo_loadLsblkInfo);
     m_cmdTool->loadLsblkInfo("lsblk_d.txt");
     EXPECT_TRUE(m_cmdTool->m_cmdInfo.find("lsblk_d") != m_cmdTool->m_cmdInfo.end());
+    const QMap<QString, QString> &mapInfo = m_cmdTool->m_cmdInfo["lsblk_d"].value(0);
+    EXPECT_EQ(2, mapInfo.size());
+    EXPECT_EQ("1", mapInfo["sda"]);
+    EXPECT_FALSE(mapInfo.contains("NAME"));
 }
 
 bool ut_getDeviceInfo_LoadLssgInfo(void *obj, QString &deviceInfo, const QString &file)
@@ -539,3 +544,340 @@ TEST_F(UT_CmdTool, UT_CmdTool_getDeviceInfo)
     m_cmdTool->getDeviceInfo(deviceInfo, "dmidecode2");
     EXPECT_STREQ("Manufacturer: LENOVO\nProduct Name: 3133\nVersion: NOK\n", deviceInfo.toStdString().c_str());
 }
+
+TEST_F(UT_CmdTool, UT_CmdTool_getMapInfoFromCmd)
+{
+    QMap<QString, QString> mapInfo;
+    m_cmdTool->getMapInfoFromCmd("Vendor: Intel\n Model : i7: x \nCores: 8", mapInfo);
+    EXPECT_EQ("Intel", mapInfo["Vendor"]);
+    EXPECT_EQ("8", mapInfo["Cores"]);
+    // 分隔符出现多次的行不解析
+    EXPECT_FALSE(mapInfo.contains("Model"));
+}
+
+TEST_F(UT_CmdTool, UT_CmdTool_getMapInfoFromInput)
+{
+    QMap<QString, QString> mapInfo;
+    m_cmdTool->getMapInfoFromInput("I: Bus=0011 Vendor=0001 Product=0001 Version=ab41\n"
+                                   "N: Name=\"AT Translated Set 2 keyboard\"\n"
+                                   "S: Sysfs=/devices/platform/i8042/serio0/input/input3\n"
+                                   "B: KEY=ab=c", mapInfo, "=");
+    EXPECT_EQ("0011", mapInfo["Bus"]);
+    EXPECT_EQ("ab41", mapInfo["Version"]);
+    EXPECT_EQ("AT Translated Set 2 keyboard", mapInfo["Name"]);
+    EXPECT_EQ("/devices/platform/i8042/serio0/input/input3", mapInfo["Sysfs"]);
+    // 分隔符出现两次时后两段拼接
+    EXPECT_EQ("abc", mapInfo["KEY"]);
+}
+
+TEST_F(UT_CmdTool, UT_CmdTool_getMapInfoFromHwinfo)
+{
+    QMap<QString, QString> mapInfo;
+    m_cmdTool->getMapInfoFromHwinfo("  Hardware Class: mouse\n"
+                                    "  Model: \"Logitech Mouse\"\n"
+                                    "  Vendor: usb 0x046d \"Logitech, Inc.\"\n"
+                                    "  Device: usb 0xc077 \"M105 Optical Mouse\"\n"
+                                    "  Driver: \"usbhid\"\n"
+                                    "  Config Status: cfg=new, avail=yes, need=no, active=unknown\n"
+                                    "  Speed: unknown", mapInfo);
+    EXPECT_EQ("mouse", mapInfo["Hardware Class"]);
+    EXPECT_EQ("Logitech Mouse", mapInfo["Model"]);
+    EXPECT_EQ("0x046d", mapInfo["VID"]);
+    EXPECT_EQ("0x046dc077", mapInfo["VID_PID"]);
+    EXPECT_EQ("usbhid", mapInfo["Driver"]);
+    EXPECT_EQ("yes", mapInfo["cfg_avail"]);
+    EXPECT_FALSE(mapInfo.contains("Speed"));
+}
+
+TEST_F(UT_CmdTool, UT_CmdTool_getMapInfoFromDmidecode)
+{
+    QMap<QString, QString> mapInfo;
+    m_cmdTool->getMapInfoFromDmidecode("Handle 0x0000\n\tVendor: LENOVO\n\tCharacteristics:\n\t\tPCI is supported\n\t\tACPI is supported\n\tVersion: N1", mapInfo);
+    EXPECT_EQ("LENOVO", mapInfo["Vendor"]);
+    EXPECT_EQ("N1", mapInfo["Version"]);
+    EXPECT_EQ(" \t\tPCI is supported  /  \t\tACPI is supported  /  ", mapInfo["Characteristics"]);
+}
+
+// 逐行正则匹配和逐个属性名查找的旧解析方式，用于对比结果和耗时
+static void ut_getMapInfoFromSmartctlReference(QMap<QString, QString> &mapInfo, const QString &info, const QString &ch = QString(": "))
+{
+    static const QStringList names = {"Power_On_Hours", "Power_Cycle_Count", "Raw_Read_Error_Rate", "Spin_Up_Time", "Start_Stop_Count",
+                                      "Reallocated_Sector_Ct", "Seek_Error_Rate", "Spin_Retry_Count", "Calibration_Retry_Count",
+                                      "G-Sense_Error_Rate", "Power-Off_Retract_Count", "Load_Cycle_Count", "Temperature_Celsius",
+                                      "Reallocated_Event_Count", "Current_Pending_Sector", "Offline_Uncorrectable",
+                                      "UDMA_CRC_Error_Count", "Multi_Zone_Error_Rate"
+                                     };
+    QString indexName;
+    static const QRegularExpression reg("^[\\s\\S]*[\\d]:[\\d][\\s\\S]*$");
+    static const QRegularExpression rx("^[ ]*[0-9]+[ ]+([\\w_-]+)[ ]+0x[0-9a-fA-F-]+[ ]+[0-9]+[ ]+[0-9]+[ ]+[0-9]+[ ]+[\\w-]+[ ]+[\\w-]+[ ]+[\\w-]+[ ]+([0-9\\w\\/-]+[ ]*[0-9\\w\\/\\-\\(\\)]*)$");
+    foreach (const QString &line, info.split("\n")) {
+        int index = line.indexOf(ch);
+        if (index > 0 && !reg.match(line).hasMatch() && !line.contains("Error") && !line.contains("hh:mm:SS")) {
+            if (line.indexOf("(") < index && line.indexOf(")") > index)
+                continue;
+            if (line.indexOf("[") < index && line.indexOf("]") > index)
+                continue;
+            indexName = line.mid(0, index).trimmed().remove(" is");
+            if (mapInfo.contains(indexName))
+                mapInfo[indexName] += ", " + line.mid(index + 1).trimmed();
+            else
+                mapInfo[indexName] = line.mid(index + 1).trimmed();
+            continue;
+        }
+        if (!indexName.isEmpty() && (line.startsWith("\t\t") || line.startsWith("    ")) && !line.contains(":")) {
+            if (mapInfo.contains(indexName))
+                mapInfo[indexName] += ", " + line.trimmed();
+            else
+                mapInfo[indexName] = line.trimmed();
+            continue;
+        }
+        indexName = "";
+
+        QRegularExpressionMatch match = rx.match(line);
+        if (match.hasMatch()) {
+            mapInfo[match.captured(1)] = match.captured(2);
+            continue;
+        }
+
+        QStringList strList;
+        if (line.endsWith(")")) {
+            int leftBracket = line.indexOf("(");
+            if (leftBracket > 0) {
+                strList = line.left(leftBracket).trimmed().split(" ");
+                if (strList.size() > 2)
+                    strList.last() += line.mid(leftBracket);
+            }
+        } else {
+            strList = line.trimmed().split(" ");
+        }
+        if (strList.size() < 5)
+            continue;
+        foreach (const QString &name, names) {
+            if (line.contains(name)) {
+                mapInfo[name] = strList.last();
+                break;
+            }
+        }
+    }
+}
+
+// smartctl --all /dev/sda (机械硬盘)
+static const char *ut_smartctlAta =
+    "smartctl 7.2 2020-12-30 r5155 [x86_64-linux-5.10.0-amd64-desktop] (local build)\n"
+    "Copyright (C) 2002-20, Bruce Allen, Christian Franke, www.smartmontools.org\n"
+    "\n"
+    "=== START OF INFORMATION SECTION ===\n"
+    "Model Family:     Western Digital Blue\n"
+    "Device Model:     WDC WD10EZEX-08WN4A0\n"
+    "Serial Number:    WD-WCC6Y4XXXXXX\n"
+    "LU WWN Device Id: 5 0014ee 2b9a7e3c5\n"
+    "Firmware Version: 01.01A01\n"
+    "User Capacity:    1,000,204,886,016 bytes [1.00 TB]\n"
+    "Sector Sizes:     512 bytes logical, 4096 bytes physical\n"
+    "Rotation Rate:    7200 rpm\n"
+    "Form Factor:      3.5 inches\n"
+    "Device is:        In smartctl database [for details use: -P show]\n"
+    "ATA Version is:   ACS-3 T13/2161-D revision 3b\n"
+    "SATA Version is:  SATA 3.1, 6.0 Gb/s (current: 6.0 Gb/s)\n"
+    "Local Time is:    Fri Oct 16 10:21:33 2026 CST\n"
+    "SMART support is: Available - device has SMART capability.\n"
+    "SMART support is: Enabled\n"
+    "\n"
+    "=== START OF READ SMART DATA SECTION ===\n"
+    "SMART overall-health self-assessment test result: PASSED\n"
+    "\n"
+    "General SMART Values:\n"
+    "Offline data collection status:  (0x82)\tOffline data collection activity\n"
+    "\t\t\t\t\twas completed without error.\n"
+    "\t\t\t\t\tAuto Offline Data Collection: Enabled.\n"
+    "Self-test execution status:      (   0)\tThe previous self-test routine completed\n"
+    "\t\t\t\t\twithout error or no self-test has ever \n"
+    "\t\t\t\t\tbeen run.\n"
+    "Total time to complete Offline \n"
+    "data collection: \t\t(11280) seconds.\n"
+    "Offline data collection\n"
+    "capabilities: \t\t\t (0x7b) SMART execute Offline immediate.\n"
+    "\t\t\t\t\tAuto Offline data collection on/off support.\n"
+    "\t\t\t\t\tSuspend Offline collection upon new\n"
+    "\t\t\t\t\tcommand.\n"
+    "SMART capabilities:            (0x0003)\tSaves SMART data before entering\n"
+    "\t\t\t\t\tpower-saving mode.\n"
+    "\t\t\t\t\tSupports SMART auto save timer.\n"
+    "Error logging capability:        (0x01)\tError logging supported.\n"
+    "\t\t\t\t\tGeneral Purpose Logging supported.\n"
+    "Short self-test routine \n"
+    "recommended polling time: \t (   2) minutes.\n"
+    "Extended self-test routine\n"
+    "recommended polling time: \t ( 116) minutes.\n"
+    "Conveyance self-test routine\n"
+    "recommended polling time: \t (   5) minutes.\n"
+    "SCT capabilities: \t       (0x3035)\tSCT Status supported.\n"
+    "\t\t\t\t\tSCT Feature Control supported.\n"
+    "\t\t\t\t\tSCT Data Table supported.\n"
+    "\n"
+    "SMART Attributes Data Structure revision number: 16\n"
+    "Vendor Specific SMART Attributes with Thresholds:\n"
+    "ID# ATTRIBUTE_NAME          FLAG     VALUE WORST THRESH TYPE      UPDATED  WHEN_FAILED RAW_VALUE\n"
+    "  1 Raw_Read_Error_Rate     0x002f   200   200   051    Pre-fail  Always       -       0\n"
+    "  3 Spin_Up_Time            0x0027   172   170   021    Pre-fail  Always       -       2375\n"
+    "  4 Start_Stop_Count        0x0032   097   097   000    Old_age   Always       -       3627\n"
+    "  5 Reallocated_Sector_Ct   0x0033   200   200   140    Pre-fail  Always       -       0\n"
+    "  7 Seek_Error_Rate         0x002e   200   200   000    Old_age   Always       -       0\n"
+    "  9 Power_On_Hours          0x0032   088   088   000    Old_age   Always       -       9206\n"
+    " 10 Spin_Retry_Count        0x0032   100   100   000    Old_age   Always       -       0\n"
+    " 11 Calibration_Retry_Count 0x0032   100   100   000    Old_age   Always       -       0\n"
+    " 12 Power_Cycle_Count       0x0032   097   097   000    Old_age   Always       -       3599\n"
+    "192 Power-Off_Retract_Count 0x0032   200   200   000    Old_age   Always       -       118\n"
+    "193 Load_Cycle_Count        0x0032   198   198   000    Old_age   Always       -       7694\n"
+    "194 Temperature_Celsius     0x0022   108   095   000    Old_age   Always       -       35 (Min/Max 18/52)\n"
+    "196 Reallocated_Event_Count 0x0032   200   200   000    Old_age   Always       -       0\n"
+    "197 Current_Pending_Sector  0x0032   200   200   000    Old_age   Always       -       0\n"
+    "198 Offline_Uncorrectable   0x0030   100   253   000    Old_age   Offline      -       0\n"
+    "199 UDMA_CRC_Error_Count    0x0032   200   200   000    Old_age   Always       -       0\n"
+    "200 Multi_Zone_Error_Rate   0x0008   200   200   000    Old_age   Offline      -       0\n"
+    "240 Head_Flying_Hours       0x0000   100   253   000    Old_age   Offline      -       1234 (215 117 0)\n"
+    "\n"
+    "SMART Error Log Version: 1\n"
+    "No Errors Logged\n"
+    "\n"
+    "SMART Self-test log structure revision number 1\n"
+    "Num  Test_Description    Status                  Remaining  LifeTime(hours)  LBA_of_first_error\n"
+    "# 1  Short offline       Completed without error       00%      9180         -\n"
+    "# 2  Extended offline    Completed without error       00%      8902         -\n"
+    "\n"
+    "SMART Selective self-test log data structure revision number 1\n"
+    " SPAN  MIN_LBA  MAX_LBA  CURRENT_TEST_STATUS\n"
+    "    1        0        0  Not_testing\n"
+    "    2        0        0  Not_testing\n"
+    "Selective self-test flags (0x0):\n"
+    "  After scanning selected spans, do NOT read-scan remainder of disk.\n"
+    "If Selective self-test is pending on power-up, resume after 0 minute delay.\n"
+    "\n";
+
+// smartctl -x /dev/sdb (固态硬盘，属性表使用简写标志)
+static const char *ut_smartctlAtaBrief =
+    "=== START OF INFORMATION SECTION ===\n"
+    "Device Model:     Samsung SSD 860 EVO 500GB\n"
+    "Serial Number:    S3Z1NB0K123456A\n"
+    "Firmware Version: RVT02B6Q\n"
+    "User Capacity:    500,107,862,016 bytes [500 GB]\n"
+    "Sector Size:      512 bytes logical/physical\n"
+    "Rotation Rate:    Solid State Device\n"
+    "Form Factor:      2.5 inches\n"
+    "SATA Version is:  SATA 3.2, 6.0 Gb/s (current: 6.0 Gb/s)\n"
+    "\n"
+    "SMART Attributes Data Structure revision number: 1\n"
+    "Vendor Specific SMART Attributes with Thresholds:\n"
+    "ID# ATTRIBUTE_NAME          FLAGS    VALUE WORST THRESH FAIL RAW_VALUE\n"
+    "  5 Reallocated_Sector_Ct   PO--CK   100   100   010    -    0\n"
+    "  9 Power_On_Hours_and_Msec -O--CK   095   095   000    -    21473h+05m+12.345s\n"
+    " 12 Power_Cycle_Count       -O--CK   099   099   000    -    1206\n"
+    "177 Wear_Leveling_Count     PO--C-   099   099   000    -    12\n"
+    "190 Airflow_Temperature_Cel -O--CK   064   055   000    -    36\n"
+    "194 Temperature_Celsius     -O---K   064   055   000    -    36 (Min/Max 24/45)\n"
+    "199 UDMA_CRC_Error_Count    -OSRCK   100   100   000    -    0\n"
+    "                            ||||||_ K auto-keep\n"
+    "                            |||||__ C event count\n"
+    "\n";
+
+// smartctl --all /dev/nvme0n1
+static const char *ut_smartctlNvme =
+    "=== START OF INFORMATION SECTION ===\n"
+    "Model Number:                       Samsung SSD 970 EVO Plus 500GB\n"
+    "Serial Number:                      S4EVNX0R123456K\n"
+    "Firmware Version:                   2B2QEXM7\n"
+    "PCI Vendor/Subsystem ID:            0x144d\n"
+    "IEEE OUI Identifier:                0x002538\n"
+    "Total NVM Capacity:                 500,107,862,016 [500 GB]\n"
+    "Unallocated NVM Capacity:           0\n"
+    "Controller ID:                      4\n"
+    "NVMe Version:                       1.3\n"
+    "Number of Namespaces:               1\n"
+    "Namespace 1 Size/Capacity:          500,107,862,016 [500 GB]\n"
+    "Namespace 1 Utilization:            203,451,179,008 [203 GB]\n"
+    "Namespace 1 Formatted LBA Size:     512\n"
+    "Local Time is:                      Fri Oct 16 10:25:01 2026 CST\n"
+    "Firmware Updates (0x16):            3 Slots, no Reset required\n"
+    "Optional Admin Commands (0x0017):   Security Format Frmw_DL Self_Test\n"
+    "\n"
+    "Supported Power States\n"
+    "St Op     Max   Active     Idle   RL RT WL WT  Ent_Lat  Ex_Lat\n"
+    " 0 +     7.80W       -        -    0  0  0  0        0       0\n"
+    " 1 +     6.00W       -        -    1  1  1  1        0       0\n"
+    "\n"
+    "=== START OF SMART DATA SECTION ===\n"
+    "SMART overall-health self-assessment test result: PASSED\n"
+    "\n"
+    "SMART/Health Information (NVMe Log 0x02)\n"
+    "Critical Warning:                   0x00\n"
+    "Temperature:                        35 Celsius\n"
+    "Available Spare:                    100%\n"
+    "Available Spare Threshold:          10%\n"
+    "Percentage Used:                    1%\n"
+    "Data Units Read:                    12,345,678 [6.32 TB]\n"
+    "Data Units Written:                 23,456,789 [12.0 TB]\n"
+    "Host Read Commands:                 123,456,789\n"
+    "Host Write Commands:                234,567,890\n"
+    "Controller Busy Time:               1,234\n"
+    "Power Cycles:                       1,206\n"
+    "Power On Hours:                     5,678\n"
+    "Unsafe Shutdowns:                   76\n"
+    "Media and Data Integrity Errors:    0\n"
+    "Error Information Log Entries:      1,024\n"
+    "Warning  Comp. Temperature Time:    0\n"
+    "Critical Comp. Temperature Time:    0\n"
+    "Temperature Sensor 1:               35 Celsius\n"
+    "Temperature Sensor 2:               39 Celsius\n"
+    "\n"
+    "Error Information (NVMe Log 0x01, 16 of 64 entries)\n"
+    "No Errors Logged\n"
+    "\n";
+
+TEST_F(UT_CmdTool, UT_CmdTool_getMapInfoFromSmartctl)
+{
+    foreach (const QString &info, QStringList() << ut_smartctlAta << ut_smartctlAtaBrief << ut_smartctlNvme) {
+        QMap<QString, QString> mapInfo;
+        QMap<QString, QString> expected;
+        m_cmdTool->getMapInfoFromSmartctl(mapInfo, info);
+        ut_getMapInfoFromSmartctlReference(expected, info);
+        EXPECT_EQ(expected, mapInfo);
+    }
+
+    QMap<QString, QString> mapInfo;
+    m_cmdTool->getMapInfoFromSmartctl(mapInfo, ut_smartctlAta);
+    EXPECT_EQ("WDC WD10EZEX-08WN4A0", mapInfo["Device Model"]);
+    EXPECT_EQ("1,000,204,886,016 bytes [1.00 TB]", mapInfo["User Capacity"]);
+    EXPECT_EQ("Available - device has SMART capability., Enabled", mapInfo["SMART support"]);
+    EXPECT_EQ("9206", mapInfo["Power_On_Hours"]);
+    EXPECT_EQ("35(Min/Max 18/52)", mapInfo["Temperature_Celsius"]);
+    EXPECT_FALSE(mapInfo.contains("Head_Flying_Hours"));
+
+    mapInfo.clear();
+    m_cmdTool->getMapInfoFromSmartctl(mapInfo, ut_smartctlAtaBrief);
+    EXPECT_EQ("21473h+05m+12.345s", mapInfo["Power_On_Hours"]);
+    EXPECT_EQ("1206", mapInfo["Power_Cycle_Count"]);
+    EXPECT_FALSE(mapInfo.contains("Wear_Leveling_Count"));
+
+    mapInfo.clear();
+    m_cmdTool->getMapInfoFromSmartctl(mapInfo, ut_smartctlNvme);
+    EXPECT_EQ("Samsung SSD 970 EVO Plus 500GB", mapInfo["Model Number"]);
+    EXPECT_EQ("500,107,862,016 [500 GB]", mapInfo["Namespace 1 Size/Capacity"]);
+    EXPECT_EQ("5,678", mapInfo["Power On Hours"]);
+    EXPECT_EQ("35 Celsius", mapInfo["Temperature"]);
+}
+
+TEST_F(UT_CmdTool, UT_CmdTool_getMapInfoFromSmartctl_equivalence)
+{
+    // 多块硬盘的输出拼接在一起，与逐行正则解析的参考实现结果一致
+    QString info;
+    for (int i = 0; i < 20; ++i)
+        info += QString(ut_smartctlAta) + ut_smartctlAtaBrief + ut_smartctlNvme;
+
+    QMap<QString, QString> expected;
+    ut_getMapInfoFromSmartctlReference(expected, info);
+
+    QMap<QString, QString> mapInfo;
+    m_cmdTool->getMapInfoFromSmartctl(mapInfo, info);
+
+    EXPECT_EQ(expected, mapInfo);
+}
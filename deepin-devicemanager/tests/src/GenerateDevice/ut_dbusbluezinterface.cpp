@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DBusBluezInterface.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusVirtualObject>
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+static const QString ut_bluezService = "org.deepin.devicemanager.ut.bluez";
+static const QString ut_bluezConnection = "ut_bluez_mock";
+
+/**
+ * @brief The UT_BluezMock class
+ * 在会话总线上模拟 bluetoothd 的 ObjectManager
+ */
+class UT_BluezMock : public QDBusVirtualObject
+{
+public:
+    QString introspect(const QString &path) const override
+    {
+        Q_UNUSED(path)
+        return QString();
+    }
+
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override
+    {
+        if (message.member() != "GetManagedObjects")
+            return false;
+        connection.send(message.createReply(QVariant::fromValue(m_Objects)));
+        return true;
+    }
+
+    BluezObjectMap m_Objects;
+};
+
+class UT_DBusBluezInterface : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+static QVariantMap ut_adapterProperties()
+{
+    QVariantMap properties;
+    properties.insert("Address", "E0:D4:62:EB:4C:38");
+    properties.insert("Name", "uos-PC");
+    properties.insert("Alias", "uos-PC");
+    properties.insert("Class", 0x006c010cu);
+    properties.insert("Powered", true);
+    properties.insert("Discoverable", false);
+    properties.insert("DiscoverableTimeout", 180u);
+    properties.insert("Pairable", true);
+    properties.insert("Discovering", false);
+    properties.insert("Modalias", "usb:v1D6Bp0246d0537");
+    properties.insert("Roles", QStringList() << "central" << "peripheral");
+    properties.insert("UUIDs", QStringList() << "0000110a-0000-1000-8000-00805f9b34fb"
+                      << "00001801-0000-1000-8000-00805f9b34fb"
+                      << "0000ffff-0000-1000-8000-00805f9b34fb"
+                      << "03b80e5a-ede8-4b33-a751-6ce34ec4c700");
+    return properties;
+}
+
+static QVariantMap ut_deviceProperties(const QString &address, bool paired, bool connected)
+{
+    QVariantMap properties;
+    properties.insert("Address", address);
+    properties.insert("Paired", paired);
+    properties.insert("Connected", connected);
+    return properties;
+}
+
+static bool ut_waitFor(const std::function<bool()> &condition)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition() && timer.elapsed() < 2000)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    return condition();
+}
+
+TEST_F(UT_DBusBluezInterface, UT_DBusBluezInterface_adapterMapInfo)
+{
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("Manufacturer", "Intel Corp. (2)");
+    DBusBluezInterface::adapterMapInfo(ut_adapterProperties(), mapInfo);
+
+    // 与 getMapInfoFromBluetoothCtl 解析 bluetoothctl show 的结果一致
+    EXPECT_EQ("Intel Corp. (2)", mapInfo["Manufacturer"]);
+    EXPECT_EQ("uos-PC", mapInfo["Name"]);
+    EXPECT_EQ("0x006c010c", mapInfo["Class"]);
+    EXPECT_EQ("yes", mapInfo["Powered"]);
+    EXPECT_EQ("no", mapInfo["Discoverable"]);
+    EXPECT_EQ("0x000000b4", mapInfo["DiscoverableTimeout"]);
+    EXPECT_EQ("usb:v1D6Bp0246d0537", mapInfo["Modalias"]);
+    EXPECT_EQ("peripheral", mapInfo["Roles"]);
+    EXPECT_EQ("Audio Source:(0000110a-0000-1000-8000-00805f9b34fb)\n"
+              "Generic Attribute Profile:(00001801-0000-1000-8000-00805f9b34fb)\n"
+              "0000ffff-0000-1000-8000-00805f9b34fb:(0000ffff-0000-1000-8000-00805f9b34fb)\n"
+              "Vendor specific:(03b80e5a-ede8-4b33-a751-6ce34ec4c700)\n", mapInfo["UUID"]);
+}
+
+TEST_F(UT_DBusBluezInterface, UT_DBusBluezInterface_uuidName)
+{
+    EXPECT_EQ("Audio Sink", DBusBluezInterface::uuidName("0000110B-0000-1000-8000-00805F9B34FB"));
+    EXPECT_EQ("Volume Control", DBusBluezInterface::uuidName("00001844-0000-1000-8000-00805f9b34fb"));
+    EXPECT_EQ("0000fffe-0000-1000-8000-00805f9b34fb", DBusBluezInterface::uuidName("0000fffe-0000-1000-8000-00805f9b34fb"));
+    EXPECT_EQ("Vendor specific", DBusBluezInterface::uuidName("not-a-uuid"));
+}
+
+TEST_F(UT_DBusBluezInterface, UT_DBusBluezInterface_sessionBusMock)
+{
+    // 没有会话总线的环境下跳过
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.isConnected())
+        GTEST_SKIP() << "no session bus";
+
+    qDBusRegisterMetaType<BluezInterfaceMap>();
+    qDBusRegisterMetaType<BluezObjectMap>();
+
+    UT_BluezMock *mock = new UT_BluezMock;
+    mock->m_Objects[QDBusObjectPath("/org/bluez/hci0")]["org.bluez.Adapter1"] = ut_adapterProperties();
+    mock->m_Objects[QDBusObjectPath("/org/bluez/hci0/dev_D4_0E_35_6A_12_9F")]["org.bluez.Device1"] = ut_deviceProperties("D4:0E:35:6A:12:9F", true, true);
+    mock->m_Objects[QDBusObjectPath("/org/bluez/hci0/dev_00_11_22_33_44_55")]["org.bluez.Device1"] = ut_deviceProperties("00:11:22:33:44:55", false, false);
+
+    // 模拟服务在单独的线程和连接上处理调用，避免阻塞调用死锁
+    QThread thread;
+    mock->moveToThread(&thread);
+    thread.start();
+    QDBusConnection mockBus = QDBusConnection::connectToBus(QDBusConnection::SessionBus, ut_bluezConnection);
+    ASSERT_TRUE(mockBus.registerVirtualObject("/", mock, QDBusConnection::SubPath));
+    ASSERT_TRUE(mockBus.registerService(ut_bluezService));
+
+    {
+        DBusBluezInterface bluez(bus, ut_bluezService);
+        EXPECT_TRUE(bluez.isValid());
+
+        QMap<QString, QString> mapInfo;
+        EXPECT_TRUE(bluez.adapterInfo("e0:d4:62:eb:4c:38", mapInfo));
+        EXPECT_EQ("uos-PC", mapInfo["Alias"]);
+        EXPECT_FALSE(bluez.adapterInfo("00:00:00:00:00:00", mapInfo));
+
+        EXPECT_TRUE(bluez.isPaired("D4:0E:35:6A:12:9F"));
+        EXPECT_TRUE(bluez.isConnected("D4:0E:35:6A:12:9F"));
+        EXPECT_FALSE(bluez.isPaired("00:11:22:33:44:55"));
+        EXPECT_FALSE(bluez.isPaired("66:77:88:99:AA:BB"));
+
+        // 新配对的设备
+        BluezInterfaceMap interfaces;
+        interfaces["org.bluez.Device1"] = ut_deviceProperties("66:77:88:99:AA:BB", true, false);
+        QDBusMessage added = QDBusMessage::createSignal("/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded");
+        added << QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0/dev_66_77_88_99_AA_BB")) << QVariant::fromValue(interfaces);
+        mockBus.send(added);
+        EXPECT_TRUE(ut_waitFor([&bluez]() { return bluez.isPaired("66:77:88:99:AA:BB"); }));
+
+        // 设备断开连接
+        QVariantMap changed;
+        changed.insert("Connected", false);
+        QDBusMessage properties = QDBusMessage::createSignal("/org/bluez/hci0/dev_D4_0E_35_6A_12_9F", "org.freedesktop.DBus.Properties", "PropertiesChanged");
+        properties << QString("org.bluez.Device1") << changed << QStringList();
+        mockBus.send(properties);
+        EXPECT_TRUE(ut_waitFor([&bluez]() { return !bluez.isConnected("D4:0E:35:6A:12:9F"); }));
+        EXPECT_TRUE(bluez.isPaired("D4:0E:35:6A:12:9F"));
+
+        // 设备被删除
+        QDBusMessage removed = QDBusMessage::createSignal("/", "org.freedesktop.DBus.ObjectManager", "InterfacesRemoved");
+        removed << QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0/dev_66_77_88_99_AA_BB")) << QStringList("org.bluez.Device1");
+        mockBus.send(removed);
+        EXPECT_TRUE(ut_waitFor([&bluez]() { return !bluez.isPaired("66:77:88:99:AA:BB"); }));
+    }
+
+    mockBus.unregisterService(ut_bluezService);
+    mockBus.unregisterObject("/", QDBusConnection::UnregisterTree);
+    QDBusConnection::disconnectFromBus(ut_bluezConnection);
+    thread.quit();
+    thread.wait();
+    delete mock;
+}
+
+TEST_F(UT_DBusBluezInterface, UT_DBusBluezInterface_noService)
+{
+    // 没有会话总线的环境下跳过
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.isConnected())
+        GTEST_SKIP() << "no session bus";
+
+    // bluetoothd 不可用时调用者回退到命令行工具
+    DBusBluezInterface bluez(bus, "org.deepin.devicemanager.ut.nobluez");
+    EXPECT_FALSE(bluez.isValid());
+    QMap<QString, QString> mapInfo;
+    EXPECT_FALSE(bluez.adapterInfo("E0:D4:62:EB:4C:38", mapInfo));
+    EXPECT_FALSE(bluez.isConnected("D4:0E:35:6A:12:9F"));
+}
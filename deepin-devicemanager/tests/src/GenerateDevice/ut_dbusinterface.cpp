@@ -56,3 +56,24 @@ TEST_F(UT_DBusInterface, UT_DBusInterface_getInfo_002)
     DBusInterface::getInstance()->getInfo("lshw", info);
     // EXPECT_FALSE(DBusInterface::getInstance()->getInfo("lshw",info));
 }
+
+TEST_F(UT_DBusInterface, UT_DBusInterface_takeInfo)
+{
+    QString info;
+    DBusInterface::getInstance()->m_Infos.insert("lshw", "lshw info");
+    EXPECT_TRUE(DBusInterface::getInstance()->takeInfo("lshw", info));
+    EXPECT_EQ("lshw info", info);
+    // 每个关键字只能取一次
+    EXPECT_FALSE(DBusInterface::getInstance()->takeInfo("lshw", info));
+}
+
+TEST_F(UT_DBusInterface, UT_DBusInterface_getInfos_dropStale)
+{
+    QString info;
+    Stub stub;
+    stub.set(ADDR(QDBusReply<QVariantMap>, isValid), ut_replay_002);
+    DBusInterface::getInstance()->m_Infos.insert("lshw", "stale info");
+    DBusInterface::getInstance()->getInfos(QStringList() << "lshw");
+    // 无论调用成功与否，上一次的信息都不能再被读取
+    EXPECT_FALSE(DBusInterface::getInstance()->takeInfo("lshw", info));
+}
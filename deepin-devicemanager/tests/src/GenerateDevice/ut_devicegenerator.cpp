@@ -62,7 +62,7 @@ public:
 };
 
 //virtual void generatorComputerDevice();
-const QList<QMap<QString, QString> > &ut_DeviceGenerator_cmdInfo()
+QList<QMap<QString, QString> > ut_DeviceGenerator_cmdInfo()
 {
     return lstMap;
 }
@@ -128,7 +128,7 @@ TEST_F(UT_DeviceGenerator, UT_DeviceGenerator_generatorMonitorDevice)
     EXPECT_TRUE(DeviceManager::instance()->m_ListDeviceMonitor.size());
 }
 
-const QList<QMap<QString, QString> > &ut_DeviceGenerator_cmdInfo_hwinfonetwork(void *obj, const QString &key)
+QList<QMap<QString, QString> > ut_DeviceGenerator_cmdInfo_hwinfonetwork(void *obj, const QString &key)
 {
     if ("hwinfo_network" == key) {
         QMap<QString, QString> mapInfo;
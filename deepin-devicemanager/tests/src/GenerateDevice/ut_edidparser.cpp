@@ -85,18 +85,61 @@ TEST_F(UT_EDIDParser,UT_EDIDParser_height){
     EXPECT_EQ(29,m_EDIDParser->height());
 }
 
-//QString binToDec(QString strBin);
-TEST_F(UT_EDIDParser,UT_EDIDParser_binToDec){
-    EXPECT_STREQ("15",m_EDIDParser->binToDec("00001111").toStdString().c_str());
+//const QString &model()const;
+TEST_F(UT_EDIDParser,UT_EDIDParser_model){
+    QString errorMsg;
+    m_EDIDParser->setEdid(edid,errorMsg);
+    EXPECT_STREQ("3840",m_EDIDParser->model().toStdString().c_str());
 }
 
-//QString decTobin(QString strDec);
-TEST_F(UT_EDIDParser,UT_EDIDParser_decTobin){
-    EXPECT_STREQ("1111",m_EDIDParser->decTobin("15").toStdString().c_str());
+//const QString &monitorName() const;
+TEST_F(UT_EDIDParser,UT_EDIDParser_monitorName){
+    QString errorMsg;
+    m_EDIDParser->setEdid(edid,errorMsg);
+    EXPECT_STREQ("VA2430-FHD",m_EDIDParser->monitorName().toStdString().c_str());
 }
 
-//QString decToHex(QString strDec);
-TEST_F(UT_EDIDParser,UT_EDIDParser_decToHex){
-    EXPECT_STREQ("0000000f",m_EDIDParser->decToHex("15").toStdString().c_str());
+// 基础块1个DTD，CEA扩展块5个DTD
+TEST_F(UT_EDIDParser,UT_EDIDParser_parseDTDs){
+    QString errorMsg;
+    m_EDIDParser->setEdid(edid,errorMsg);
+    ASSERT_EQ(6,m_EDIDParser->m_DTDSizeInfoList.size());
+    EXPECT_TRUE(m_EDIDParser->m_DTDSizeInfoList.first().isBaseBlock);
+    EXPECT_FALSE(m_EDIDParser->m_DTDSizeInfoList.last().isBaseBlock);
+    EXPECT_EQ(527,m_EDIDParser->m_DTDSizeInfoList.last().width);
+    EXPECT_EQ(296,m_EDIDParser->m_DTDSizeInfoList.last().height);
+}
+
+// 大端模式下每两个字节顺序相反
+TEST_F(UT_EDIDParser,UT_EDIDParser_bigEndian){
+    QString bigEndianEdid;
+    foreach (const QString &line, edid.split("\n")) {
+        QString swapped;
+        for (int i = 0; i + 3 < line.size(); i += 4)
+            swapped += line.mid(i + 2, 2) + line.mid(i, 2);
+        bigEndianEdid += swapped + "\n";
+    }
+
+    QString errorMsg;
+    EXPECT_FALSE(m_EDIDParser->setEdid(bigEndianEdid,errorMsg));
+    ASSERT_TRUE(m_EDIDParser->setEdid(bigEndianEdid,errorMsg,"\n",false));
+    EXPECT_STREQ("VSC",m_EDIDParser->vendor().toStdString().c_str());
+    EXPECT_STREQ("2020-03",m_EDIDParser->releaseDate().toStdString().c_str());
+    EXPECT_STREQ("4038",m_EDIDParser->model().toStdString().c_str());
+    EXPECT_STREQ("VA2430-FHD",m_EDIDParser->monitorName().toStdString().c_str());
+    EXPECT_EQ(6,m_EDIDParser->m_DTDSizeInfoList.size());
 }
 
+// 文本形式的edid不足128字节时仍按宽松方式解析，二进制数据则需要完整的基础块
+TEST_F(UT_EDIDParser,UT_EDIDParser_truncatedEdid){
+    QString truncatedEdid = edid.section("\n", 0, 3);
+    QString errorMsg;
+    ASSERT_TRUE(m_EDIDParser->setEdid(truncatedEdid,errorMsg));
+    EXPECT_STREQ("VSC",m_EDIDParser->vendor().toStdString().c_str());
+    EXPECT_STREQ("2020-03",m_EDIDParser->releaseDate().toStdString().c_str());
+    EXPECT_STREQ("Unknown Monitor",m_EDIDParser->monitorName().toStdString().c_str());
+
+    QByteArray rawEdid = QByteArray::fromHex(truncatedEdid.remove("\n").toLatin1());
+    EXPECT_EQ(64,rawEdid.size());
+    EXPECT_FALSE(m_EDIDParser->setRawEdid(rawEdid,errorMsg));
+}
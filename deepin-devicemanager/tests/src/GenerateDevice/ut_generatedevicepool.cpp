@@ -54,5 +54,36 @@ TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_initType){
 
 TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_generateDevice){
     m_generateDevicePool->generateDevice();
-    EXPECT_EQ(m_generateDevicePool->m_FinishedGenerator,0);
+    EXPECT_EQ(m_generateDevicePool->m_FinishedGenerator + m_generateDevicePool->m_PendingTypes.size(),
+              m_generateDevicePool->m_TypeList.size());
+}
+
+TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_waitForGenerators){
+    m_generateDevicePool->m_FinishedGenerator = 0;
+    m_generateDevicePool->m_PendingTypes = m_generateDevicePool->m_TypeList;
+    EXPECT_FALSE(m_generateDevicePool->waitForGenerators(10));
+
+    foreach (DeviceType type, m_generateDevicePool->m_TypeList)
+        m_generateDevicePool->slotFinished(type, QStringList());
+    EXPECT_TRUE(m_generateDevicePool->waitForGenerators(10));
+    EXPECT_TRUE(m_generateDevicePool->m_PendingTypes.isEmpty());
+}
+
+TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_cmdReady){
+    m_generateDevicePool->beginGenerate();
+    m_generateDevicePool->cmdReady("printer");
+    EXPECT_TRUE(m_generateDevicePool->m_StartedTypes.isEmpty());
+
+    m_generateDevicePool->cmdReady("dmidecode1");
+    EXPECT_EQ(1, m_generateDevicePool->m_StartedTypes.size());
+    EXPECT_TRUE(m_generateDevicePool->m_StartedTypes.contains(DT_Print));
+    m_generateDevicePool->waitForDone(-1);
+}
+
+TEST_F(UT_GenerateDevicePool,UT_GenerateDevicePool_cancel){
+    m_generateDevicePool->beginGenerate();
+    m_generateDevicePool->cancel();
+    m_generateDevicePool->cmdReady("dmidecode1");
+    EXPECT_TRUE(m_generateDevicePool->m_StartedTypes.isEmpty());
+    EXPECT_FALSE(m_generateDevicePool->waitForGenerators(10));
 }
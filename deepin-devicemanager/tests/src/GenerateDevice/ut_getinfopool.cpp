@@ -75,3 +75,16 @@ TEST_F(UT_GetInfoPool, UT_GetInfoPool_setFramework)
     EXPECT_STREQ("x86", m_readFilePool->m_Arch.toStdString().c_str());
 }
 
+
+TEST_F(UT_GetInfoPool, UT_GetInfoPool_finishedCmd)
+{
+    QMap<QString, QList<QMap<QString, QString> > > cmdInfo;
+    m_readFilePool->finishedCmd("lshw", "", cmdInfo);
+    m_readFilePool->finishedCmd("lshw", "", cmdInfo);
+    EXPECT_EQ(1, m_readFilePool->m_FinishedKeys.size());
+
+    m_readFilePool->cancel();
+    EXPECT_TRUE(m_readFilePool->isCanceled());
+    m_readFilePool->finishedCmd("lscpu", "", cmdInfo);
+    EXPECT_FALSE(m_readFilePool->m_FinishedKeys.contains("lscpu"));
+}
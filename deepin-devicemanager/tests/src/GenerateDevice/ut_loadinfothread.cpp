@@ -7,6 +7,7 @@
 #include "LoadInfoThread.h"
 #include "ThreadExecXrandr.h"
 #include "GenerateDevicePool.h"
+#include "DeviceManager.h"
 #include "ut_Head.h"
 #include "stub.h"
 
@@ -44,6 +45,54 @@ public:
     ThreadExecXrandr *m_threadExecXrandr;
 };
 
+static int s_RetryGetInfoCount = 0;
+
+void ut_loadinfo_getInfo()
+{
+    ++s_RetryGetInfoCount;
+}
+
+void ut_loadinfo_cmdReady()
+{
+    return;
+}
+
+TEST_F(UT_LoadInfoThread, UT_LoadInfoThread_retryAfterInterval)
+{
+    Stub stub;
+    stub.set(ADDR(GetInfoPool, getInfo), ut_loadinfo_getInfo);
+    DeviceManager::instance()->m_cmdInfo.remove("dmidecode4");
+
+    // dmidecode4为空时不立即重新获取
+    s_RetryGetInfoCount = 0;
+    m_loadInfoThread->slotFinishedCmd("dmidecode4");
+    EXPECT_EQ(1, m_loadInfoThread->m_RetryNum.load());
+    EXPECT_EQ(0, s_RetryGetInfoCount);
+
+    // 等待结束后重新获取
+    m_loadInfoThread->retryCmd("dmidecode4");
+    EXPECT_EQ(1, s_RetryGetInfoCount);
+
+    // 取消后不再重新获取
+    m_loadInfoThread->m_Canceled = true;
+    m_loadInfoThread->retryCmd("dmidecode4");
+    EXPECT_EQ(1, s_RetryGetInfoCount);
+}
+
+TEST_F(UT_LoadInfoThread, UT_LoadInfoThread_retryLimit)
+{
+    Stub stub;
+    stub.set(ADDR(GetInfoPool, getInfo), ut_loadinfo_getInfo);
+    stub.set(ADDR(GenerateDevicePool, cmdReady), ut_loadinfo_cmdReady);
+    DeviceManager::instance()->m_cmdInfo.remove("dmidecode4");
+
+    // 达到重试上限后不再等待，通知run继续生成设备
+    for (int i = 0; i < 4; ++i)
+        m_loadInfoThread->slotFinishedCmd("dmidecode4");
+    EXPECT_EQ(3, m_loadInfoThread->m_RetryNum.load());
+    EXPECT_EQ(1, m_loadInfoThread->m_RetryFinished.available());
+}
+
 //TEST_F(UT_LoadInfoThread,UT_LoadInfoThread_start){
 //    m_loadInfoThread->run();
 //    EXPECT_FALSE(m_loadInfoThread->m_Running);
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "InputDeviceParser.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <gtest/gtest.h>
+
+class UT_InputDeviceParser : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+static const QByteArray ut_inputDevices =
+    "I: Bus=0019 Vendor=0000 Product=0003 Version=0000\n"
+    "N: Name=\"Sleep Button\"\n"
+    "P: Phys=PNP0C0E/button/input0\n"
+    "S: Sysfs=/devices/LNXSYSTM:00/LNXSYBUS:00/PNP0C0E:00/input/input0\n"
+    "U: Uniq=\n"
+    "H: Handlers=kbd event0 \n"
+    "B: PROP=0\n"
+    "B: EV=3\n"
+    "B: KEY=4000 0 0\n"
+    "\n"
+    "I: Bus=0011 Vendor=0001 Product=0001 Version=ab41\n"
+    "N: Name=\"AT Translated Set 2 keyboard\"\n"
+    "P: Phys=isa0060/serio0/input0\n"
+    "S: Sysfs=/devices/platform/i8042/serio0/input/input3\n"
+    "U: Uniq=\n"
+    "H: Handlers=sysrq kbd leds event3 \n"
+    "B: PROP=0\n"
+    "B: EV=120013\n"
+    "\n"
+    "I: Bus=0018 Vendor=06cb Product=cd8b Version=0100\n"
+    "N: Name=\"SYNA3602:00 06CB:CD8B Touchpad\"\n"
+    "P: Phys=i2c-SYNA3602:00\n"
+    "S: Sysfs=/devices/pci0000:00/0000:00:15.1/i2c_designware.1/i2c-2/i2c-SYNA3602:00/0018:06CB:CD8B.0002/input/input12\n"
+    "U: Uniq=\n"
+    "H: Handlers=mouse1 event12 \n"
+    "B: EV=1b\n"
+    "\n"
+    "I: Bus=0005 Vendor=046d Product=b023 Version=0003\n"
+    "N: Name=\"MX Master 3\"\n"
+    "P: Phys=a4:c3:f0:85:ac:2d\n"
+    "S: Sysfs=/devices/virtual/misc/uhid/0005:046D:B023.0004/input/input20\n"
+    "U: Uniq=D4:0E:35:6A:12:9F\n"
+    "H: Handlers=mouse2 event20 \n"
+    "B: EV=17\n";
+
+TEST_F(UT_InputDeviceParser, UT_InputDeviceParser_parse)
+{
+    QList<InputDeviceRecord> records = InputDeviceParser::parse(ut_inputDevices);
+    ASSERT_EQ(4, records.size());
+
+    EXPECT_EQ("Sleep Button", records[0].name);
+    EXPECT_EQ(0x19, records[0].bus);
+    EXPECT_EQ("0019", records[0].busId());
+    EXPECT_EQ(QStringList() << "kbd" << "event0", records[0].handlers);
+    EXPECT_EQ(0x3u, records[0].evBits);
+
+    EXPECT_EQ(0x11, records[1].bus);
+    EXPECT_EQ(0x1, records[1].vendor);
+    EXPECT_EQ(0x1, records[1].product);
+    EXPECT_EQ(0xab41, records[1].version);
+    EXPECT_EQ("isa0060/serio0/input0", records[1].phys);
+    EXPECT_EQ("event3", records[1].eventHandler());
+    EXPECT_EQ(0x120013u, records[1].evBits);
+    EXPECT_TRUE(records[1].uniq.isEmpty());
+
+    EXPECT_EQ(0x06cb, records[2].vendor);
+    EXPECT_EQ(0xcd8b, records[2].product);
+
+    EXPECT_EQ("0005", records[3].busId());
+    EXPECT_EQ("D4:0E:35:6A:12:9F", records[3].uniq);
+}
+
+TEST_F(UT_InputDeviceParser, UT_InputDeviceParser_parse_empty)
+{
+    EXPECT_TRUE(InputDeviceParser::parse(QByteArray()).isEmpty());
+    EXPECT_TRUE(InputDeviceParser::parse("\n\n").isEmpty());
+    // 没有结尾换行的最后一个设备也要保留
+    EXPECT_EQ(1, InputDeviceParser::parse("N: Name=\"a\"").size());
+}
+
+TEST_F(UT_InputDeviceParser, UT_InputDeviceParser_findByEvent)
+{
+    QList<InputDeviceRecord> records = InputDeviceParser::parse(ut_inputDevices);
+    InputDeviceRecord record;
+    EXPECT_TRUE(InputDeviceParser::findByEvent(records, "event12", record));
+    EXPECT_EQ("SYNA3602:00 06CB:CD8B Touchpad", record.name);
+    EXPECT_FALSE(InputDeviceParser::findByEvent(records, "event1", record));
+}
+
+TEST_F(UT_InputDeviceParser, UT_InputDeviceParser_ps2SysPath)
+{
+    // 与原来 "S: Sysfs=(.*)/input[0-9]{1,2}" 的匹配结果一致
+    EXPECT_EQ("/devices/platform/i8042/serio0/input", InputDeviceParser::ps2SysPath("/devices/platform/i8042/serio0/input/input3"));
+    EXPECT_EQ("/devices/pci0000:00/0000:00:15.1/i2c_designware.1/i2c-2/i2c-SYNA3602:00/0018:06CB:CD8B.0002",
+              InputDeviceParser::ps2SysPath("/devices/pci0000:00/0000:00:15.1/i2c_designware.1/i2c-2/i2c-SYNA3602:00/0018:06CB:CD8B.0002/input/input12"));
+    EXPECT_TRUE(InputDeviceParser::ps2SysPath("/devices/virtual").isEmpty());
+}
@@ -10,6 +10,8 @@
 #include "DeviceWidget.h"
 #include "PageListView.h"
 #include "DeviceListView.h"
+#include "DeviceManager.h"
+#include "CmdTool.h"
 #include "ut_Head.h"
 #include "stub.h"
 
@@ -30,12 +32,19 @@ void ut_refreshDataBase()
     return;
 }
 
+bool ut_snapshot()
+{
+    return false;
+}
+
 class MainWindow_UT : public UT_HEAD
 {
 public:
     void SetUp()
     {
         stub.set(ADDR(MainWindow, refreshDataBase), ut_refreshDataBase);
+        stub.set(ADDR(DeviceManager, loadSnapshot), ut_snapshot);
+        stub.set(ADDR(DeviceManager, saveSnapshot), ut_snapshot);
         m_mainWindow = new MainWindow;
     }
     void TearDown()
@@ -68,6 +77,26 @@ TEST_F(MainWindow_UT, MainWindow_UT_exportTo)
     m_mainWindow->slotExportInfo();
 }
 
+static int s_SaveDialogCount = 0;
+
+QString UT_countGetSaveFileName()
+{
+    ++s_SaveDialogCount;
+    return "1.txt";
+}
+
+TEST_F(MainWindow_UT, MainWindow_UT_exportWhileLoading)
+{
+    stub.set(ADDR(QFileDialog, getSaveFileName), UT_countGetSaveFileName);
+
+    // 后台加载时设备列表正在重建，不能导出
+    s_SaveDialogCount = 0;
+    DeviceManager::instance()->setLoading(true);
+    EXPECT_FALSE(m_mainWindow->exportTo());
+    EXPECT_EQ(0, s_SaveDialogCount);
+    DeviceManager::instance()->setLoading(false);
+}
+
 TEST_F(MainWindow_UT, MainWindow_UT_addJsonArrayItem)
 {
     QJsonArray array;
@@ -100,6 +129,33 @@ TEST_F(MainWindow_UT, MainWindow_UT_slotListItemClicked)
     m_mainWindow->slotChangeUI();
 }
 
+static int s_CorrectPowerCount = 0;
+void ut_correctPowerInfo()
+{
+    ++s_CorrectPowerCount;
+}
+
+QMap<QString, QMap<QString, QString>> ut_getCurPowerInfo()
+{
+    return QMap<QString, QMap<QString, QString>>();
+}
+
+TEST_F(MainWindow_UT, MainWindow_UT_slotListItemClicked_refreshing)
+{
+    stub.set(ADDR(DeviceManager, correctPowerInfo), ut_correctPowerInfo);
+    stub.set(ADDR(CmdTool, getCurPowerInfo), ut_getCurPowerInfo);
+    s_CorrectPowerCount = 0;
+
+    // 刷新时不修正设备信息，避免和生成设备的线程竞争
+    m_mainWindow->m_refreshing = true;
+    m_mainWindow->slotListItemClicked(QObject::tr("Battery"));
+    EXPECT_EQ(0, s_CorrectPowerCount);
+
+    m_mainWindow->m_refreshing = false;
+    m_mainWindow->slotListItemClicked(QObject::tr("Battery"));
+    EXPECT_EQ(1, s_CorrectPowerCount);
+}
+
 TEST_F(MainWindow_UT, MainWindow_UT_keyPressEvent)
 {
     QKeyEvent keyPressEvent(QEvent::KeyPress, Qt::Key_Space, Qt::NoModifier);
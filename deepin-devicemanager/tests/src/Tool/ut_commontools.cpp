@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "commontools.h"
+#include "DeviceManager.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QProcess>
+
+#include <gtest/gtest.h>
+
+class UT_CommonTools : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        DeviceManager::instance()->clear();
+    }
+    void TearDown()
+    {
+        DeviceManager::instance()->clear();
+        DeviceManager::instance()->releaseRetiredDevices();
+    }
+};
+
+static QByteArray ut_commontools_edid()
+{
+    return QByteArray::fromHex("00ffffffffffff005a63384001010101"
+                               "0d1e010380351d782ece65a657519f27"
+                               "0f5054bfef80b300a940a9c095009040"
+                               "8180814081c0023a801871382d40582c"
+                               "45000f282100001e000000ff00565351"
+                               "3230313332313330320a000000fd0032"
+                               "4b185311000a202020202020000000fc"
+                               "005641323433302d4648440a20200141");
+}
+
+static int s_ProcessStartCount = 0;
+void ut_commontools_processStart()
+{
+    ++s_ProcessStartCount;
+}
+
+TEST_F(UT_CommonTools, UT_CommonTools_readEdid)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/edid";
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(ut_commontools_edid());
+    file.close();
+
+    EXPECT_EQ(ut_commontools_edid(), CommonTools::readEdid(path));
+
+    // 更换显示器后读取到新的数据
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(ut_commontools_edid().left(64));
+    file.close();
+    EXPECT_EQ(64, CommonTools::readEdid(path).size());
+
+    file.remove();
+    EXPECT_TRUE(CommonTools::readEdid(path).isEmpty());
+}
+
+TEST_F(UT_CommonTools, UT_CommonTools_parseEDID)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/edid";
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(ut_commontools_edid());
+    file.close();
+
+    Stub stub;
+    s_ProcessStartCount = 0;
+    stub.set((void (QProcess::*)(const QString &, const QStringList &, QIODevice::OpenMode))ADDR(QProcess, start), ut_commontools_processStart);
+
+    CommonTools::parseEDID(QStringList() << path, "HDMI-A-1", false);
+    CommonTools::parseEDID(QStringList() << path, "HDMI-A-1", true);
+    EXPECT_EQ(0, s_ProcessStartCount);
+    EXPECT_EQ(2, DeviceManager::instance()->m_ListDeviceMonitor.size());
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "HwIdResolver.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+class UT_HwIdResolver : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        QFile file(m_Dir.path() + "/usb.ids");
+        file.open(QIODevice::WriteOnly);
+        file.write("# usb.ids\n"
+                   "#\n"
+                   "046d  Logitech, Inc.\n"
+                   "\tc077  Mouse\n"
+                   "\tc52b  Unifying Receiver\n"
+                   "\t\t00  interface\n"
+                   "8087  Intel Corp.\n"
+                   "\t0a2b  Bluetooth wireless interface\n"
+                   "\n"
+                   "C 00  (Defined at Interface level)\n"
+                   "\t01  Audio\n");
+        file.close();
+        HwIdResolver::instance().setDatabasePaths(HwIdResolver::IT_Usb, QStringList() << m_Dir.path() + "/not_exist.ids" << file.fileName());
+    }
+    void TearDown()
+    {
+        HwIdResolver::instance().setDatabasePaths(HwIdResolver::IT_Usb, QStringList() << "/usr/share/hwdata/usb.ids" << "/usr/share/misc/usb.ids" << "/var/lib/usbutils/usb.ids");
+        HwIdResolver::instance().setUsbSysfsPath("/sys/bus/usb/devices");
+    }
+    QTemporaryDir m_Dir;
+};
+
+static void ut_hwidresolver_writeDevice(const QString &dir, const QString &vid, const QString &pid)
+{
+    QDir().mkpath(dir);
+    QFile vendor(dir + "/idVendor");
+    vendor.open(QIODevice::WriteOnly);
+    vendor.write(vid.toUtf8() + "\n");
+    QFile product(dir + "/idProduct");
+    product.open(QIODevice::WriteOnly);
+    product.write(pid.toUtf8() + "\n");
+}
+
+TEST_F(UT_HwIdResolver, UT_HwIdResolver_names)
+{
+    HwIdResolver &resolver = HwIdResolver::instance();
+    EXPECT_EQ("Logitech, Inc.", resolver.vendorName(HwIdResolver::IT_Usb, "046d"));
+    EXPECT_EQ("Intel Corp.", resolver.vendorName(HwIdResolver::IT_Usb, "0x8087"));
+    EXPECT_EQ("Unifying Receiver", resolver.productName(HwIdResolver::IT_Usb, "046D", "C52B"));
+    EXPECT_EQ("Bluetooth wireless interface", resolver.productName(HwIdResolver::IT_Usb, "8087", "0a2b"));
+    EXPECT_TRUE(resolver.productName(HwIdResolver::IT_Usb, "046d", "0a2b").isEmpty());
+    EXPECT_TRUE(resolver.vendorName(HwIdResolver::IT_Usb, "1234").isEmpty());
+    EXPECT_TRUE(resolver.vendorName(HwIdResolver::IT_Usb, "xyz").isEmpty());
+}
+
+TEST_F(UT_HwIdResolver, UT_HwIdResolver_usbDeviceExists)
+{
+    ut_hwidresolver_writeDevice(m_Dir.path() + "/usb/1-1", "046d", "c52b");
+    ut_hwidresolver_writeDevice(m_Dir.path() + "/usb/1-2", "8087", "0a2b");
+    HwIdResolver::instance().setUsbSysfsPath(m_Dir.path() + "/usb");
+
+    EXPECT_TRUE(HwIdResolver::instance().usbDeviceExists("046d", "c52b"));
+    EXPECT_TRUE(HwIdResolver::instance().usbDeviceExists("0x8087", "0x0A2B"));
+    EXPECT_FALSE(HwIdResolver::instance().usbDeviceExists("046d", "c077"));
+}
@@ -118,3 +118,18 @@ TEST_F(UT_RichTextDelegate, UT_RichTextDelegate_RichTextDelegate_getDocFromLst)
                                 << "first");
     EXPECT_FALSE(doc.isNull());
 }
+
+TEST_F(UT_RichTextDelegate, UT_RichTextDelegate_RichTextDelegate_textLayout)
+{
+    QTextDocument *doc = m_rtDelegate->textLayout("first", 120);
+    EXPECT_EQ(doc, m_rtDelegate->textLayout("first", 120));
+    EXPECT_EQ(120, doc->textWidth());
+
+    // 宽度变化时复用同一个文档重新排版
+    EXPECT_EQ(doc, m_rtDelegate->textLayout("first", 200));
+    EXPECT_EQ(200, doc->textWidth());
+
+    QTextDocument *multi = m_rtDelegate->textLayout("first:second\nthird:fourth", 200);
+    EXPECT_NE(doc, multi);
+    EXPECT_TRUE(multi->toPlainText().contains("fourth"));
+}
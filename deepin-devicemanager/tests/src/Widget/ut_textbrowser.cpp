@@ -6,6 +6,7 @@
 #include "TextBrowser.h"
 #include "DeviceInfo.h"
 #include "DeviceInput.h"
+#include "DeviceManager.h"
 #include "stub.h"
 #include "ut_Head.h"
 
@@ -160,4 +161,11 @@ TEST_F(UT_TextBrowser, UT_TextBrowser_slotShowMenu)
 
     tBrowser->slotShowMenu(QPoint(0, 0));
     EXPECT_EQ(tBrowser->mp_Menu->actions().size(), 3);
+    EXPECT_TRUE(tBrowser->mp_Export->isEnabled());
+
+    DeviceManager::instance()->setLoading(true);
+    tBrowser->slotShowMenu(QPoint(0, 0));
+    EXPECT_FALSE(tBrowser->mp_Export->isEnabled());
+    EXPECT_FALSE(tBrowser->mp_Refresh->isEnabled());
+    DeviceManager::instance()->setLoading(false);
 }